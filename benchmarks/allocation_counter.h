@@ -0,0 +1,26 @@
+#ifndef BENCH_ALLOCATION_COUNTER_H
+#define BENCH_ALLOCATION_COUNTER_H
+
+#include <cstdint>
+
+namespace bench {
+
+    // Calls to, and bytes requested from, global operator new so far. Linking
+    // allocation_counter.cpp into a benchmark replaces operator new/delete
+    // with counting versions; compare two readings around the measured code
+    struct AllocationCount {
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+    };
+
+    AllocationCount allocation_count();
+
+    // Allocations since an earlier reading
+    inline AllocationCount allocations_since(const AllocationCount& start) {
+        AllocationCount now = allocation_count();
+        return {now.allocations - start.allocations, now.bytes - start.bytes};
+    }
+
+} // namespace bench
+
+#endif // BENCH_ALLOCATION_COUNTER_H
@@ -0,0 +1,116 @@
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+#include "chart_decoder.h"
+#include "json_parser.h"
+#include "allocation_counter.h"
+
+// Decodes synthetic /v8/finance/chart payloads into a PriceHistory two ways:
+// building the nlohmann DOM and copying the columns out (what callers of
+// Ticker::history had to do), and the streaming ChartDecoder.
+//
+// Usage: bench_chart_decoder [iterations]
+
+namespace {
+
+    std::string make_chart(size_t bars, int64_t step) {
+        std::string timestamps, open, high, low, close, adjclose, volume;
+        int64_t ts = 1262615400;
+        for (size_t i = 0; i < bars; ++i) {
+            const char* sep = i == 0 ? "" : ",";
+            double price = 100.0 + std::sin(i * 0.01) * 20.0;
+            timestamps += sep + std::to_string(ts + static_cast<int64_t>(i) * step);
+            open += sep + std::to_string(price);
+            high += sep + std::to_string(price + 1.25);
+            low += sep + std::to_string(price - 1.25);
+            close += sep + std::to_string(price + 0.5);
+            adjclose += sep + std::to_string(price * 0.98);
+            volume += sep + std::to_string(1000000 + (i * 7919) % 500000);
+        }
+
+        return "{\"chart\":{\"result\":[{\"meta\":{\"currency\":\"USD\",\"symbol\":\"AAPL\","
+               "\"exchangeName\":\"NMS\",\"instrumentType\":\"EQUITY\",\"gmtoffset\":-18000,"
+               "\"timezone\":\"EST\",\"exchangeTimezoneName\":\"America/New_York\","
+               "\"regularMarketPrice\":189.5,\"chartPreviousClose\":180.1,\"priceHint\":2},"
+               "\"timestamp\":[" + timestamps + "],"
+               "\"events\":{\"dividends\":{\"1262615400\":{\"amount\":0.24,\"date\":1262615400}}},"
+               "\"indicators\":{\"quote\":[{\"open\":[" + open + "],\"high\":[" + high + "],"
+               "\"low\":[" + low + "],\"close\":[" + close + "],\"volume\":[" + volume + "]}],"
+               "\"adjclose\":[{\"adjclose\":[" + adjclose + "]}]}}],\"error\":null}}";
+    }
+
+    void copy_column(const nlohmann::json& array, std::vector<double>& column) {
+        column.reserve(array.size());
+        for (const auto& value : array) {
+            column.push_back(value.is_null() ? NAN : value.get<double>());
+        }
+    }
+
+    yfinance::PriceHistory decode_with_dom(const std::string& payload) {
+        auto doc = yfinance::JsonParser::parse(payload);
+        const auto& result = doc["chart"]["result"][0];
+
+        yfinance::PriceHistory history;
+        for (const auto& ts : result["timestamp"]) {
+            history.timestamp.push_back(ts.get<int64_t>());
+        }
+        const auto& quote = result["indicators"]["quote"][0];
+        copy_column(quote["open"], history.open);
+        copy_column(quote["high"], history.high);
+        copy_column(quote["low"], history.low);
+        copy_column(quote["close"], history.close);
+        copy_column(quote["volume"], history.volume);
+        copy_column(result["indicators"]["adjclose"][0]["adjclose"], history.adjclose);
+        history.meta.symbol = result["meta"]["symbol"].get<std::string>();
+        return history;
+    }
+
+    template <typename Decode>
+    void measure(const std::string& label, const std::string& payload, int iterations, Decode decode) {
+        auto allocations = bench::allocation_count();
+        size_t rows = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            rows += decode(payload).size();
+        }
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+        auto used = bench::allocations_since(allocations);
+        std::cout << "  " << label << ": " << (elapsed.count() / iterations) << " ms, "
+                  << (used.allocations / iterations) << " allocations, "
+                  << (used.bytes / iterations / 1024) << " KiB allocated per decode ("
+                  << (rows / iterations) << " rows)" << std::endl;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 20;
+
+    struct Case {
+        const char* name;
+        size_t bars;
+        int64_t step;
+    };
+
+    try {
+        for (const Case& c : {Case{"10y daily", 2520, 86400}, Case{"60d 1m", 60 * 390, 60}}) {
+            std::string payload = make_chart(c.bars, c.step);
+            std::cout << c.name << " (" << (payload.size() / 1024) << " KiB)" << std::endl;
+
+            measure("DOM + copy   ", payload, iterations, decode_with_dom);
+            measure("ChartDecoder ", payload, iterations, [](const std::string& p) {
+                return yfinance::ChartDecoder::decode(p);
+            });
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+
+#include <curl/curl.h>
+
+#include "http_client.h"
+
+// Compares a fresh easy handle per request (what every new HttpClient used to
+// do) against HttpClient borrowing handles from the shared ConnectionPool.
+//
+// Usage: bench_connection_pool [url] [requests]
+// Point the url at a local server replaying recorded Yahoo responses so the
+// numbers are not dominated by internet latency.
+
+namespace {
+
+    size_t discard_body(void* /*contents*/, size_t size, size_t nmemb, void* /*userp*/) {
+        return size * nmemb;
+    }
+
+    double run_unpooled(const std::string& url, int requests) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < requests; ++i) {
+            CURL* curl = curl_easy_init();
+            curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, discard_body);
+            curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "");
+            curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+            CURLcode res = curl_easy_perform(curl);
+            curl_easy_cleanup(curl);
+            if (res != CURLE_OK) {
+                throw std::runtime_error(std::string("Request failed: ") + curl_easy_strerror(res));
+            }
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+
+    double run_pooled(const std::string& url, int requests) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < requests; ++i) {
+            // A new client per request mirrors one Ticker per symbol
+            yfinance::HttpClient client;
+            client.set_retries(0);
+            client.get_text(url);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+
+    void report(const std::string& label, int requests, double seconds) {
+        std::cout << label << ": " << requests << " requests in " << seconds << " s ("
+                  << (requests / seconds) << " req/s)" << std::endl;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string url = argc > 1 ? argv[1] : "http://127.0.0.1:8080/v8/finance/chart/AAPL";
+    int requests = argc > 2 ? std::atoi(argv[2]) : 200;
+
+    try {
+        curl_global_init(CURL_GLOBAL_DEFAULT);
+
+        double unpooled = run_unpooled(url, requests);
+        report("Handle per request", requests, unpooled);
+
+        double pooled = run_pooled(url, requests);
+        report("Pooled handles    ", requests, pooled);
+
+        std::cout << "Speedup: " << (unpooled / pooled) << "x" << std::endl;
+
+        curl_global_cleanup();
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
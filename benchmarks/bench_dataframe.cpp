@@ -0,0 +1,78 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <variant>
+#include <chrono>
+#include <cmath>
+
+#include "dataframe.h"
+
+// Summing a column of a million doubles with a few nulls: the previous
+// std::vector<std::variant<int, double, std::string, bool>> column layout,
+// read through a copying operator[], versus a typed Column read through a
+// Span with NaN marking the nulls.
+//
+// Usage: bench_dataframe [rows]
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+    using DataValue = std::variant<int, double, std::string, bool>;
+
+    constexpr int kRepeats = 20;
+
+    template <typename Sum>
+    void measure(const std::string& label, size_t rows, size_t bytes, Sum sum) {
+        double result = 0.0;
+        auto start = Clock::now();
+        for (int i = 0; i < kRepeats; ++i) {
+            result += sum();
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        std::cout << "  " << label << ": " << (rows * kRepeats / seconds / 1e6) << " M values/s, "
+                  << (static_cast<double>(bytes) / rows) << " bytes per value (sum " << result / kRepeats << ")"
+                  << std::endl;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t rows = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 1000000;
+
+    std::vector<DataValue> variants;
+    variants.reserve(rows);
+    yfinance::Column column("Close", yfinance::ColumnType::Double);
+    column.reserve(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        double value = i % 101 == 0 ? std::nan("") : 100.0 + (i % 977) * 0.125;
+        variants.emplace_back(std::in_place_type<double>, value);
+        column.append_double(value);
+    }
+
+    std::cout << rows << " rows, " << column.null_count() << " nulls" << std::endl;
+
+    measure("variant column", rows, variants.capacity() * sizeof(DataValue), [&] {
+        double sum = 0.0;
+        for (size_t i = 0; i < variants.size(); ++i) {
+            DataValue value = variants[i];  // What DataColumn::operator[] returned
+            double number = std::get<double>(value);
+            if (!std::isnan(number)) {
+                sum += number;
+            }
+        }
+        return sum;
+    });
+
+    size_t column_bytes = rows * sizeof(double) + (rows + 7) / 8;
+    measure("typed column  ", rows, column_bytes, [&] {
+        double sum = 0.0;
+        for (double value : column.doubles()) {
+            if (!std::isnan(value)) {
+                sum += value;
+            }
+        }
+        return sum;
+    });
+
+    return 0;
+}
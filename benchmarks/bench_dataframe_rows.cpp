@@ -0,0 +1,166 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <variant>
+#include <chrono>
+#include <cstdlib>
+#include <cmath>
+
+#include "dataframe.h"
+#include "allocation_counter.h"
+
+// Row-wise and column-wise iteration over a 100k-row OHLCV frame:
+//   - get_row as it used to be (a std::map of name -> variant per row)
+//   - RowView by column name (hashed lookup) and by resolved column index
+//   - column spans
+// plus column lookup by name: a linear scan with string compares versus the
+// hashed index. Allocations are counted for every variant.
+//
+// Usage: bench_dataframe_rows [rows]
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+    using DataValue = std::variant<int, double, std::string, bool>;
+
+    const char* const kPriceColumns[] = {"Open", "High", "Low", "Close"};
+
+    yfinance::DataFrame make_frame(size_t rows) {
+        yfinance::DataFrame frame;
+        auto& date = frame.add_column("Date", yfinance::ColumnType::Timestamp);
+        std::vector<yfinance::Column*> prices;
+        for (const char* name : kPriceColumns) {
+            prices.push_back(&frame.add_column(name, yfinance::ColumnType::Double));
+        }
+        auto& volume = frame.add_column("Volume", yfinance::ColumnType::Int64);
+        auto& symbol = frame.add_column("Symbol", yfinance::ColumnType::String);
+
+        frame.reserve(rows);
+        for (size_t i = 0; i < rows; ++i) {
+            date.append_int64(1262615400 + static_cast<int64_t>(i) * 60);
+            for (size_t p = 0; p < prices.size(); ++p) {
+                prices[p]->append_double(i % 101 == 0 ? std::nan("") : 100.0 + (i % 977) * 0.125 + p);
+            }
+            volume.append_int64(static_cast<int64_t>(1000 + i % 5000));
+            symbol.append_string(i % 2 ? "AAPL" : "MSFT");
+        }
+        return frame;
+    }
+
+    // What DataFrame::get_row returned before RowView
+    std::map<std::string, DataValue> copy_row(const yfinance::DataFrame& frame, size_t row) {
+        std::map<std::string, DataValue> values;
+        for (size_t c = 0; c < frame.cols(); ++c) {
+            const auto& column = frame.column(c);
+            switch (column.type()) {
+                case yfinance::ColumnType::Double:
+                    values[column.name()] = column.doubles()[row];
+                    break;
+                case yfinance::ColumnType::String:
+                    values[column.name()] = std::string(column.string_at(row));
+                    break;
+                default:
+                    values[column.name()] = static_cast<int>(column.int64s()[row]);
+                    break;
+            }
+        }
+        return values;
+    }
+
+    template <typename Run>
+    void measure(const std::string& label, size_t rows, Run run) {
+        auto allocations_before = bench::allocation_count();
+        auto start = Clock::now();
+        double result = run();
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        uint64_t allocations = bench::allocations_since(allocations_before).allocations;
+
+        std::cout << "  " << label << ": " << (seconds * 1000.0) << " ms, "
+                  << (rows / seconds / 1e6) << " M rows/s, " << allocations << " allocations"
+                  << " (result " << result << ")" << std::endl;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t rows = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 100000;
+    yfinance::DataFrame frame = make_frame(rows);
+    std::cout << rows << " rows x " << frame.cols() << " columns" << std::endl;
+
+    std::cout << "row-wise: mean close of the AAPL rows" << std::endl;
+    measure("get_row copy (map)  ", rows, [&] {
+        double sum = 0.0;
+        for (size_t row = 0; row < frame.rows(); ++row) {
+            auto values = copy_row(frame, row);
+            double close = std::get<double>(values["Close"]);
+            if (std::get<std::string>(values["Symbol"]) == "AAPL" && !std::isnan(close)) {
+                sum += close;
+            }
+        }
+        return sum / rows;
+    });
+    const std::string close_name = "Close", symbol_name = "Symbol";
+    measure("RowView by name     ", rows, [&] {
+        double sum = 0.0;
+        for (yfinance::RowView row : frame) {
+            double close = row.get<double>(close_name);
+            if (row.get<std::string_view>(symbol_name) == "AAPL" && !std::isnan(close)) {
+                sum += close;
+            }
+        }
+        return sum / rows;
+    });
+    measure("RowView by index    ", rows, [&] {
+        size_t close_column = frame.column_index("Close");
+        size_t symbol_column = frame.column_index("Symbol");
+        double sum = 0.0;
+        for (yfinance::RowView row : frame) {
+            double close = row.get<double>(close_column);
+            if (row.get<std::string_view>(symbol_column) == "AAPL" && !std::isnan(close)) {
+                sum += close;
+            }
+        }
+        return sum / rows;
+    });
+
+    std::cout << "column-wise: same result over spans" << std::endl;
+    measure("column spans        ", rows, [&] {
+        auto close = frame.column("Close").doubles();
+        const auto& symbol = frame.column("Symbol");
+        auto codes = symbol.codes();
+        int32_t aapl = symbol.dictionary()[0] == "AAPL" ? 0 : 1;
+        double sum = 0.0;
+        for (size_t i = 0; i < close.size(); ++i) {
+            if (codes[i] == aapl && !std::isnan(close[i])) {
+                sum += close[i];
+            }
+        }
+        return sum / rows;
+    });
+
+    std::cout << "column lookup by name, " << rows << " lookups" << std::endl;
+    const std::vector<std::string> names(frame.get_column_names());
+    measure("linear scan         ", rows, [&] {
+        size_t found = 0;
+        for (size_t i = 0; i < rows; ++i) {
+            const std::string& wanted = names[i % names.size()];
+            for (size_t c = 0; c < frame.cols(); ++c) {
+                if (frame.column(c).name() == wanted) {
+                    found += c;
+                    break;
+                }
+            }
+        }
+        return static_cast<double>(found);
+    });
+    measure("hashed index        ", rows, [&] {
+        size_t found = 0;
+        for (size_t i = 0; i < rows; ++i) {
+            found += frame.column_index(names[i % names.size()]);
+        }
+        return static_cast<double>(found);
+    });
+
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+
+#include "chart_decoder.h"
+#include "history_store.h"
+#include "price_kernels.h"
+
+// Reloading a stored series: a cached chart response re-read and decoded
+// with ChartDecoder, versus a HistoryStore series mapped with open() (alone,
+// and with a pass over the close column so every page is touched). Runs a
+// 30-year daily series and a year of 1-minute bars; files are in the page
+// cache, so this is the warm-start cost without any HTTP.
+//
+// Usage: bench_history_store [iterations] [directory]
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    std::string synthetic_chart(size_t bars, int64_t step) {
+        std::string timestamps, quote;
+        for (const char* column : {"open", "high", "low", "close", "volume"}) {
+            quote += std::string(quote.empty() ? "" : ",") + "\"" + column + "\":[";
+            for (size_t i = 0; i < bars; ++i) {
+                quote += (i ? "," : "") + std::to_string(100.0 + (i % 977) * 0.125);
+            }
+            quote += "]";
+        }
+        for (size_t i = 0; i < bars; ++i) {
+            timestamps += (i ? "," : "") + std::to_string(631197000 + static_cast<int64_t>(i) * step);
+        }
+        return "{\"chart\":{\"result\":[{\"meta\":{\"symbol\":\"AAPL\",\"gmtoffset\":-18000},"
+               "\"timestamp\":[" + timestamps + "],\"indicators\":{\"quote\":[{" + quote + "}]}}],"
+               "\"error\":null}}";
+    }
+
+    std::string read_file(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    }
+
+    template <typename Load>
+    void measure(const std::string& label, int iterations, Load load) {
+        size_t checksum = 0;
+        auto start = Clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            checksum += load();
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        std::cout << "  " << label << ": " << (seconds * 1e3 / iterations) << " ms per load"
+                  << " (checksum " << checksum << ")" << std::endl;
+    }
+
+    void run(const std::string& directory, const std::string& interval, size_t bars, int64_t step, int iterations) {
+        std::string chart_path = directory + "/chart_" + interval + ".json";
+        std::string body = synthetic_chart(bars, step);
+        std::ofstream(chart_path, std::ios::binary) << body;
+
+        yfinance::HistoryStore store(directory + "/store");
+        store.remove("AAPL", interval);
+        yfinance::PriceHistory history = yfinance::ChartDecoder::decode(body);
+        auto start = Clock::now();
+        store.append("AAPL", interval, history);
+        double append_ms = std::chrono::duration<double>(Clock::now() - start).count() * 1e3;
+
+        std::cout << interval << ": " << bars << " bars, " << (body.size() / 1024) << " KiB of JSON, "
+                  << (bars * 7 * 8 / 1024) << " KiB of columns (initial append " << append_ms << " ms)" << std::endl;
+
+        measure("JSON file + ChartDecoder      ", iterations, [&] {
+            return yfinance::ChartDecoder::decode(read_file(chart_path)).size();
+        });
+        measure("HistoryStore::open            ", iterations, [&] {
+            return store.open("AAPL", interval)->size();
+        });
+        measure("HistoryStore::open + stats    ", iterations, [&] {
+            auto mapped = store.open("AAPL", interval);
+            return yfinance::PriceKernels::stats(mapped->close()).count;
+        });
+        measure("HistoryStore::to_price_history", iterations, [&] {
+            return store.open("AAPL", interval)->to_price_history().size();
+        });
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 50;
+    std::string directory = argc > 2 ? argv[2]
+                                     : (std::filesystem::temp_directory_path() / "yfinance-bench-history").string();
+    std::filesystem::create_directories(directory);
+
+    run(directory, "1d", 30 * 252, 86400, iterations);
+    run(directory, "1m", 252 * 390, 60, iterations);
+
+    std::filesystem::remove_all(directory);
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+#include "http_client.h"
+
+// Compares async request throughput over HTTP/1.1 against HTTP/2 stream
+// multiplexing.
+//
+// Usage: bench_http2 <http1-url> <http2-url> [requests] [streams] [ca-bundle]
+//
+// An h2-capable stand-in such as nghttpd can serve a directory of recorded
+// responses, using a self-signed certificate passed as the CA bundle:
+//   nghttpd -d fixtures/ 8443 key.pem cert.pem
+//   bench_http2 http://127.0.0.1:8080/v8/finance/chart/AAPL
+//               https://localhost:8443/v8/finance/chart/AAPL 1000 100 cert.pem
+// https URLs negotiate HTTP/2 via ALPN; cleartext URLs use prior knowledge.
+
+namespace {
+
+    double run(const std::string& url, yfinance::HttpVersion version, int requests, const std::string& ca_bundle) {
+        yfinance::HttpClient client;
+        client.set_retries(0);
+        client.set_http_version(version);
+        if (!ca_bundle.empty()) {
+            client.set_ca_info(ca_bundle);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+
+        std::vector<std::future<std::string>> pending;
+        pending.reserve(requests);
+        for (int i = 0; i < requests; ++i) {
+            pending.push_back(client.get_text_async(url));
+        }
+
+        int failures = 0;
+        for (auto& response : pending) {
+            try {
+                response.get();
+            } catch (const std::exception&) {
+                ++failures;
+            }
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (failures > 0) {
+            std::cerr << failures << " of " << requests << " requests failed for " << url << std::endl;
+        }
+        return elapsed.count();
+    }
+
+    void report(const std::string& label, int requests, double seconds) {
+        std::cout << label << ": " << requests << " requests in " << seconds << " s ("
+                  << (requests / seconds) << " req/s)" << std::endl;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <http1-url> <http2-url> [requests] [streams] [ca-bundle]" << std::endl;
+        return 1;
+    }
+
+    std::string http1_url = argv[1];
+    std::string http2_url = argv[2];
+    int requests = argc > 3 ? std::atoi(argv[3]) : 1000;
+    long streams = argc > 4 ? std::atol(argv[4]) : 100;
+    std::string ca_bundle = argc > 5 ? argv[5] : "";
+
+    auto http2_version = http2_url.rfind("https://", 0) == 0
+        ? yfinance::HttpVersion::Http2
+        : yfinance::HttpVersion::Http2PriorKnowledge;
+
+    try {
+        // HTTP/1.1: one connection per in-flight request
+        yfinance::HttpClient::set_max_host_connections(0);
+        double http1 = run(http1_url, yfinance::HttpVersion::Http1_1, requests, ca_bundle);
+        report("HTTP/1.1", requests, http1);
+
+        // HTTP/2: a couple of connections carrying many streams each
+        yfinance::HttpClient::set_max_host_connections(2);
+        yfinance::HttpClient::set_max_concurrent_streams(streams);
+        double http2 = run(http2_url, http2_version, requests, ca_bundle);
+        report("HTTP/2  ", requests, http2);
+
+        std::cout << "Speedup: " << (http1 / http2) << "x" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
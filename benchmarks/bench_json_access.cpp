@@ -0,0 +1,121 @@
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+#include <utility>
+
+#include "json_parser.h"
+#include "allocation_counter.h"
+
+// Pulls modules out of a parsed get_info-sized quoteSummary response two ways:
+// the has_field/extract_field chain Ticker used to run (every call copies the
+// quoteSummary subtree) and the non-owning find/find_path accessors, which
+// hand out pointers into the document and move the module out at the end.
+//
+// Usage: bench_json_access [iterations]
+
+namespace {
+
+    const char* const kModules[] = {
+        "assetProfile", "summaryProfile", "summaryDetail", "quoteType", "fundProfile",
+        "price", "defaultKeyStatistics", "financialData", "calendarEvents"
+    };
+
+    // quoteSummary response with nine modules of 60 {"raw", "fmt"} fields each
+    nlohmann::json make_quote_summary() {
+        nlohmann::json result = nlohmann::json::object();
+        for (const char* module : kModules) {
+            nlohmann::json fields = nlohmann::json::object();
+            for (int i = 0; i < 60; ++i) {
+                fields["field" + std::to_string(i)] = {{"raw", 1000.25 + i}, {"fmt", std::to_string(1000 + i) + ".25"}};
+            }
+            result[module] = std::move(fields);
+        }
+        result["assetProfile"]["companyOfficers"] = nlohmann::json::array();
+        for (int i = 0; i < 10; ++i) {
+            result["assetProfile"]["companyOfficers"].push_back(
+                {{"name", "Officer " + std::to_string(i)}, {"title", "Vice President"}, {"age", 50 + i}});
+        }
+
+        nlohmann::json response;
+        response["quoteSummary"]["result"] = nlohmann::json::array({result});
+        response["quoteSummary"]["error"] = nullptr;
+        return response;
+    }
+
+    // What Ticker::get_earnings() etc. did before the accessors existed
+    nlohmann::json module_by_copy(const nlohmann::json& response, const std::string& module) {
+        using yfinance::JsonParser;
+        if (JsonParser::has_field(response, "quoteSummary") &&
+            JsonParser::has_field(JsonParser::extract_field(response, "quoteSummary"), "result")) {
+
+            auto result = JsonParser::extract_field(JsonParser::extract_field(response, "quoteSummary"), "result");
+            if (!result.empty()) {
+                return JsonParser::extract_field(result[0], module);
+            }
+        }
+        return nlohmann::json();
+    }
+
+    // What Ticker::quote_summary_module() does now
+    nlohmann::json module_by_reference(nlohmann::json& response, const std::string& module) {
+        using yfinance::JsonParser;
+        nlohmann::json* results = JsonParser::find_path(response, {"quoteSummary", "result"});
+        if (nlohmann::json* result = results ? JsonParser::find_element(*results, 0) : nullptr) {
+            return std::move(JsonParser::get_field(*result, module));
+        }
+        return nlohmann::json();
+    }
+
+    // Time and count allocations of `extract` over a fresh copy of the
+    // response per iteration; the cost of that copy is subtracted
+    template <typename Extract>
+    void measure(const std::string& label, const nlohmann::json& response, int iterations, Extract extract) {
+        using Clock = std::chrono::steady_clock;
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+        Clock::duration elapsed{0};
+        size_t fields = 0;
+
+        for (int i = 0; i < iterations; ++i) {
+            nlohmann::json document = response;
+
+            auto allocations_before = bench::allocation_count();
+            auto start = Clock::now();
+            fields += extract(document, "financialData").size();
+            elapsed += Clock::now() - start;
+            auto used = bench::allocations_since(allocations_before);
+            allocations += used.allocations;
+            bytes += used.bytes;
+        }
+
+        double us = std::chrono::duration<double, std::micro>(elapsed).count() / iterations;
+        std::cout << "  " << label << ": " << us << " us, "
+                  << (static_cast<double>(allocations) / iterations) << " allocations, "
+                  << (static_cast<double>(bytes) / iterations / 1024.0) << " KiB allocated per call ("
+                  << (fields / iterations) << " fields)" << std::endl;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 200;
+
+    try {
+        nlohmann::json response = make_quote_summary();
+        std::cout << "quoteSummary with " << (sizeof(kModules) / sizeof(kModules[0])) << " modules ("
+                  << (response.dump().size() / 1024) << " KiB)" << std::endl;
+
+        measure("has_field/extract_field", response, iterations, [](nlohmann::json& doc, const char* module) {
+            return module_by_copy(doc, module);
+        });
+        measure("find/find_path + move  ", response, iterations, [](nlohmann::json& doc, const char* module) {
+            return module_by_reference(doc, module);
+        });
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
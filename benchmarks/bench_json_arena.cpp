@@ -0,0 +1,94 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <cstdlib>
+
+#include "json_parser.h"
+#include "allocation_counter.h"
+
+// Parses a synthetic /v7/finance/options payload over and over from several
+// threads, into a heap-allocated nlohmann::json and into an ArenaDocument,
+// reporting documents per second and heap allocations per document.
+//
+// Usage: bench_json_arena [contracts] [seconds]
+
+namespace {
+
+    std::string make_options(int contracts) {
+        std::string calls, puts;
+        for (int i = 0; i < contracts; ++i) {
+            std::string strike = std::to_string(50 + i);
+            std::string contract =
+                "{\"contractSymbol\":\"AAPL240119C00" + strike + "000\",\"strike\":" + strike + ".0,"
+                "\"currency\":\"USD\",\"lastPrice\":" + std::to_string(i * 0.37) + ",\"change\":-0.25,"
+                "\"percentChange\":-1.5,\"volume\":" + std::to_string(100 + i) + ",\"openInterest\":" +
+                std::to_string(1000 + i * 3) + ",\"bid\":1.2,\"ask\":1.3,\"contractSize\":\"REGULAR\","
+                "\"expiration\":1705622400,\"lastTradeDate\":1705500000,\"impliedVolatility\":0.2841,"
+                "\"inTheMoney\":" + (i % 2 ? "true" : "false") + "}";
+            calls += (i ? "," : "") + contract;
+            puts += (i ? "," : "") + contract;
+        }
+        return "{\"optionChain\":{\"result\":[{\"underlyingSymbol\":\"AAPL\",\"expirationDates\":[1705622400,1706227200],"
+               "\"strikes\":[50.0,55.0],\"hasMiniOptions\":false,\"quote\":{\"symbol\":\"AAPL\",\"regularMarketPrice\":189.5},"
+               "\"options\":[{\"expirationDate\":1705622400,\"hasMiniOptions\":false,\"calls\":[" + calls +
+               "],\"puts\":[" + puts + "]}]}],\"error\":null}}";
+    }
+
+    template <typename Parse>
+    void measure(const std::string& label, const std::string& payload, int threads, double seconds, Parse parse) {
+        std::atomic<uint64_t> documents{0};
+        std::atomic<bool> stop{false};
+        auto allocations = bench::allocation_count();
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&] {
+                while (!stop.load(std::memory_order_relaxed)) {
+                    parse(payload);
+                    documents.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+        std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+        stop = true;
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        std::cout << "  " << label << " x" << threads << ": " << (documents.load() / elapsed.count()) << " docs/s, "
+                  << (static_cast<double>(bench::allocations_since(allocations).allocations) / documents.load())
+                  << " heap allocations per doc" << std::endl;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int contracts = argc > 1 ? std::atoi(argv[1]) : 400;
+    double seconds = argc > 2 ? std::atof(argv[2]) : 1.0;
+
+    try {
+        std::string payload = make_options(contracts);
+        std::cout << "options chain with " << 2 * contracts << " contracts (" << (payload.size() / 1024)
+                  << " KiB)" << std::endl;
+
+        int hardware = static_cast<int>(std::thread::hardware_concurrency());
+        for (int threads : {1, 4, hardware > 4 ? hardware : 8}) {
+            measure("nlohmann::json   ", payload, threads, seconds, [](const std::string& p) {
+                return nlohmann::json::parse(p).size();
+            });
+            measure("ArenaDocument    ", payload, threads, seconds, [](const std::string& p) {
+                return yfinance::JsonParser::parse_arena(p).root().size();
+            });
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+#include <nlohmann/json.hpp>
+
+#include "json_parser.h"
+#include "chart_decoder.h"
+
+// Parse throughput on recorded Yahoo payloads: nlohmann::json::parse,
+// JsonParser::parse (simdjson when built with -DUSE_SIMDJSON=ON) and, for
+// chart responses, ChartDecoder.
+//
+// Usage: bench_json_parse [payload-file ...]
+// Pass the .body files of a fixture directory recorded with
+// YFINANCE_RECORD_DIR; without arguments a synthetic chart is used.
+
+namespace {
+
+    constexpr double kTargetSeconds = 0.5;
+
+    std::string read_file(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("Cannot open " + path);
+        }
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    }
+
+    std::string synthetic_chart(size_t bars) {
+        std::string timestamps, quote;
+        for (const char* column : {"open", "high", "low", "close", "volume"}) {
+            quote += std::string(quote.empty() ? "" : ",") + "\"" + column + "\":[";
+            for (size_t i = 0; i < bars; ++i) {
+                quote += (i ? "," : "") + std::to_string(100.0 + (i % 977) * 0.125);
+            }
+            quote += "]";
+        }
+        for (size_t i = 0; i < bars; ++i) {
+            timestamps += (i ? "," : "") + std::to_string(1262615400 + static_cast<int64_t>(i) * 60);
+        }
+        return "{\"chart\":{\"result\":[{\"meta\":{\"symbol\":\"AAPL\",\"gmtoffset\":-18000},"
+               "\"timestamp\":[" + timestamps + "],\"indicators\":{\"quote\":[{" + quote + "}]}}],"
+               "\"error\":null}}";
+    }
+
+    // Run parse repeatedly for about kTargetSeconds and report MB/s
+    template <typename Parse>
+    void measure(const std::string& label, const std::string& payload, Parse parse) {
+        size_t iterations = 0;
+        auto start = std::chrono::steady_clock::now();
+        std::chrono::duration<double> elapsed{0};
+        do {
+            parse(payload);
+            ++iterations;
+            elapsed = std::chrono::steady_clock::now() - start;
+        } while (elapsed.count() < kTargetSeconds);
+
+        double megabytes = static_cast<double>(payload.size()) * iterations / (1024.0 * 1024.0);
+        std::cout << "  " << label << ": " << (megabytes / elapsed.count()) << " MB/s ("
+                  << (elapsed.count() * 1000.0 / iterations) << " ms per document)" << std::endl;
+    }
+
+    void run(const std::string& name, const std::string& payload) {
+        std::cout << name << " (" << (payload.size() / 1024) << " KiB)" << std::endl;
+
+        measure("nlohmann::json::parse       ", payload, [](const std::string& p) {
+            return nlohmann::json::parse(p).size();
+        });
+        measure(std::string("JsonParser::parse (") + yfinance::JsonParser::backend() + ")" +
+                    std::string(9 - std::string(yfinance::JsonParser::backend()).size(), ' '),
+                payload, [](const std::string& p) {
+            return yfinance::JsonParser::parse(p).size();
+        });
+
+        if (payload.find("\"chart\"") != std::string::npos && payload.find("\"chart\"") < 16) {
+            measure("ChartDecoder                ", payload, [](const std::string& p) {
+                return yfinance::ChartDecoder::decode(p).size();
+            });
+        }
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        if (argc < 2) {
+            run("synthetic 60d 1m chart", synthetic_chart(60 * 390));
+        }
+        for (int i = 1; i < argc; ++i) {
+            run(argv[i], read_file(argv[i]));
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+#include "json_parser.h"
+#include "allocation_counter.h"
+
+// Extracts quoteSummary.result[0].financialData.currentPrice.raw from a batch
+// of parsed documents (what a screening job does per symbol) three ways:
+// chained contains/at calls, and a compiled JsonPath evaluated per document
+// or over the whole batch.
+//
+// Usage: bench_json_path [documents] [rounds]
+
+namespace {
+
+    nlohmann::json make_document(int i) {
+        nlohmann::json financial_data = nlohmann::json::object();
+        for (const char* field : {"targetHighPrice", "targetLowPrice", "targetMeanPrice", "recommendationMean",
+                                  "totalCash", "totalDebt", "totalRevenue", "grossProfits", "freeCashflow",
+                                  "operatingCashflow", "earningsGrowth", "revenueGrowth", "grossMargins",
+                                  "ebitdaMargins", "operatingMargins", "profitMargins", "returnOnAssets"}) {
+            financial_data[field] = {{"raw", 1.5 * i}, {"fmt", "1.50"}};
+        }
+        // Every tenth symbol has no price, as with delisted tickers
+        if (i % 10 != 0) {
+            financial_data["currentPrice"] = {{"raw", 100.0 + i * 0.01}, {"fmt", "100.00"}};
+        }
+
+        nlohmann::json doc;
+        doc["quoteSummary"]["result"] = nlohmann::json::array({{{"financialData", std::move(financial_data)}}});
+        doc["quoteSummary"]["error"] = nullptr;
+        return doc;
+    }
+
+    double chained_lookup(const nlohmann::json& doc) {
+        if (doc.contains("quoteSummary") && doc.at("quoteSummary").contains("result")) {
+            const auto& result = doc.at("quoteSummary").at("result");
+            if (!result.empty() && result.at(0).contains("financialData")) {
+                const auto& data = result.at(0).at("financialData");
+                if (data.contains("currentPrice") && data.at("currentPrice").contains("raw")) {
+                    return data.at("currentPrice").at("raw").get<double>();
+                }
+            }
+        }
+        return NAN;
+    }
+
+    template <typename Extract>
+    void measure(const std::string& label, const std::vector<nlohmann::json>& docs, int rounds, Extract extract) {
+        std::vector<double> prices;
+        prices.reserve(docs.size());
+
+        auto allocations = bench::allocation_count();
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            extract(docs, prices);
+        }
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+        size_t found = 0;
+        for (double price : prices) {
+            found += std::isnan(price) ? 0 : 1;
+        }
+        double lookups = static_cast<double>(docs.size()) * rounds;
+        std::cout << "  " << label << ": " << (elapsed.count() / lookups) << " ns, "
+                  << (bench::allocations_since(allocations).allocations / lookups) << " allocations per lookup ("
+                  << found << "/" << docs.size() << " found)" << std::endl;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int count = argc > 1 ? std::atoi(argv[1]) : 5000;
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 20;
+
+    try {
+        std::vector<nlohmann::json> docs;
+        docs.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            docs.push_back(make_document(i));
+        }
+        std::cout << count << " documents x " << rounds << " rounds" << std::endl;
+
+        measure("contains/at chain    ", docs, rounds, [](const std::vector<nlohmann::json>& d, std::vector<double>& out) {
+            out.clear();
+            for (const auto& doc : d) {
+                out.push_back(chained_lookup(doc));
+            }
+        });
+
+        const yfinance::JsonPath path("quoteSummary.result[0].financialData.currentPrice.raw");
+        measure("JsonPath::number_or  ", docs, rounds, [&path](const std::vector<nlohmann::json>& d, std::vector<double>& out) {
+            out.clear();
+            for (const auto& doc : d) {
+                out.push_back(path.number_or(doc, NAN));
+            }
+        });
+        measure("JsonPath::numbers    ", docs, rounds, [&path](const std::vector<nlohmann::json>& d, std::vector<double>& out) {
+            path.numbers(d, out);
+        });
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
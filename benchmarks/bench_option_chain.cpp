@@ -0,0 +1,127 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <chrono>
+#include <cmath>
+
+#include <nlohmann/json.hpp>
+
+#include "json_parser.h"
+#include "option_chain_decoder.h"
+
+// Decoding an options payload and computing an open-interest weighted
+// implied volatility: walking the JSON DOM versus OptionChainDecoder's
+// columns.
+//
+// Usage: bench_option_chain [payload-file]
+// Pass the .body file of a recorded /v7/finance/options fixture; without
+// it a synthetic chain of 2000 contracts is used.
+
+namespace {
+
+    constexpr double kTargetSeconds = 0.5;
+
+    std::string read_file(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("Cannot open " + path);
+        }
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    }
+
+    std::string synthetic_contracts(const char* side, size_t count, int64_t expiration) {
+        std::string out = std::string("\"") + side + "\":[";
+        for (size_t i = 0; i < count; ++i) {
+            double strike = 50.0 + i * 0.5;
+            out += std::string(i ? "," : "") +
+                   "{\"contractSymbol\":\"AAPL" + std::to_string(expiration) + side[0] + std::to_string(i) + "\","
+                   "\"strike\":" + std::to_string(strike) + ",\"currency\":\"USD\","
+                   "\"lastPrice\":" + std::to_string(1.0 + (i % 97) * 0.05) + ",\"change\":-0.12,\"percentChange\":-1.5,"
+                   "\"volume\":" + std::to_string(10 + i % 500) + ",\"openInterest\":" + std::to_string(100 + i % 900) + ","
+                   "\"bid\":" + std::to_string(0.95 + (i % 97) * 0.05) + ",\"ask\":" + std::to_string(1.05 + (i % 97) * 0.05) + ","
+                   "\"contractSize\":\"REGULAR\",\"expiration\":" + std::to_string(expiration) + ","
+                   "\"lastTradeDate\":" + std::to_string(expiration - 86400) + ","
+                   "\"impliedVolatility\":" + std::to_string(0.2 + (i % 31) * 0.01) + ",\"inTheMoney\":" + (strike < 150 ? "true" : "false") + "}";
+        }
+        return out + "]";
+    }
+
+    std::string synthetic_chain(size_t contracts_per_side) {
+        int64_t expiration = 1700179200;
+        return "{\"optionChain\":{\"result\":[{\"underlyingSymbol\":\"AAPL\",\"expirationDates\":[1700179200,1700784000],"
+               "\"strikes\":[50.0,50.5],\"hasMiniOptions\":false,\"quote\":{\"symbol\":\"AAPL\",\"regularMarketPrice\":150.25},"
+               "\"options\":[{\"expirationDate\":" + std::to_string(expiration) + ",\"hasMiniOptions\":false," +
+               synthetic_contracts("calls", contracts_per_side, expiration) + "," +
+               synthetic_contracts("puts", contracts_per_side, expiration) + "}]}],\"error\":null}}";
+    }
+
+    template <typename Run>
+    void measure(const std::string& label, const std::string& payload, Run run) {
+        size_t iterations = 0;
+        double result = 0.0;
+        auto start = std::chrono::steady_clock::now();
+        std::chrono::duration<double> elapsed{0};
+        do {
+            result = run(payload);
+            ++iterations;
+            elapsed = std::chrono::steady_clock::now() - start;
+        } while (elapsed.count() < kTargetSeconds);
+
+        std::cout << "  " << label << ": " << (elapsed.count() * 1e6 / iterations) << " us per chain"
+                  << " (weighted IV " << result << ")" << std::endl;
+    }
+
+    // Open-interest weighted implied volatility over the JSON DOM
+    double weighted_iv_dom(const std::string& payload) {
+        auto doc = yfinance::JsonParser::parse(payload);
+        double weighted = 0.0, total = 0.0;
+        for (const auto& expiry : doc["optionChain"]["result"][0]["options"]) {
+            for (const char* side : {"calls", "puts"}) {
+                for (const auto& contract : expiry[side]) {
+                    double iv = contract.value("impliedVolatility", std::nan(""));
+                    double oi = contract.value("openInterest", 0.0);
+                    if (!std::isnan(iv)) {
+                        weighted += iv * oi;
+                        total += oi;
+                    }
+                }
+            }
+        }
+        return weighted / total;
+    }
+
+    // The same over OptionChain columns
+    double weighted_iv_columns(const std::string& payload) {
+        auto chain = yfinance::OptionChainDecoder::decode(payload);
+        double weighted = 0.0, total = 0.0;
+        for (size_t i = 0; i < chain.size(); ++i) {
+            double iv = chain.implied_volatility[i];
+            double oi = static_cast<double>(chain.open_interest[i]);
+            if (!std::isnan(iv)) {
+                weighted += iv * oi;
+                total += oi;
+            }
+        }
+        return weighted / total;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        std::string payload = argc > 1 ? read_file(argv[1]) : synthetic_chain(1000);
+        std::cout << "options payload (" << (payload.size() / 1024) << " KiB, "
+                  << yfinance::OptionChainDecoder::decode(payload).size() << " contracts)" << std::endl;
+
+        measure("JSON DOM          ", payload, weighted_iv_dom);
+        measure("OptionChainDecoder", payload, weighted_iv_columns);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
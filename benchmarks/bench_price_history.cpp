@@ -0,0 +1,105 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <random>
+
+#include "data_structures.h"
+#include "date_utils.h"
+
+// Time lookups over a 60d/1m history (23400 bars): bars keyed by ISO date
+// strings, found by a linear scan through DateUtils::string_to_timestamp or
+// by a string lower_bound after formatting the query, versus PriceHistory's
+// int64 epoch index (asof / between).
+//
+// Usage: bench_price_history [queries]
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    constexpr size_t kBars = 60 * 390;
+    constexpr int64_t kFirstBar = 1704205800;  // 2024-01-02 09:30 New York
+
+    template <typename Lookup>
+    void measure(const std::string& label, const std::vector<int64_t>& queries, Lookup lookup) {
+        size_t checksum = 0;
+        auto start = Clock::now();
+        for (int64_t query : queries) {
+            checksum += lookup(query);
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        std::cout << "  " << label << ": " << (seconds * 1e9 / queries.size()) << " ns per lookup"
+                  << " (checksum " << checksum << ")" << std::endl;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t query_count = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 10000;
+
+    yfinance::PriceHistory history;
+    history.meta.gmtoffset = -18000;
+    std::vector<std::string> dates;
+    dates.reserve(kBars);
+    for (size_t i = 0; i < kBars; ++i) {
+        int64_t ts = kFirstBar + static_cast<int64_t>(i / 390) * 86400 + static_cast<int64_t>(i % 390) * 60;
+        history.add_entry(ts, 100.0, 101.0, 99.0, 100.5, 1000.0);
+        dates.push_back(yfinance::DateUtils::format_epoch(ts, 0, "%Y-%m-%d %H:%M:%S"));
+    }
+
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int64_t> pick(history.timestamp.front(), history.timestamp.back());
+    std::vector<int64_t> queries(query_count);
+    for (auto& query : queries) {
+        query = pick(rng);
+    }
+
+    size_t string_bytes = 0;
+    for (const auto& date : dates) {
+        string_bytes += sizeof(std::string) + (date.capacity() > 15 ? date.capacity() + 1 : 0);
+    }
+    std::cout << kBars << " bars; index memory: " << (string_bytes / kBars) << " bytes per bar as strings, "
+              << sizeof(int64_t) << " as int64" << std::endl;
+
+    std::cout << "asof(t)" << std::endl;
+    // Parsing every date is slow enough that a sample of the queries suffices
+    std::vector<int64_t> sample(queries.begin(), queries.begin() + std::min<size_t>(queries.size(), 20));
+    setenv("TZ", "UTC", 1);
+    measure("string dates, parse each     ", sample, [&](int64_t t) {
+        size_t found = 0;
+        for (size_t i = 0; i < dates.size(); ++i) {
+            if (yfinance::DateUtils::string_to_timestamp(dates[i], "%Y-%m-%d %H:%M:%S") <= t) {
+                found = i;
+            }
+        }
+        return found;
+    });
+    measure("string dates, lower_bound    ", queries, [&](int64_t t) {
+        std::string key = yfinance::DateUtils::format_epoch(t, 0, "%Y-%m-%d %H:%M:%S");
+        auto it = std::upper_bound(dates.begin(), dates.end(), key);
+        return static_cast<size_t>(it - dates.begin()) - 1;
+    });
+    measure("PriceHistory::asof           ", queries, [&](int64_t t) {
+        return *history.asof(t);
+    });
+
+    std::cout << "between(t, t + 1 day)" << std::endl;
+    measure("string dates, lower_bound    ", queries, [&](int64_t t) {
+        std::string from = yfinance::DateUtils::format_epoch(t, 0, "%Y-%m-%d %H:%M:%S");
+        std::string to = yfinance::DateUtils::format_epoch(t + 86400, 0, "%Y-%m-%d %H:%M:%S");
+        auto first = std::lower_bound(dates.begin(), dates.end(), from);
+        auto last = std::lower_bound(first, dates.end(), to);
+        return static_cast<size_t>(last - first);
+    });
+    measure("PriceHistory::index_range    ", queries, [&](int64_t t) {
+        auto range = history.index_range(t, t + 86400);
+        return range.second - range.first;
+    });
+    measure("PriceHistory::between (copy) ", queries, [&](int64_t t) {
+        return history.between(t, t + 86400).size();
+    });
+
+    return 0;
+}
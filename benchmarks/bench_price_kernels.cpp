@@ -0,0 +1,84 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+#include "data_structures.h"
+#include "price_kernels.h"
+
+// Column aggregations over a PriceHistory with ~1% NaN gaps: stats() of the
+// close, VWAP and true range, run at every SIMD level this CPU supports.
+// Reports bars per second for each kernel and level.
+//
+// Usage: bench_price_kernels [bars] [iterations]
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    template <typename Kernel>
+    double measure(const std::string& label, size_t bars, int iterations, Kernel kernel) {
+        double checksum = 0.0;
+        auto start = Clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            checksum += kernel();
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        double rate = static_cast<double>(bars) * iterations / seconds / 1e6;
+        std::cout << "  " << label << ": " << rate << " M bars/s (checksum " << checksum << ")" << std::endl;
+        return rate;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t bars = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 1000000;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 50;
+
+    std::mt19937_64 rng(42);
+    std::normal_distribution<double> step(0.0, 0.1);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    yfinance::PriceHistory history;
+    double price = 100.0;
+    for (size_t i = 0; i < bars; ++i) {
+        price += step(rng);
+        double high = price + unit(rng);
+        double low = price - unit(rng);
+        double volume = std::floor(unit(rng) * 10000.0);
+        if (unit(rng) < 0.01) {
+            history.add_entry(1704205800 + static_cast<int64_t>(i) * 60,
+                              yfinance::kMissingValue, yfinance::kMissingValue, yfinance::kMissingValue,
+                              yfinance::kMissingValue, yfinance::kMissingValue);
+        } else {
+            history.add_entry(1704205800 + static_cast<int64_t>(i) * 60, price, high, low, price, volume);
+        }
+    }
+
+    std::vector<double> out(bars);
+    yfinance::SimdLevel detected = yfinance::PriceKernels::detected_level();
+    std::cout << bars << " bars x " << iterations << " iterations; CPU supports up to "
+              << yfinance::simd_level_name(detected) << std::endl;
+
+    for (int level = 0; level <= static_cast<int>(detected); ++level) {
+        auto simd = static_cast<yfinance::SimdLevel>(level);
+        yfinance::PriceKernels::set_level(simd);
+        std::cout << yfinance::simd_level_name(simd) << std::endl;
+
+        measure("stats(close)   ", bars, iterations, [&] {
+            return yfinance::PriceKernels::stats(history.close).mean;
+        });
+        measure("vwap           ", bars, iterations, [&] {
+            return yfinance::PriceKernels::vwap(history);
+        });
+        measure("true_range     ", bars, iterations, [&] {
+            yfinance::PriceKernels::true_range(history.high, history.low, history.close, out);
+            return out[bars / 2];
+        });
+    }
+    yfinance::PriceKernels::set_level(detected);
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+#include "quote_summary_decoder.h"
+#include "allocation_counter.h"
+
+// Memory and decode cost of keeping one symbol's financialData, summaryDetail,
+// defaultKeyStatistics and price modules as a JSON DOM vs. as the typed
+// QuoteSummary structs. Yahoo sends every numeric field as
+// {"raw": ..., "fmt": "...", "longFmt": "..."}; the structs keep only raw.
+//
+// Usage: bench_quote_summary [symbols]
+
+namespace {
+
+    nlohmann::json formatted(double raw) {
+        return {{"raw", raw}, {"fmt", std::to_string(raw)}, {"longFmt", std::to_string(raw) + ".000"}};
+    }
+
+    // A result object shaped like a real quoteSummary response, with every
+    // key of the descriptor tables plus the usual untyped extras
+    template <typename Module>
+    void add_module(nlohmann::json& result, int symbol) {
+        size_t count = 0;
+        const yfinance::FieldDescriptor* fields = yfinance::QuoteSummaryDecoder::fields<Module>(count);
+
+        nlohmann::json module = {{"maxAge", 1}};
+        for (size_t i = 0; i < count; ++i) {
+            if (fields[i].type == yfinance::FieldType::String) {
+                module[fields[i].key] = "USD";
+            } else {
+                module[fields[i].key] = formatted(1000.0 * symbol + i + 0.25);
+            }
+        }
+        for (int extra = 0; extra < 8; ++extra) {
+            module["untyped" + std::to_string(extra)] = formatted(extra);
+        }
+        result[yfinance::QuoteSummaryDecoder::module_name<Module>()] = std::move(module);
+    }
+
+    nlohmann::json make_result(int symbol) {
+        nlohmann::json result = nlohmann::json::object();
+        add_module<yfinance::FinancialData>(result, symbol);
+        add_module<yfinance::SummaryDetail>(result, symbol);
+        add_module<yfinance::DefaultKeyStatistics>(result, symbol);
+        add_module<yfinance::QuotePrice>(result, symbol);
+        return result;
+    }
+
+    template <typename Keep>
+    void measure(const std::string& label, const std::vector<nlohmann::json>& results, Keep keep) {
+        auto allocations = bench::allocation_count();
+        auto start = std::chrono::steady_clock::now();
+        keep(results);
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+        auto used = bench::allocations_since(allocations);
+        double n = static_cast<double>(results.size());
+        std::cout << "  " << label << ": " << (elapsed.count() / n) << " us, "
+                  << (used.allocations / n) << " allocations, "
+                  << (used.bytes / n / 1024.0) << " KiB per symbol" << std::endl;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int symbols = argc > 1 ? std::atoi(argv[1]) : 2000;
+
+    try {
+        std::vector<nlohmann::json> results;
+        results.reserve(symbols);
+        for (int i = 0; i < symbols; ++i) {
+            results.push_back(make_result(i));
+        }
+        std::cout << symbols << " symbols, sizeof(QuoteSummary) = " << sizeof(yfinance::QuoteSummary)
+                  << " bytes" << std::endl;
+
+        // Memory is what the kept objects allocate; the vectors are reserved
+        // up front and their block is counted once
+        measure("keep JSON modules  ", results, [](const std::vector<nlohmann::json>& r) {
+            std::vector<nlohmann::json> kept;
+            kept.reserve(r.size());
+            for (const auto& result : r) {
+                kept.push_back(result);
+            }
+        });
+        measure("decode QuoteSummary", results, [](const std::vector<nlohmann::json>& r) {
+            std::vector<yfinance::QuoteSummary> kept;
+            kept.reserve(r.size());
+            for (const auto& result : r) {
+                kept.push_back(yfinance::QuoteSummaryDecoder::decode_result(result));
+            }
+        });
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+
+#include "ticker.h"
+#include "yf_data.h"
+
+// End-to-end throughput and latency of Ticker::history through YfData and
+// HttpClient, against a replay_server serving recorded responses.
+//
+// Record fixtures once with network access:
+//   YFINANCE_RECORD_DIR=fixtures bench_replay https://query1.finance.yahoo.com 1 AAPL MSFT
+// then replay them offline:
+//   replay_server fixtures --port 8080 --latency-ms 20 &
+//   bench_replay http://127.0.0.1:8080 200 AAPL MSFT
+//
+// Usage: bench_replay <base-url> [requests] [symbols...]
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    double percentile(std::vector<double> values, double p) {
+        if (values.empty()) {
+            return 0.0;
+        }
+        std::sort(values.begin(), values.end());
+        size_t index = static_cast<size_t>(p * (values.size() - 1));
+        return values[index];
+    }
+
+    void report(const std::string& label, const std::vector<double>& latencies_ms, double seconds) {
+        std::cout << label << ": " << latencies_ms.size() << " requests in " << seconds << " s ("
+                  << (latencies_ms.size() / seconds) << " req/s), p50 "
+                  << percentile(latencies_ms, 0.5) << " ms, p99 "
+                  << percentile(latencies_ms, 0.99) << " ms" << std::endl;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <base-url> [requests] [symbols...]" << std::endl;
+        return 1;
+    }
+
+    std::string base_url = argv[1];
+    int requests = argc > 2 ? std::atoi(argv[2]) : 100;
+    std::vector<std::string> symbols;
+    for (int i = 3; i < argc; ++i) {
+        symbols.push_back(argv[i]);
+    }
+    if (symbols.empty()) {
+        symbols = {"AAPL", "MSFT", "GOOGL"};
+    }
+
+    try {
+        auto session = std::make_shared<yfinance::YfData>();
+        session->set_cookie_cache(nullptr);
+        if (base_url.find("finance.yahoo.com") == std::string::npos) {
+            session->set_base_url(base_url);
+            session->set_cookie_url(base_url + "/");
+        }
+        // Measure every round-trip rather than shared ones
+        session->set_coalescing(false);
+
+        std::vector<yfinance::Ticker> tickers;
+        for (const auto& symbol : symbols) {
+            tickers.emplace_back(symbol, session);
+        }
+        session->ensure_session();
+
+        // Blocking: one request at a time
+        std::vector<double> latencies;
+        auto start = Clock::now();
+        for (int i = 0; i < requests; ++i) {
+            auto request_start = Clock::now();
+            tickers[i % tickers.size()].history(30, "1d");
+            latencies.push_back(std::chrono::duration<double, std::milli>(Clock::now() - request_start).count());
+        }
+        report("history()      ", latencies, std::chrono::duration<double>(Clock::now() - start).count());
+
+        // Async: all requests in flight on the shared loop
+        latencies.clear();
+        start = Clock::now();
+        std::vector<std::future<nlohmann::json>> pending;
+        for (int i = 0; i < requests; ++i) {
+            pending.push_back(tickers[i % tickers.size()].history_async(30, "1d"));
+        }
+        for (auto& future : pending) {
+            future.get();
+            latencies.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        }
+        report("history_async()", latencies, std::chrono::duration<double>(Clock::now() - start).count());
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,146 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+#include <curl/curl.h>
+
+#include "http_client.h"
+#include "buffer_pool.h"
+#include "json_parser.h"
+#include "allocation_counter.h"
+
+// Counts heap allocations made while receiving 1-20 MB responses: a fresh
+// std::string grown chunk by chunk (what HttpClient used to do) against a
+// pooled buffer pre-sized from Content-Length and parsed in place.
+//
+// Usage: bench_response_buffers [url ...]
+// Without arguments the transfer is simulated in memory with libcurl-sized
+// chunks. Each url (e.g. large chart payloads served by a local server) is
+// additionally fetched for real with both strategies.
+
+namespace {
+
+    // libcurl hands the body over in pieces of at most CURL_MAX_WRITE_SIZE
+    constexpr size_t kChunkSize = CURL_MAX_WRITE_SIZE;
+    constexpr int kIterations = 10;
+
+    std::string make_payload(size_t target_size) {
+        // Shaped like a chart response: long arrays of numbers
+        std::string payload = "{\"close\":[";
+        size_t i = 0;
+        while (payload.size() + 32 < target_size) {
+            if (i++ > 0) {
+                payload += ',';
+            }
+            payload += std::to_string(100.0 + (i % 1000) * 0.0625);
+        }
+        payload += "]}";
+        return payload;
+    }
+
+    void report(const std::string& label, const bench::AllocationCount& count, double seconds) {
+        std::cout << "  " << label << ": "
+                  << (static_cast<double>(count.allocations) / kIterations) << " allocations, "
+                  << (count.bytes / kIterations / 1024) << " KiB allocated per response, "
+                  << (seconds / kIterations * 1000.0) << " ms" << std::endl;
+    }
+
+    void run_simulated(size_t megabytes) {
+        std::string payload = make_payload(megabytes * 1024 * 1024);
+        std::cout << "Simulated " << megabytes << " MB response" << std::endl;
+
+        auto start_count = bench::allocation_count();
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kIterations; ++i) {
+            std::string response;
+            for (size_t offset = 0; offset < payload.size(); offset += kChunkSize) {
+                response.append(payload, offset, kChunkSize);
+            }
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        report("fresh string ", bench::allocations_since(start_count), elapsed.count());
+
+        start_count = bench::allocation_count();
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kIterations; ++i) {
+            yfinance::ResponseBuffer response = yfinance::BufferPool::instance().acquire(payload.size());
+            for (size_t offset = 0; offset < payload.size(); offset += kChunkSize) {
+                response.append(payload.data() + offset, std::min(kChunkSize, payload.size() - offset));
+            }
+        }
+        elapsed = std::chrono::steady_clock::now() - start;
+        report("pooled buffer", bench::allocations_since(start_count), elapsed.count());
+
+        // The parser reads the buffer in place instead of from a copy
+        yfinance::ResponseBuffer response = yfinance::BufferPool::instance().acquire(payload.size());
+        response.append(payload.data(), payload.size());
+        start_count = bench::allocation_count();
+        auto parsed = yfinance::JsonParser::parse(response.data(), response.size());
+        auto parse_count = bench::allocations_since(start_count);
+        std::cout << "  parse in place: " << parse_count.allocations << " allocations ("
+                  << parsed["close"].size() << " values)" << std::endl;
+    }
+
+    size_t append_body(void* contents, size_t size, size_t nmemb, void* userp) {
+        static_cast<std::string*>(userp)->append(static_cast<const char*>(contents), size * nmemb);
+        return size * nmemb;
+    }
+
+    void run_network(const std::string& url) {
+        std::cout << "Fetching " << url << std::endl;
+
+        CURL* curl = curl_easy_init();
+        auto start_count = bench::allocation_count();
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kIterations; ++i) {
+            std::string response;
+            curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, append_body);
+            curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
+            CURLcode res = curl_easy_perform(curl);
+            if (res != CURLE_OK) {
+                curl_easy_cleanup(curl);
+                throw std::runtime_error(std::string("Request failed: ") + curl_easy_strerror(res));
+            }
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        curl_easy_cleanup(curl);
+        report("fresh string ", bench::allocations_since(start_count), elapsed.count());
+
+        yfinance::HttpClient client;
+        client.set_retries(0);
+        client.get_buffer(url);  // Warm up the handle and buffer pools
+
+        start_count = bench::allocation_count();
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kIterations; ++i) {
+            yfinance::ResponseBuffer response = client.get_buffer(url);
+        }
+        elapsed = std::chrono::steady_clock::now() - start;
+        report("pooled buffer", bench::allocations_since(start_count), elapsed.count());
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        for (size_t megabytes : {1, 5, 10, 20}) {
+            run_simulated(megabytes);
+        }
+
+        for (int i = 1; i < argc; ++i) {
+            run_network(argv[i]);
+        }
+
+        auto stats = yfinance::BufferPool::instance().stats();
+        std::cout << "Buffer pool: " << stats.reused << " of " << stats.acquired
+                  << " buffers reused" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
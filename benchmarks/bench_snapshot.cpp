@@ -0,0 +1,117 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+
+#include <nlohmann/json.hpp>
+
+#include "json_parser.h"
+#include "snapshot_store.h"
+
+// Warm-start reload of cached documents: JSON text files parsed with
+// JsonParser versus CBOR and MessagePack snapshots loaded from a
+// SnapshotStore. Every document is written to disk first and then read back
+// once per format, so the numbers include the file reads.
+//
+// Usage: bench_snapshot [documents] [payload-file ...]
+// Payloads are the .body files of a fixture directory; without them a
+// synthetic one-year daily chart is used.
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    std::string read_file(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("Cannot open " + path);
+        }
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    }
+
+    std::string synthetic_chart(size_t bars) {
+        std::string timestamps, quote;
+        for (const char* column : {"open", "high", "low", "close", "volume"}) {
+            quote += std::string(quote.empty() ? "" : ",") + "\"" + column + "\":[";
+            for (size_t i = 0; i < bars; ++i) {
+                quote += (i ? "," : "") + std::to_string(100.0 + (i % 977) * 0.125);
+            }
+            quote += "]";
+        }
+        for (size_t i = 0; i < bars; ++i) {
+            timestamps += (i ? "," : "") + std::to_string(1262615400 + static_cast<int64_t>(i) * 86400);
+        }
+        return "{\"chart\":{\"result\":[{\"meta\":{\"symbol\":\"AAPL\",\"gmtoffset\":-18000},"
+               "\"timestamp\":[" + timestamps + "],\"indicators\":{\"quote\":[{" + quote + "}]}}],"
+               "\"error\":null}}";
+    }
+
+    template <typename Load>
+    void measure(const std::string& label, size_t documents, size_t bytes, Load load) {
+        auto start = Clock::now();
+        size_t checksum = 0;
+        for (size_t i = 0; i < documents; ++i) {
+            checksum += load(i);
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        std::cout << "  " << label << ": " << (documents / seconds) << " docs/s, "
+                  << (bytes / documents) << " bytes per document (checksum " << checksum << ")" << std::endl;
+    }
+
+    void run(const std::string& name, const std::string& payload, size_t documents, const std::string& directory) {
+        std::cout << name << " (" << payload.size() << " bytes of JSON), " << documents << " documents" << std::endl;
+
+        nlohmann::json document = yfinance::JsonParser::parse(payload);
+        yfinance::SnapshotStore cbor(directory + "/cbor", yfinance::SnapshotStore::Format::Cbor);
+        yfinance::SnapshotStore msgpack(directory + "/msgpack", yfinance::SnapshotStore::Format::MessagePack);
+        std::filesystem::create_directories(directory + "/json");
+
+        for (size_t i = 0; i < documents; ++i) {
+            std::string key = "doc" + std::to_string(i);
+            std::ofstream(directory + "/json/" + key + ".json", std::ios::binary) << payload;
+            cbor.save(key, document);
+            msgpack.save(key, document);
+        }
+
+        size_t cbor_bytes = yfinance::SnapshotStore::encode(document, cbor.format(), 0).size() * documents;
+        size_t msgpack_bytes = yfinance::SnapshotStore::encode(document, msgpack.format(), 0).size() * documents;
+
+        measure("JSON text  ", documents, payload.size() * documents, [&](size_t i) {
+            return yfinance::JsonParser::parse(read_file(directory + "/json/doc" + std::to_string(i) + ".json")).size();
+        });
+        measure("CBOR       ", documents, cbor_bytes, [&](size_t i) {
+            return cbor.load("doc" + std::to_string(i))->document.size();
+        });
+        measure("MessagePack", documents, msgpack_bytes, [&](size_t i) {
+            return msgpack.load("doc" + std::to_string(i))->document.size();
+        });
+
+        std::filesystem::remove_all(directory);
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        size_t documents = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 2000;
+        std::string directory = (std::filesystem::temp_directory_path() / "bench_snapshot").string();
+
+        if (argc < 3) {
+            run("synthetic 1y 1d chart", synthetic_chart(252), documents, directory);
+        }
+        for (int i = 2; i < argc; ++i) {
+            run(argv[i], read_file(argv[i]), documents, directory);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+
+#include "chart_decoder.h"
+#include "fixture_store.h"
+#include "yf_data.h"
+
+// End-to-end latency of a large chart request decoded after the download
+// (get_raw_buffer + ChartDecoder) versus while it downloads (get_raw_streamed),
+// against a bandwidth-limited replay_server.
+//
+// Write a synthetic 60d/1m AAPL chart fixture, then serve and measure it:
+//   bench_streaming --write-fixture fixtures
+//   replay_server fixtures --port 8080 --bandwidth 20000000 &
+//   bench_streaming http://127.0.0.1:8080 20
+//
+// Usage: bench_streaming <base-url> [requests]
+//        bench_streaming --write-fixture <directory>
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    const char* const kPath = "/v8/finance/chart/AAPL";
+
+    // Same parameters as Ticker::history(60, "1m")
+    const std::map<std::string, std::string> kParams = {
+        {"period", "60d"}, {"interval", "1m"}, {"events", "div,splits"}};
+
+    std::string synthetic_chart(size_t bars) {
+        std::string timestamps, quote;
+        for (const char* column : {"open", "high", "low", "close", "volume"}) {
+            quote += std::string(quote.empty() ? "" : ",") + "\"" + column + "\":[";
+            for (size_t i = 0; i < bars; ++i) {
+                quote += (i ? "," : "") + std::to_string(100.0 + (i % 977) * 0.125);
+            }
+            quote += "]";
+        }
+        for (size_t i = 0; i < bars; ++i) {
+            timestamps += (i ? "," : "") + std::to_string(1262615400 + static_cast<int64_t>(i) * 60);
+        }
+        return "{\"chart\":{\"result\":[{\"meta\":{\"symbol\":\"AAPL\",\"gmtoffset\":-18000},"
+               "\"timestamp\":[" + timestamps + "],\"indicators\":{\"quote\":[{" + quote + "}]}}],"
+               "\"error\":null}}";
+    }
+
+    void write_fixtures(const std::string& directory) {
+        yfinance::FixtureStore store(directory);
+        store.save("GET", "/", {200, "text/plain", "ok"});
+        store.save("GET", "/v1/test/getcrumb", {200, "text/plain", "crumb"});
+
+        std::string url = std::string(kPath) + "?events=div%2Csplits&interval=1m&period=60d&symbol=AAPL";
+        std::string body = synthetic_chart(60 * 390);
+        store.save("GET", url, {200, "application/json", body});
+        std::cout << "Wrote " << (body.size() / 1024) << " KiB chart fixture to " << directory << std::endl;
+    }
+
+    double percentile(std::vector<double> values, double p) {
+        if (values.empty()) {
+            return 0.0;
+        }
+        std::sort(values.begin(), values.end());
+        size_t index = static_cast<size_t>(p * (values.size() - 1));
+        return values[index];
+    }
+
+    template <typename Fetch>
+    void measure(const std::string& label, int requests, Fetch fetch) {
+        std::vector<double> latencies;
+        size_t bars = 0;
+        for (int i = 0; i < requests; ++i) {
+            auto start = Clock::now();
+            bars = fetch().size();
+            latencies.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        }
+        std::cout << label << ": " << bars << " bars, p50 " << percentile(latencies, 0.5)
+                  << " ms, p99 " << percentile(latencies, 0.99) << " ms" << std::endl;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <base-url> [requests]" << std::endl
+                  << "       " << argv[0] << " --write-fixture <directory>" << std::endl;
+        return 1;
+    }
+
+    try {
+        if (std::string(argv[1]) == "--write-fixture") {
+            write_fixtures(argc > 2 ? argv[2] : "fixtures");
+            return 0;
+        }
+
+        std::string base_url = argv[1];
+        int requests = argc > 2 ? std::atoi(argv[2]) : 20;
+
+        auto session = std::make_shared<yfinance::YfData>();
+        session->set_cookie_cache(nullptr);
+        session->set_base_url(base_url);
+        session->set_cookie_url(base_url + "/");
+        session->ensure_session();
+
+        measure("decode after download", requests, [&] {
+            auto response = session->get_raw_buffer("AAPL", kPath, kParams);
+            return yfinance::ChartDecoder::decode(response.data(), response.size());
+        });
+        measure("decode while streaming", requests, [&] {
+            yfinance::PriceHistory history;
+            session->get_raw_streamed("AAPL", kPath, kParams, [&history](std::istream& input) {
+                history = yfinance::ChartDecoder::decode(input);
+            });
+            return history;
+        });
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -33,25 +33,17 @@ int main() {
             std::cout << "Current/Previous Close: Not found" << std::endl;
         }
         
-        // Get historical data
-        auto history = ko.history(5, "1d");
+        // Get historical data, decoded straight into typed columns
+        auto history = ko.history_prices(5, "1d");
         std::cout << "Historical data retrieved successfully!" << std::endl;
-        if (history.contains("chart") && history["chart"].contains("result") && 
-            !history["chart"]["result"].empty()) {
-            auto result = history["chart"]["result"][0];
-            if (result.contains("indicators") && result["indicators"].contains("quote") &&
-                !result["indicators"]["quote"].empty()) {
-                auto quotes = result["indicators"]["quote"][0];
-                if (quotes.contains("close") && !quotes["close"].empty()) {
-                    std::cout << "Latest closing prices: ";
-                    // Print last 3 closing prices
-                    int count = 0;
-                    for (auto it = quotes["close"].rbegin(); it != quotes["close"].rend() && count < 3; ++it, ++count) {
-                        std::cout << "$" << *it << " ";
-                    }
-                    std::cout << std::endl;
-                }
+        if (!history.close.empty()) {
+            std::cout << "Latest closing prices: ";
+            // Print last 3 closing prices
+            int count = 0;
+            for (auto it = history.close.rbegin(); it != history.close.rend() && count < 3; ++it, ++count) {
+                std::cout << "$" << *it << " ";
             }
+            std::cout << std::endl;
         }
         
         std::cout << std::endl << "=== Testing with Altria (MO) ===" << std::endl;
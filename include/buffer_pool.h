@@ -0,0 +1,100 @@
+#ifndef BUFFER_POOL_H
+#define BUFFER_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace yfinance {
+
+    /**
+     * @brief Response body buffer whose storage is recycled by the BufferPool
+     *
+     * Move-only. When it is destroyed its storage goes back to the pool, so the
+     * next response of a similar size is received without any reallocation.
+     */
+    class ResponseBuffer {
+    public:
+        ResponseBuffer() = default;
+
+        // Adopt existing bytes (they join the pool once the buffer is dropped)
+        explicit ResponseBuffer(std::string bytes) : bytes_(std::move(bytes)) {}
+
+        ~ResponseBuffer();
+
+        ResponseBuffer(ResponseBuffer&& other) noexcept = default;
+        ResponseBuffer& operator=(ResponseBuffer&& other) noexcept;
+
+        ResponseBuffer(const ResponseBuffer&) = delete;
+        ResponseBuffer& operator=(const ResponseBuffer&) = delete;
+
+        void reserve(size_t size) { bytes_.reserve(size); }
+        void append(const char* data, size_t size) { bytes_.append(data, size); }
+        void clear() { bytes_.clear(); }
+
+        const char* data() const { return bytes_.data(); }
+        size_t size() const { return bytes_.size(); }
+        size_t capacity() const { return bytes_.capacity(); }
+        bool empty() const { return bytes_.empty(); }
+
+        // Take the bytes out as a string; the storage then leaves the pool
+        std::string release();
+
+    private:
+        std::string bytes_;
+    };
+
+    /**
+     * @brief Process-wide pool of response buffers
+     *
+     * Buffers are handed out pre-reserved for the expected size (typically the
+     * response's Content-Length) and returned with their capacity intact.
+     */
+    class BufferPool {
+    public:
+        struct Stats {
+            uint64_t acquired = 0;  // Buffers handed out
+            uint64_t reused = 0;    // ... of which came from the pool
+        };
+
+        // Get the process-wide pool
+        static BufferPool& instance();
+
+        BufferPool(const BufferPool&) = delete;
+        BufferPool& operator=(const BufferPool&) = delete;
+
+        // Borrow an empty buffer with at least size_hint bytes reserved
+        ResponseBuffer acquire(size_t size_hint = 0);
+
+        // Return storage to the pool (called by ResponseBuffer)
+        void release(std::string&& storage);
+
+        // Maximum number of idle buffers kept around for reuse
+        void set_max_idle(size_t max_idle);
+
+        // Buffers with a larger capacity are freed rather than pooled
+        void set_max_buffer_size(size_t bytes);
+
+        size_t idle_count() const;
+        Stats stats() const;
+
+    private:
+        BufferPool() : max_idle_(16), max_buffer_size_(64 * 1024 * 1024) {}
+
+        static constexpr size_t kMinPooledCapacity = 4096;
+
+        mutable std::mutex mutex_;
+        std::vector<std::string> idle_;
+        size_t max_idle_;
+        size_t max_buffer_size_;
+
+        std::atomic<uint64_t> acquired_{0};
+        std::atomic<uint64_t> reused_{0};
+    };
+
+} // namespace yfinance
+
+#endif // BUFFER_POOL_H
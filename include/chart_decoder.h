@@ -0,0 +1,33 @@
+#ifndef CHART_DECODER_H
+#define CHART_DECODER_H
+
+#include <istream>
+#include <string>
+
+#include "data_structures.h"
+
+namespace yfinance {
+
+    /**
+     * @brief Streaming decoder for /v8/finance/chart responses
+     *
+     * Parses the payload with SAX callbacks straight into a columnar
+     * PriceHistory, without building a JSON DOM: numbers go directly into
+     * the matching column and everything the history does not need is
+     * skipped. Only the first chart result is decoded.
+     */
+    class ChartDecoder {
+    public:
+        // Decode a chart payload; throws std::runtime_error on malformed JSON
+        // or when Yahoo reports an error instead of a result
+        static PriceHistory decode(const char* data, size_t size);
+        static PriceHistory decode(const std::string& payload);
+
+        // Decode from a stream as it is read, e.g. a StreamingParser fed by a
+        // running transfer (with USE_SIMDJSON the stream is read to the end first)
+        static PriceHistory decode(std::istream& input);
+    };
+
+} // namespace yfinance
+
+#endif // CHART_DECODER_H
@@ -0,0 +1,93 @@
+#ifndef CONNECTION_POOL_H
+#define CONNECTION_POOL_H
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include <curl/curl.h>
+
+namespace yfinance {
+
+    /**
+     * @brief Process-wide pool of libcurl easy handles
+     *
+     * Every handle handed out by the pool is attached to a single curl_share
+     * object holding the DNS cache, the TLS session cache and the connection
+     * cache, so a keep-alive connection opened by one HttpClient can be reused
+     * by any other HttpClient in the process.
+     *
+     * Handles driven by the RequestLoop use a second share object without the
+     * connection cache: the loop's multi handle keeps its own connection cache,
+     * which is what HTTP/2 multiplexing needs.
+     */
+    class ConnectionPool {
+    public:
+        // Get the process-wide pool
+        static ConnectionPool& instance();
+
+        ConnectionPool(const ConnectionPool&) = delete;
+        ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+        // Borrow an easy handle (creates a new one if none is idle)
+        CURL* acquire();
+
+        // Return a handle to the pool; it is cleaned up if the pool is full
+        void release(CURL* handle);
+
+        // Maximum number of idle handles kept around for reuse
+        void set_max_idle(size_t max_idle);
+
+        // Number of handles currently idle in the pool
+        size_t idle_count() const;
+
+        // Share object for blocking transfers (DNS, TLS sessions, connections)
+        CURLSH* share() const { return share_; }
+
+        // Share object for transfers run by the RequestLoop (DNS, TLS sessions)
+        CURLSH* async_share() const { return async_share_; }
+
+    private:
+        ConnectionPool();
+        ~ConnectionPool();
+
+        CURLSH* share_;
+        CURLSH* async_share_;
+        std::mutex share_locks_[CURL_LOCK_DATA_LAST];
+
+        mutable std::mutex mutex_;
+        std::vector<CURL*> idle_;
+        size_t max_idle_;
+
+        CURLSH* create_share(bool share_connections);
+
+        // Lock callbacks required by libcurl for a thread-safe share object
+        static void lock_share(CURL* handle, curl_lock_data data, curl_lock_access access, void* userptr);
+        static void unlock_share(CURL* handle, curl_lock_data data, void* userptr);
+    };
+
+    /**
+     * @brief RAII lease of a pooled easy handle
+     */
+    class PooledHandle {
+    public:
+        PooledHandle() : handle_(ConnectionPool::instance().acquire()) {}
+        ~PooledHandle() {
+            if (handle_) {
+                ConnectionPool::instance().release(handle_);
+            }
+        }
+
+        PooledHandle(const PooledHandle&) = delete;
+        PooledHandle& operator=(const PooledHandle&) = delete;
+
+        CURL* get() const { return handle_; }
+        explicit operator bool() const { return handle_ != nullptr; }
+
+    private:
+        CURL* handle_;
+    };
+
+} // namespace yfinance
+
+#endif // CONNECTION_POOL_H
@@ -0,0 +1,60 @@
+#ifndef COOKIE_CACHE_H
+#define COOKIE_CACHE_H
+
+#include <string>
+#include <ctime>
+#include <optional>
+
+namespace yfinance {
+
+    /**
+     * @brief Persistent on-disk cache for the Yahoo cookie and crumb
+     *
+     * C++ counterpart of the Python _CookieCache. Each strategy is stored in
+     * its own small JSON file under the cache directory. Writers hold an
+     * exclusive flock on a lock file and replace the entry with an atomic
+     * rename, so concurrent processes never observe a partially written entry.
+     */
+    class CookieCache {
+    public:
+        struct Entry {
+            std::string cookie;      // Cookie header value
+            std::string crumb;       // Crumb token bound to the cookie
+            std::time_t fetch_time;  // When the handshake was performed
+            std::time_t expires;     // When the entry stops being valid
+        };
+
+        // Use the default location (see default_location())
+        CookieCache();
+
+        // Use a custom cache directory
+        explicit CookieCache(const std::string& cache_dir);
+
+        // $XDG_CACHE_HOME/yfinance-cpp, falling back to ~/.cache/yfinance-cpp
+        static std::string default_location();
+
+        // Get the cache directory
+        const std::string& get_location() const { return cache_dir_; }
+
+        // Look up an unexpired entry for the strategy
+        std::optional<Entry> lookup(const std::string& strategy) const;
+
+        // Store an entry, replacing any previous one; returns false on I/O failure
+        bool store(const std::string& strategy, const Entry& entry);
+
+        // Remove the entry for the strategy (e.g. after Yahoo rejected the crumb)
+        void remove(const std::string& strategy);
+
+    private:
+        std::string cache_dir_;
+
+        std::string entry_path(const std::string& strategy) const;
+        std::string lock_path() const;
+
+        // Create the cache directory if needed; returns false if unusable
+        bool ensure_directory() const;
+    };
+
+} // namespace yfinance
+
+#endif // COOKIE_CACHE_H
@@ -5,134 +5,275 @@
 #include <string>
 #include <map>
 #include <memory>
-#include <variant>
 #include <optional>
 #include <stdexcept>
+#include <cstdint>
+#include <limits>
+#include <utility>
 
 namespace yfinance {
 
-    // Variant type to hold different data types (similar to pandas flexibility)
-    using DataValue = std::variant<int, double, std::string, bool>;
-    
-    // Column data structure to mimic pandas DataFrame columns
-    struct DataColumn {
-        std::string name;
-        std::vector<DataValue> values;
-        
-        DataColumn(const std::string& col_name) : name(col_name) {}
-        
-        void add_value(const DataValue& val) {
-            values.push_back(val);
-        }
-        
-        size_t size() const {
-            return values.size();
-        }
-        
-        DataValue operator[](size_t index) const {
-            if (index >= values.size()) {
-                throw std::out_of_range("Index out of range for DataColumn");
-            }
-            return values[index];
-        }
+    // Chart metadata returned alongside historical prices
+    struct ChartMeta {
+        std::string currency;
+        std::string symbol;
+        std::string exchange_name;
+        std::string instrument_type;
+        std::string timezone;                // Exchange timezone abbreviation, e.g. "EST"
+        std::string exchange_timezone_name;  // IANA name, e.g. "America/New_York"
+        int64_t gmtoffset = 0;               // Exchange offset from UTC in seconds
+        int64_t first_trade_date = 0;
+        int64_t regular_market_time = 0;
+        double regular_market_price = 0.0;
+        double chart_previous_close = 0.0;
+        int price_hint = 0;
+        std::string data_granularity;
+        std::string range;
     };
-    
-    // DataFrame structure to mimic pandas DataFrame
-    class DataFrame {
-    private:
-        std::vector<std::string> column_names_;
-        std::vector<std::unique_ptr<DataColumn>> columns_;
-        size_t num_rows_;
-        
-    public:
-        DataFrame() : num_rows_(0) {}
-        
-        // Add a column to the DataFrame
-        void add_column(const std::string& name) {
-            column_names_.push_back(name);
-            columns_.push_back(std::make_unique<DataColumn>(name));
-        }
-        
-        // Get a column by name
-        DataColumn* get_column(const std::string& name) {
-            for (auto& col : columns_) {
-                if (col->name == name) {
-                    return col.get();
-                }
-            }
-            return nullptr; // Column not found
-        }
-        
-        // Add a row of data
-        template<typename... Args>
-        void add_row(Args&&... values) {
-            std::vector<DataValue> row_values = {values...};
-            
-            if (row_values.size() != columns_.size()) {
-                throw std::invalid_argument("Number of values does not match number of columns");
-            }
-            
-            for (size_t i = 0; i < row_values.size(); ++i) {
-                columns_[i]->add_value(row_values[i]);
-            }
-            
-            num_rows_++;
-        }
-        
-        // Get number of rows
-        size_t rows() const {
-            return num_rows_;
-        }
-        
-        // Get number of columns
-        size_t cols() const {
-            return column_names_.size();
-        }
-        
-        // Get column names
-        const std::vector<std::string>& get_column_names() const {
-            return column_names_;
-        }
-        
-        // Get a row as a map of column name to value
-        std::map<std::string, DataValue> get_row(size_t index) const {
-            if (index >= num_rows_) {
-                throw std::out_of_range("Row index out of range");
-            }
-            
-            std::map<std::string, DataValue> row;
-            for (const auto& col : columns_) {
-                row[col->name] = (*col)[index];
-            }
-            return row;
-        }
-        
-        // Print the DataFrame (for debugging)
-        void print() const;
+
+    // Dividend paid on a given date (seconds since the epoch)
+    struct DividendEvent {
+        int64_t date = 0;
+        double amount = 0.0;
     };
-    
-    // Specific data structure for holding historical stock prices
+
+    // Stock split on a given date (seconds since the epoch)
+    struct SplitEvent {
+        int64_t date = 0;
+        double numerator = 0.0;
+        double denominator = 0.0;
+        std::string ratio;  // e.g. "4:1"
+    };
+
+    // Specific data structure for holding historical stock prices, one
+    // column per field; missing values are NaN. Bars are keyed by their
+    // int64 epoch timestamps in ascending order, so time lookups are binary
+    // searches; strings are produced only by format_time().
     struct PriceHistory {
+        std::vector<int64_t> timestamp;  // Bar start, seconds since the epoch (UTC)
         std::vector<double> open;
         std::vector<double> high;
         std::vector<double> low;
         std::vector<double> close;
+        std::vector<double> adjclose;    // Empty when the response has no adjusted close
         std::vector<double> volume;
-        std::vector<std::string> date;  // ISO 8601 date strings
+
+        std::vector<DividendEvent> dividends;
+        std::vector<SplitEvent> splits;
+        ChartMeta meta;
         
         // Add a price entry
-        void add_entry(double o, double h, double l, double c, double vol, const std::string& d) {
+        void add_entry(int64_t ts, double o, double h, double l, double c, double vol) {
+            timestamp.push_back(ts);
             open.push_back(o);
             high.push_back(h);
             low.push_back(l);
             close.push_back(c);
             volume.push_back(vol);
-            date.push_back(d);
         }
         
         // Get number of entries
         size_t size() const {
-            return open.size();
+            return timestamp.size();
+        }
+
+        // Index of the first bar at or after t (size() if there is none)
+        size_t lower_bound(int64_t t) const;
+
+        // Index of the bar in effect at t: the last one starting at or
+        // before t (nullopt if t precedes every bar)
+        std::optional<size_t> asof(int64_t t) const;
+
+        // Index range [first, last) of the bars with start <= timestamp < end,
+        // for reading the columns in place
+        std::pair<size_t, size_t> index_range(int64_t start, int64_t end) const;
+
+        // Bars with start <= timestamp < end, with the dividends and splits
+        // in that range and the same meta
+        PriceHistory between(int64_t start, int64_t end) const;
+
+        // Start of a bar in exchange time (UTC shifted by meta.gmtoffset)
+        std::string format_time(size_t index, const std::string& format = "%Y-%m-%d %H:%M:%S") const;
+    };
+
+    // Value of numeric quoteSummary fields absent from the response
+    inline constexpr double kMissingValue = std::numeric_limits<double>::quiet_NaN();
+
+    // Typed quoteSummary modules. Only the "raw" value of each field is kept
+    // (no "fmt"/"longFmt" strings); missing doubles are NaN, missing integers
+    // (counts, dates in seconds since the epoch) are 0.
+
+    // "financialData" module
+    struct FinancialData {
+        double current_price = kMissingValue;
+        double target_high_price = kMissingValue;
+        double target_low_price = kMissingValue;
+        double target_mean_price = kMissingValue;
+        double target_median_price = kMissingValue;
+        double recommendation_mean = kMissingValue;
+        int64_t number_of_analyst_opinions = 0;
+        double total_cash = kMissingValue;
+        double total_cash_per_share = kMissingValue;
+        double ebitda = kMissingValue;
+        double total_debt = kMissingValue;
+        double quick_ratio = kMissingValue;
+        double current_ratio = kMissingValue;
+        double total_revenue = kMissingValue;
+        double debt_to_equity = kMissingValue;
+        double revenue_per_share = kMissingValue;
+        double return_on_assets = kMissingValue;
+        double return_on_equity = kMissingValue;
+        double gross_profits = kMissingValue;
+        double free_cashflow = kMissingValue;
+        double operating_cashflow = kMissingValue;
+        double earnings_growth = kMissingValue;
+        double revenue_growth = kMissingValue;
+        double gross_margins = kMissingValue;
+        double ebitda_margins = kMissingValue;
+        double operating_margins = kMissingValue;
+        double profit_margins = kMissingValue;
+        std::string recommendation_key;
+        std::string financial_currency;
+    };
+
+    // "summaryDetail" module
+    struct SummaryDetail {
+        double previous_close = kMissingValue;
+        double open = kMissingValue;
+        double day_low = kMissingValue;
+        double day_high = kMissingValue;
+        double regular_market_previous_close = kMissingValue;
+        double regular_market_open = kMissingValue;
+        double regular_market_day_low = kMissingValue;
+        double regular_market_day_high = kMissingValue;
+        double dividend_rate = kMissingValue;
+        double dividend_yield = kMissingValue;
+        int64_t ex_dividend_date = 0;
+        double payout_ratio = kMissingValue;
+        double five_year_avg_dividend_yield = kMissingValue;
+        double beta = kMissingValue;
+        double trailing_pe = kMissingValue;
+        double forward_pe = kMissingValue;
+        int64_t volume = 0;
+        int64_t regular_market_volume = 0;
+        int64_t average_volume = 0;
+        int64_t average_volume_10days = 0;
+        double bid = kMissingValue;
+        double ask = kMissingValue;
+        int64_t bid_size = 0;
+        int64_t ask_size = 0;
+        int64_t market_cap = 0;
+        double fifty_two_week_low = kMissingValue;
+        double fifty_two_week_high = kMissingValue;
+        double price_to_sales_trailing_12_months = kMissingValue;
+        double fifty_day_average = kMissingValue;
+        double two_hundred_day_average = kMissingValue;
+        double trailing_annual_dividend_rate = kMissingValue;
+        double trailing_annual_dividend_yield = kMissingValue;
+        std::string currency;
+    };
+
+    // "defaultKeyStatistics" module
+    struct DefaultKeyStatistics {
+        int64_t enterprise_value = 0;
+        double forward_pe = kMissingValue;
+        double profit_margins = kMissingValue;
+        int64_t float_shares = 0;
+        int64_t shares_outstanding = 0;
+        int64_t shares_short = 0;
+        double short_ratio = kMissingValue;
+        double short_percent_of_float = kMissingValue;
+        double held_percent_insiders = kMissingValue;
+        double held_percent_institutions = kMissingValue;
+        double beta = kMissingValue;
+        double book_value = kMissingValue;
+        double price_to_book = kMissingValue;
+        int64_t last_fiscal_year_end = 0;
+        int64_t next_fiscal_year_end = 0;
+        int64_t most_recent_quarter = 0;
+        int64_t net_income_to_common = 0;
+        double trailing_eps = kMissingValue;
+        double forward_eps = kMissingValue;
+        double peg_ratio = kMissingValue;
+        double enterprise_to_revenue = kMissingValue;
+        double enterprise_to_ebitda = kMissingValue;
+        double fifty_two_week_change = kMissingValue;
+        double sandp_fifty_two_week_change = kMissingValue;
+        int64_t last_split_date = 0;
+        double last_dividend_value = kMissingValue;
+        int64_t last_dividend_date = 0;
+        std::string last_split_factor;  // e.g. "4:1"
+    };
+
+    // "price" module
+    struct QuotePrice {
+        double regular_market_price = kMissingValue;
+        double regular_market_change = kMissingValue;
+        double regular_market_change_percent = kMissingValue;
+        double regular_market_day_high = kMissingValue;
+        double regular_market_day_low = kMissingValue;
+        double regular_market_open = kMissingValue;
+        double regular_market_previous_close = kMissingValue;
+        int64_t regular_market_time = 0;
+        int64_t regular_market_volume = 0;
+        double pre_market_price = kMissingValue;
+        double post_market_price = kMissingValue;
+        int64_t market_cap = 0;
+        std::string symbol;
+        std::string short_name;
+        std::string long_name;
+        std::string exchange;
+        std::string exchange_name;
+        std::string quote_type;
+        std::string currency;
+        std::string market_state;
+    };
+
+    // The typed modules of one symbol's quoteSummary
+    struct QuoteSummary {
+        FinancialData financial_data;
+        SummaryDetail summary_detail;
+        DefaultKeyStatistics key_statistics;
+        QuotePrice price;
+    };
+
+    // Option contracts from /v7/finance/options, one column per field so
+    // numeric work over a chain runs over flat arrays. Calls and puts of every
+    // expiration in the response share the columns and are told apart by
+    // is_call; missing doubles are NaN, missing integers are 0.
+    struct OptionChain {
+        std::string underlying_symbol;
+        double underlying_price = kMissingValue;
+        std::vector<int64_t> expiration_dates;  // Every listed expiration (seconds since the epoch)
+        std::vector<double> strikes;            // Every listed strike
+
+        std::vector<std::string> contract_symbol;
+        std::vector<double> strike;
+        std::vector<double> last_price;
+        std::vector<double> bid;
+        std::vector<double> ask;
+        std::vector<double> change;
+        std::vector<double> percent_change;
+        std::vector<int64_t> volume;
+        std::vector<int64_t> open_interest;
+        std::vector<double> implied_volatility;
+        std::vector<int64_t> expiration;        // Seconds since the epoch
+        std::vector<int64_t> last_trade_date;   // Seconds since the epoch
+        std::vector<uint8_t> is_call;           // 1 for calls, 0 for puts
+        std::vector<uint8_t> in_the_money;
+
+        // Get number of contracts
+        size_t size() const {
+            return strike.size();
+        }
+
+        // Number of calls (the rest are puts)
+        size_t call_count() const {
+            size_t count = 0;
+            for (uint8_t call : is_call) {
+                count += call;
+            }
+            return count;
         }
     };
 
@@ -0,0 +1,448 @@
+#ifndef DATAFRAME_H
+#define DATAFRAME_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "data_structures.h"
+#include "span.h"
+
+namespace yfinance {
+
+    // Alignment of every column buffer, enough for 512-bit vector loads
+    inline constexpr size_t kColumnAlignment = 64;
+
+    /**
+     * @brief Growable byte buffer aligned to kColumnAlignment
+     *
+     * Storage behind columns and validity bitmaps. Capacity grows
+     * geometrically and is always a multiple of the alignment, so a vector
+     * loop may read a whole final block without leaving the allocation.
+     */
+    class AlignedBuffer {
+    public:
+        AlignedBuffer() noexcept : data_(nullptr), size_(0), capacity_(0) {}
+        ~AlignedBuffer();
+
+        AlignedBuffer(const AlignedBuffer& other);
+        AlignedBuffer& operator=(const AlignedBuffer& other);
+        AlignedBuffer(AlignedBuffer&& other) noexcept;
+        AlignedBuffer& operator=(AlignedBuffer&& other) noexcept;
+
+        uint8_t* data() noexcept { return data_; }
+        const uint8_t* data() const noexcept { return data_; }
+        size_t size() const noexcept { return size_; }
+        size_t capacity() const noexcept { return capacity_; }
+
+        // Make room for at least bytes without changing the size
+        void reserve(size_t bytes);
+
+        // Grow (new bytes are zeroed) or shrink
+        void resize(size_t bytes);
+
+        // Append count bytes
+        void append(const void* bytes, size_t count);
+
+        void clear() noexcept { size_ = 0; }
+
+    private:
+        uint8_t* data_;
+        size_t size_;
+        size_t capacity_;
+
+        // Grow the capacity geometrically to hold at least bytes
+        void grow(size_t bytes);
+    };
+
+    /**
+     * @brief One validity bit per row, least significant bit first (1 = present)
+     */
+    class ValidityBitmap {
+    public:
+        size_t size() const { return size_; }
+        size_t null_count() const { return null_count_; }
+
+        bool test(size_t index) const {
+            return (bits_.data()[index >> 3] >> (index & 7)) & 1;
+        }
+
+        void set(size_t index, bool valid);
+        void push_back(bool valid);
+
+        // Grow with bits of the given value, or shrink
+        void resize(size_t size, bool valid);
+        void reserve(size_t size);
+        void clear();
+
+        // Raw bits, (size() + 7) / 8 bytes
+        const uint8_t* data() const { return bits_.data(); }
+
+    private:
+        AlignedBuffer bits_;
+        size_t size_ = 0;
+        size_t null_count_ = 0;
+    };
+
+    // Physical type of a Column
+    enum class ColumnType : uint8_t {
+        Double,     // double
+        Int64,      // int64_t
+        Timestamp,  // int64_t, seconds since the epoch (UTC)
+        Bool,       // uint8_t, 0 or 1
+        String      // int32_t codes into the column's dictionary
+    };
+
+    // Lowercase name of a column type, e.g. "timestamp"
+    const char* column_type_name(ColumnType type);
+
+    /**
+     * @brief Typed, contiguous DataFrame column with a validity bitmap
+     *
+     * Values live in one kColumnAlignment-aligned buffer of the column's
+     * physical type and are read and written in place through typed spans.
+     * Null rows are marked in the bitmap and hold NaN in Double columns and
+     * 0 elsewhere, so kernels that treat NaN as missing may skip the bitmap.
+     * Strings are dictionary encoded: each row stores an int32_t code into
+     * dictionary(), and equal strings share one entry.
+     */
+    class Column {
+    public:
+        Column(std::string name, ColumnType type);
+
+        const std::string& name() const { return name_; }
+        ColumnType type() const { return type_; }
+        size_t size() const { return validity_.size(); }
+
+        size_t null_count() const { return validity_.null_count(); }
+        bool is_valid(size_t row) const { return validity_.test(row); }
+        bool is_null(size_t row) const { return !validity_.test(row); }
+        const ValidityBitmap& validity() const { return validity_; }
+
+        // Typed view of the values. T must be the column's physical type
+        // (double, int64_t for Int64 and Timestamp, uint8_t for Bool,
+        // int32_t codes for String); throws std::invalid_argument otherwise
+        template <typename T>
+        Span<T> values() {
+            check_type<T>();
+            return Span<T>(reinterpret_cast<T*>(values_.data()), size());
+        }
+
+        template <typename T>
+        Span<const T> values() const {
+            check_type<T>();
+            return Span<const T>(reinterpret_cast<const T*>(values_.data()), size());
+        }
+
+        Span<double> doubles() { return values<double>(); }
+        Span<const double> doubles() const { return values<double>(); }
+        Span<int64_t> int64s() { return values<int64_t>(); }
+        Span<const int64_t> int64s() const { return values<int64_t>(); }
+        Span<uint8_t> bools() { return values<uint8_t>(); }
+        Span<const uint8_t> bools() const { return values<uint8_t>(); }
+        Span<const int32_t> codes() const { return values<int32_t>(); }
+
+        // Distinct strings of a String column, indexed by code
+        const std::vector<std::string>& dictionary() const { return dictionary_; }
+
+        // String of a row (empty for nulls); throws unless this is a String column
+        std::string_view string_at(size_t row) const;
+
+        // Append one value; throws std::invalid_argument on a type mismatch
+        void append_double(double value);
+        void append_int64(int64_t value);  // Int64 and Timestamp columns
+        void append_bool(bool value);
+        void append_string(std::string_view value);
+        void append_null();
+
+        // Append any of the above: arithmetic values are converted to a
+        // numeric column's type, std::nullopt appends a null
+        template <typename T>
+        void append(const T& value);
+
+        // Throw the error append(value) would, without appending
+        template <typename T>
+        void check_append(const T& value) const;
+
+        // Bulk appends; NaN doubles are appended as nulls
+        void append_doubles(Span<const double> values);
+        void append_int64s(Span<const int64_t> values);
+
+        // Mark a row present or null (a null row's value is reset)
+        void set_valid(size_t row, bool valid);
+
+        void reserve(size_t rows);
+
+        // Grow with null rows, or shrink
+        void resize(size_t rows);
+
+    private:
+        std::string name_;
+        ColumnType type_;
+        AlignedBuffer values_;
+        ValidityBitmap validity_;
+
+        std::vector<std::string> dictionary_;
+        std::map<std::string, int32_t, std::less<>> dictionary_index_;
+
+        // Bytes per value of the physical type
+        size_t width() const;
+
+        // Write the null value (NaN or 0) into a row
+        void clear_value(size_t row);
+
+        template <typename T>
+        bool stores() const {
+            if (std::is_same<T, double>::value) return type_ == ColumnType::Double;
+            if (std::is_same<T, int64_t>::value) return type_ == ColumnType::Int64 || type_ == ColumnType::Timestamp;
+            if (std::is_same<T, uint8_t>::value) return type_ == ColumnType::Bool;
+            if (std::is_same<T, int32_t>::value) return type_ == ColumnType::String;
+            return false;
+        }
+
+        template <typename T>
+        void check_type() const {
+            if (!stores<T>()) {
+                throw_type_mismatch();
+            }
+        }
+
+        [[noreturn]] void throw_type_mismatch() const;
+    };
+
+    template <typename T>
+    void Column::append(const T& value) {
+        if constexpr (std::is_same<T, std::nullopt_t>::value) {
+            append_null();
+        } else if constexpr (std::is_same<T, bool>::value) {
+            append_bool(value);
+        } else if constexpr (std::is_arithmetic<T>::value) {
+            if (type_ == ColumnType::Double) {
+                append_double(static_cast<double>(value));
+            } else if (std::is_integral<T>::value) {
+                append_int64(static_cast<int64_t>(value));
+            } else {
+                throw_type_mismatch();
+            }
+        } else if constexpr (std::is_convertible<const T&, std::string_view>::value) {
+            append_string(std::string_view(value));
+        } else {
+            static_assert(std::is_arithmetic<T>::value, "Unsupported DataFrame value type");
+        }
+    }
+
+    template <typename T>
+    void Column::check_append(const T& /*value*/) const {
+        bool accepted = true;
+        if constexpr (std::is_same<T, std::nullopt_t>::value) {
+            accepted = true;
+        } else if constexpr (std::is_same<T, bool>::value) {
+            accepted = type_ == ColumnType::Bool;
+        } else if constexpr (std::is_arithmetic<T>::value) {
+            accepted = type_ == ColumnType::Double ||
+                       (std::is_integral<T>::value && (type_ == ColumnType::Int64 || type_ == ColumnType::Timestamp));
+        } else if constexpr (std::is_convertible<const T&, std::string_view>::value) {
+            accepted = type_ == ColumnType::String;
+        } else {
+            static_assert(std::is_arithmetic<T>::value, "Unsupported DataFrame value type");
+        }
+        if (!accepted) {
+            throw_type_mismatch();
+        }
+    }
+
+    class DataFrame;
+
+    /**
+     * @brief Non-owning view of one DataFrame row
+     *
+     * Reads values in place from the columns, so walking a frame row by row
+     * copies and allocates nothing. Valid while the frame is alive and its
+     * columns are not resized.
+     */
+    class RowView {
+    public:
+        RowView(const DataFrame& frame, size_t row) : frame_(&frame), row_(row) {}
+
+        // Position of the row in the frame
+        size_t index() const { return row_; }
+
+        bool is_null(size_t column) const;
+        bool is_null(const std::string& column) const;
+
+        // Value of a column in this row: T is double, int64_t, bool or
+        // std::string_view and must match the column type (throws
+        // std::invalid_argument otherwise). Nulls read as NaN, 0, false or ""
+        template <typename T>
+        T get(size_t column) const;
+
+        template <typename T>
+        T get(const std::string& column) const;
+
+    private:
+        const DataFrame* frame_;
+        size_t row_;
+    };
+
+    /**
+     * @brief Forward iterator over the rows of a DataFrame, yielding RowViews
+     */
+    class RowIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = RowView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = RowView;
+
+        RowIterator(const DataFrame& frame, size_t row) : frame_(&frame), row_(row) {}
+
+        RowView operator*() const { return RowView(*frame_, row_); }
+
+        RowIterator& operator++() {
+            ++row_;
+            return *this;
+        }
+
+        RowIterator operator++(int) {
+            RowIterator previous = *this;
+            ++row_;
+            return previous;
+        }
+
+        bool operator==(const RowIterator& other) const { return row_ == other.row_; }
+        bool operator!=(const RowIterator& other) const { return row_ != other.row_; }
+
+    private:
+        const DataFrame* frame_;
+        size_t row_;
+    };
+
+    /**
+     * @brief Columnar table of typed, named columns of equal length
+     *
+     * The in-process counterpart of a pandas DataFrame. Columns are
+     * allocated individually, so references to them stay valid while
+     * other columns are added. Names are hashed to column positions, so a
+     * lookup by name costs one hash rather than a scan; hot loops can
+     * resolve the position once with column_index() and use it instead.
+     * Rows are read in place through RowView (`for (RowView row : frame)`).
+     */
+    class DataFrame {
+    public:
+        DataFrame() = default;
+
+        DataFrame(DataFrame&&) = default;
+        DataFrame& operator=(DataFrame&&) = default;
+
+        // Add a column, filled with nulls up to rows(); throws
+        // std::invalid_argument if the name is taken
+        Column& add_column(const std::string& name, ColumnType type);
+
+        // Get a column by name (nullptr if not found)
+        Column* get_column(const std::string& name);
+        const Column* get_column(const std::string& name) const;
+
+        // Position of a named column; throws std::out_of_range
+        size_t column_index(const std::string& name) const;
+
+        // Get a column by name or position; throws std::out_of_range
+        Column& column(const std::string& name);
+        const Column& column(const std::string& name) const;
+        Column& column(size_t index);
+        const Column& column(size_t index) const;
+
+        // Add a row of data, one value per column (see Column::append)
+        template <typename... Args>
+        void add_row(const Args&... values) {
+            if (sizeof...(Args) != columns_.size()) {
+                throw std::invalid_argument("Number of values does not match number of columns");
+            }
+            // Check every value first, so a type mismatch leaves all columns
+            // the same length
+            size_t index = 0;
+            (columns_[index++]->check_append(values), ...);
+            index = 0;
+            (columns_[index++]->append(values), ...);
+        }
+
+        // Get number of rows
+        size_t rows() const {
+            return columns_.empty() ? 0 : columns_.front()->size();
+        }
+
+        // Get number of columns
+        size_t cols() const {
+            return columns_.size();
+        }
+
+        // Get column names
+        const std::vector<std::string>& get_column_names() const {
+            return column_names_;
+        }
+
+        // View of one row; throws std::out_of_range
+        RowView get_row(size_t index) const;
+
+        // Iterate rows as RowViews
+        RowIterator begin() const { return RowIterator(*this, 0); }
+        RowIterator end() const { return RowIterator(*this, rows()); }
+
+        // Reserve room for rows in every column
+        void reserve(size_t rows);
+
+        // "Date" (timestamp), "Open", "High", "Low", "Close", "Adj Close"
+        // (when present) and "Volume" (int64) columns; NaN becomes null
+        static DataFrame from_history(const PriceHistory& history);
+
+        // Print the DataFrame (for debugging)
+        void print() const;
+
+    private:
+        std::vector<std::string> column_names_;
+        std::vector<std::unique_ptr<Column>> columns_;
+        std::unordered_map<std::string, size_t> column_index_;
+    };
+
+    inline bool RowView::is_null(size_t column) const {
+        return frame_->column(column).is_null(row_);
+    }
+
+    inline bool RowView::is_null(const std::string& column) const {
+        return is_null(frame_->column_index(column));
+    }
+
+    template <typename T>
+    T RowView::get(size_t column) const {
+        const Column& col = frame_->column(column);
+        if constexpr (std::is_same<T, double>::value) {
+            return col.doubles()[row_];
+        } else if constexpr (std::is_same<T, int64_t>::value) {
+            return col.int64s()[row_];
+        } else if constexpr (std::is_same<T, bool>::value) {
+            return col.bools()[row_] != 0;
+        } else {
+            static_assert(std::is_same<T, std::string_view>::value,
+                          "RowView::get reads double, int64_t, bool or std::string_view");
+            return col.string_at(row_);
+        }
+    }
+
+    template <typename T>
+    T RowView::get(const std::string& column) const {
+        return get<T>(frame_->column_index(column));
+    }
+
+} // namespace yfinance
+
+#endif // DATAFRAME_H
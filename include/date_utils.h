@@ -4,6 +4,7 @@
 #include <string>
 #include <chrono>
 #include <ctime>
+#include <cstdint>
 
 namespace yfinance {
 
@@ -20,6 +21,16 @@ namespace yfinance {
         static std::string timestamp_to_string(std::time_t timestamp, 
                                               const std::string& format = "%Y-%m-%d");
 
+        // Format seconds since the epoch as wall time at a fixed UTC offset
+        // (e.g. ChartMeta::gmtoffset); unlike timestamp_to_string this does
+        // not depend on the process time zone and is thread-safe
+        static std::string format_epoch(int64_t seconds, int64_t utc_offset = 0,
+                                        const std::string& format = "%Y-%m-%d");
+
+        // Parse wall time at a fixed UTC offset into seconds since the epoch
+        static int64_t parse_epoch(const std::string& date_str, int64_t utc_offset = 0,
+                                   const std::string& format = "%Y-%m-%d");
+
         // Get current timestamp
         static std::time_t now();
 
@@ -0,0 +1,49 @@
+#ifndef FIXTURE_STORE_H
+#define FIXTURE_STORE_H
+
+#include <optional>
+#include <string>
+
+namespace yfinance {
+
+    /**
+     * @brief Directory of recorded HTTP responses used for offline replay
+     *
+     * HttpClient writes every response it receives here while recording is
+     * enabled, and the replay_server tool serves them back. A request maps to
+     * a fixture by method, path and sorted query parameters, ignoring the
+     * host and volatile parameters such as the crumb, so the same request
+     * finds the same fixture whether it went to Yahoo or to the local server.
+     *
+     * Each fixture is two files: "<name>.json" with the status and content
+     * type, and "<name>.body" with the raw response body.
+     */
+    class FixtureStore {
+    public:
+        struct Fixture {
+            long status = 200;
+            std::string content_type;
+            std::string body;
+        };
+
+        explicit FixtureStore(const std::string& directory);
+
+        // Save a response; the directory is created if needed
+        void save(const std::string& method, const std::string& url, const Fixture& fixture) const;
+
+        // Load the response recorded for a request
+        std::optional<Fixture> load(const std::string& method, const std::string& url) const;
+
+        // File name (without extension) for a request; url may be a full URL
+        // or just the request target ("/path?query")
+        static std::string fixture_name(const std::string& method, const std::string& url);
+
+        const std::string& directory() const { return directory_; }
+
+    private:
+        std::string directory_;
+    };
+
+} // namespace yfinance
+
+#endif // FIXTURE_STORE_H
@@ -0,0 +1,136 @@
+#ifndef HISTORY_STORE_H
+#define HISTORY_STORE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "data_structures.h"
+#include "span.h"
+
+namespace yfinance {
+
+    /**
+     * @brief A stored price series mapped read-only into memory
+     *
+     * The columns point straight into the mapped files, so opening a series
+     * costs a few mmap calls regardless of its length and bars are paged in
+     * as they are read. Move-only; the mappings are released on destruction.
+     * Column values are as stored: adjclose is NaN for bars appended without
+     * an adjusted close.
+     *
+     * The number of bars is fixed when the series is opened, but the last
+     * bar can change under a live mapping: an append that brings that bar
+     * again rewrites it in place one column at a time, so reading the spans
+     * during a sync may see some of its columns updated and others not.
+     * between() and to_price_history() hold a shared lock against appends
+     * while they copy, so their copies are always consistent.
+     */
+    class MappedHistory {
+    public:
+        MappedHistory(const MappedHistory&) = delete;
+        MappedHistory& operator=(const MappedHistory&) = delete;
+        MappedHistory(MappedHistory&& other) noexcept;
+        MappedHistory& operator=(MappedHistory&& other) noexcept;
+        ~MappedHistory();
+
+        // Number of bars
+        size_t size() const { return size_; }
+
+        Span<const int64_t> timestamp() const;
+        Span<const double> open() const;
+        Span<const double> high() const;
+        Span<const double> low() const;
+        Span<const double> close() const;
+        Span<const double> adjclose() const;
+        Span<const double> volume() const;
+
+        // Meta, dividends and splits as of the last append
+        const ChartMeta& meta() const { return meta_; }
+        const std::vector<DividendEvent>& dividends() const { return dividends_; }
+        const std::vector<SplitEvent>& splits() const { return splits_; }
+
+        // Same time lookups as PriceHistory, over the mapped timestamps
+        size_t lower_bound(int64_t t) const;
+        std::optional<size_t> asof(int64_t t) const;
+        std::pair<size_t, size_t> index_range(int64_t start, int64_t end) const;
+
+        // Copy every bar, or the bars with start <= timestamp < end, into a PriceHistory
+        PriceHistory to_price_history() const;
+        PriceHistory between(int64_t start, int64_t end) const;
+
+    private:
+        friend class HistoryStore;
+
+        // timestamp, open, high, low, close, adjclose, volume
+        static constexpr size_t kColumnCount = 7;
+
+        struct Mapping {
+            void* address = nullptr;
+            size_t length = 0;
+        };
+
+        MappedHistory() = default;
+
+        const double* doubles(size_t column) const;
+        void release();
+
+        std::array<Mapping, kColumnCount> mappings_{};
+        int lock_fd_ = -1;  // timestamp.col, flocked shared while copying
+        size_t size_ = 0;
+        ChartMeta meta_;
+        std::vector<DividendEvent> dividends_;
+        std::vector<SplitEvent> splits_;
+    };
+
+    /**
+     * @brief Append-only columnar store of price histories, one series per (symbol, interval)
+     *
+     * A series is the directory "<symbol>/<interval>" with one file per
+     * column ("timestamp.col", "open.col", ...) and a "meta.json" holding the
+     * chart meta, dividends and splits. A column file is a 64-byte header
+     * (magic, version, element type) followed by the values in native byte
+     * order, so mapping it needs no decoding and leaves the values 64-byte
+     * aligned. Appends write past the end of each file, apart from
+     * rewriting the last bar in place; the series length is that of its
+     * shortest column, so readers ignore a torn append and the next append
+     * trims it. Appends to one series are serialized with an flock on its
+     * timestamp file.
+     */
+    class HistoryStore {
+    public:
+        explicit HistoryStore(const std::string& directory);
+
+        // Append the bars of history later than the last stored one and merge
+        // its dividends and splits; meta.json is replaced with history.meta.
+        // If history also holds a bar at the last stored timestamp, that bar
+        // is overwritten, so a bar stored before its period closed is
+        // completed by the next append. The directory is created if needed.
+        // Returns the number of bars added; throws std::runtime_error on I/O
+        // failure
+        size_t append(const std::string& symbol, const std::string& interval, const PriceHistory& history) const;
+
+        // Map a stored series; nullopt if nothing is stored for it. Throws
+        // std::runtime_error if a column file is corrupt
+        std::optional<MappedHistory> open(const std::string& symbol, const std::string& interval) const;
+
+        // Start of the last stored bar, nullopt if the series is empty
+        std::optional<int64_t> last_timestamp(const std::string& symbol, const std::string& interval) const;
+
+        // Delete a stored series
+        void remove(const std::string& symbol, const std::string& interval) const;
+
+        const std::string& directory() const { return directory_; }
+
+    private:
+        std::string directory_;
+
+        std::string series_path(const std::string& symbol, const std::string& interval) const;
+    };
+
+} // namespace yfinance
+
+#endif // HISTORY_STORE_H
@@ -4,34 +4,70 @@
 #include <string>
 #include <map>
 #include <memory>
+#include <vector>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <future>
+#include <atomic>
+#include <ctime>
+#include <mutex>
 
 #include "json_parser.h"
+#include "retry_policy.h"
+#include "buffer_pool.h"
+#include "streaming_parser.h"
+
+#ifdef USE_CPR
+#include <cpr/cpr.h>
+#elif defined(USE_CPP_HTTP_LIB)
+#include <httplib.h>
+#else
+// Fallback to libcurl C++ wrapper
+#include <curl/curl.h>
+#endif
 
 namespace yfinance {
 
     // Custom exception for HTTP client errors
     class HttpClientException : public std::exception {
     public:
-        explicit HttpClientException(const std::string& message) : msg_(message) {}
+        explicit HttpClientException(const std::string& message, long status_code = 0)
+            : msg_(message), status_code_(status_code) {}
         virtual const char* what() const noexcept override { return msg_.c_str(); }
+
+        // HTTP status of the failed response, or 0 for transport/parse errors
+        long status_code() const noexcept { return status_code_; }
     private:
         std::string msg_;
+        long status_code_;
+    };
+
+    // HTTP protocol version used for requests
+    enum class HttpVersion {
+        Http1_1,             // One request per connection at a time
+        Http2,               // HTTP/2 negotiated over TLS, falling back to HTTP/1.1
+        Http2PriorKnowledge  // Cleartext HTTP/2 without negotiation (local stand-in servers)
     };
 
     /**
      * @brief HTTP client wrapper for making requests to Yahoo Finance API
+     *
+     * Requests may be issued concurrently from several threads. Configure
+     * proxy, user agent and HTTP version before sharing the client.
      */
-#ifdef USE_CPR
-#include <cpr/cpr.h>
-#elif defined(USE_CPP_HTTP_LIB)
-#include <httplib.h>
-#else
-// Fallback to libcurl C++ wrapper
-#include <curl/curl.h>
-#endif
-
     class HttpClient {
     public:
+        // Completion callback for async requests: the response body, or the
+        // exception that ended the request (body is empty in that case)
+        using ResponseCallback = std::function<void(std::string response, std::exception_ptr error)>;
+
+        // Same, handing over the pooled response buffer itself
+        using BufferCallback = std::function<void(ResponseBuffer body, std::exception_ptr error)>;
+
+        // Reads a response body from a stream, e.g. ChartDecoder::decode(std::istream&)
+        using StreamConsumer = StreamingParser::Consumer;
+
         HttpClient();
         ~HttpClient();
 
@@ -45,59 +81,143 @@ namespace yfinance {
                             const std::map<std::string, std::string>& headers = {},
                             const std::map<std::string, std::string>& params = {});
 
+        // GET request returning the pooled response buffer, to be parsed in
+        // place; the storage goes back to the BufferPool when it is dropped
+        ResponseBuffer get_buffer(const std::string& url,
+                                  const std::map<std::string, std::string>& headers = {},
+                                  const std::map<std::string, std::string>& params = {});
+
+        // GET whose body is fed to consumer on a worker thread while it is
+        // downloading, so parsing overlaps the transfer; returns once both are
+        // done. Small bodies (under 64 KiB) are parsed inline after the
+        // transfer instead. Errors thrown by the consumer are not retried.
+        void get_streamed(const std::string& url,
+                          const std::map<std::string, std::string>& headers,
+                          const std::map<std::string, std::string>& params,
+                          StreamConsumer consumer);
+
         // POST request
         nlohmann::json post(const std::string& url,
                            const std::string& data,
                            const std::map<std::string, std::string>& headers = {});
 
+        // Asynchronous GET returning JSON, driven by the shared RequestLoop
+        std::future<nlohmann::json> get_async(const std::string& url,
+                                              const std::map<std::string, std::string>& headers = {},
+                                              const std::map<std::string, std::string>& params = {});
+
+        // Asynchronous GET returning raw text
+        std::future<std::string> get_text_async(const std::string& url,
+                                                const std::map<std::string, std::string>& headers = {},
+                                                const std::map<std::string, std::string>& params = {});
+
+        // Asynchronous GET with a completion callback (runs on the loop thread)
+        void get_text_async(const std::string& url,
+                            const std::map<std::string, std::string>& headers,
+                            const std::map<std::string, std::string>& params,
+                            ResponseCallback callback);
+
+        // Asynchronous GET handing the pooled response buffer to the callback
+        void get_buffer_async(const std::string& url,
+                              const std::map<std::string, std::string>& headers,
+                              const std::map<std::string, std::string>& params,
+                              BufferCallback callback);
+
         // Set proxy
         void set_proxy(const std::string& proxy);
 
         // Set number of retries for failed requests
         void set_retries(int retries);
 
+        // Replace the retry policy (retry count, backoff, deadline, Retry-After)
+        void set_retry_policy(const RetryPolicy& policy);
+        RetryPolicy get_retry_policy() const;
+
         // Set timeout for requests
         void set_timeout(int seconds);
 
         // Set user agent string
         void set_user_agent(const std::string& user_agent);
 
+        // Select the HTTP version; with HTTP/2, concurrent async requests to the
+        // same host are multiplexed as streams over a few shared connections
+        void set_http_version(HttpVersion version);
+
+        // Use a custom CA certificate bundle (e.g. for a local TLS stand-in server)
+        void set_ca_info(const std::string& ca_bundle_path);
+
+        // Record every response received by any client into a fixture
+        // directory for offline replay ("" stops recording). Recording can also
+        // be enabled with the YFINANCE_RECORD_DIR environment variable.
+        static void set_record_directory(const std::string& directory);
+
+        // Process-wide limits for multiplexed async requests
+        static void set_max_concurrent_streams(long streams);
+        static void set_max_host_connections(long connections);
+
         // Get cookie data
-        std::string get_cookies() const { return cookies_; }
+        std::string get_cookies() const;
 
         // Set cookie data
-        void set_cookies(const std::string& cookies) { cookies_ = cookies; }
+        void set_cookies(const std::string& cookies);
+
+        // Earliest expiry among persistent cookies received so far (0 if none)
+        std::time_t get_cookie_expiry() const;
 
     private:
+        struct CookieJar;
+        struct Transfer;
+
         std::string proxy_;
         std::string user_agent_;
-        std::string cookies_;
-        int retries_;
-        int timeout_;
+        std::string ca_info_;
+        std::atomic<int> timeout_;
+        RetryPolicy retry_policy_;
+        mutable std::mutex retry_mutex_;
+        HttpVersion http_version_;
+
+        // Shared with in-flight async requests so they can store the cookies
+        // they receive even after the client has gone away
+        std::shared_ptr<CookieJar> cookie_jar_;
+
+        // Append URL-encoded params to a URL
+        static std::string build_url(const std::string& url,
+                                     const std::map<std::string, std::string>& params);
+
+        // Perform request with retry logic; with a consumer the body of the
+        // successful attempt is streamed into it (and may not be buffered)
+        ResponseBuffer perform_request(const std::string& method,
+                                      const std::string& url,
+                                      const std::map<std::string, std::string>& headers,
+                                      const std::string& data = "",
+                                      StreamConsumer consumer = nullptr);
+
+        // Run the consumer over the finished response and wrap its errors
+        static void consume_response(const StreamConsumer& consumer, const std::string& url,
+                                     const char* data, size_t size);
 
 #ifndef USE_CPR
 #ifndef USE_CPP_HTTP_LIB
-        CURL* curl_handle_;
-#endif
-#endif
+        // Configure a borrowed easy handle for the transfer
+        static void prepare_transfer(Transfer& transfer);
 
-        // Perform request with retry logic
-        std::string perform_request(const std::string& method,
-                                   const std::string& url,
-                                   const std::map<std::string, std::string>& headers,
-                                   const std::string& data = "");
+        // Collect cookies, the status code and Retry-After once the transfer has finished
+        static long finish_transfer(Transfer& transfer);
 
-        // Check if error is transient and should be retried
-        bool is_transient_error(const std::string& error_message);
+        // Save the finished transfer's response when recording is enabled
+        static void record_response(const Transfer& transfer, long response_code);
 
-#ifndef USE_CPR
-#ifndef USE_CPP_HTTP_LIB
-        // Static callback for libcurl
-        static size_t WriteCallback(void *contents, size_t size, size_t nmemb, std::string *userp);
+        // Hand the transfer to the RequestLoop, rescheduling it on retryable failures
+        static void submit_transfer(std::shared_ptr<Transfer> transfer,
+                                    BufferCallback callback,
+                                    std::chrono::milliseconds delay);
+
+        // Static callback for libcurl; userp is the Transfer
+        static size_t WriteCallback(void *contents, size_t size, size_t nmemb, void *userp);
 #endif
 #endif
     };
 
 } // namespace yfinance
 
-#endif // HTTP_CLIENT_H
\ No newline at end of file
+#endif // HTTP_CLIENT_H
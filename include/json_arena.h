@@ -0,0 +1,115 @@
+#ifndef JSON_ARENA_H
+#define JSON_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace yfinance {
+
+    /**
+     * @brief Routes default-constructed ArenaAllocators to a memory resource
+     *
+     * nlohmann::basic_json default-constructs its allocator for every node, so
+     * the resource cannot be passed in; it is taken from a thread-local set by
+     * this RAII guard instead. Outside any scope allocations go to the heap.
+     */
+    class ArenaScope {
+    public:
+        explicit ArenaScope(std::pmr::memory_resource* resource);
+        ~ArenaScope();
+
+        ArenaScope(const ArenaScope&) = delete;
+        ArenaScope& operator=(const ArenaScope&) = delete;
+
+        // Resource used by allocations on this thread right now
+        static std::pmr::memory_resource* current();
+
+    private:
+        std::pmr::memory_resource* previous_;
+    };
+
+    /**
+     * @brief Allocator that draws from the resource of the enclosing ArenaScope
+     *
+     * Each block carries a small header naming the resource it came from, so
+     * it is released to the right place whatever scope (or thread) frees it:
+     * a monotonic arena ignores the release, the heap frees it.
+     */
+    template <typename T>
+    class ArenaAllocator {
+    public:
+        using value_type = T;
+
+        ArenaAllocator() noexcept = default;
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>&) noexcept {}
+
+        T* allocate(size_t n) {
+            std::pmr::memory_resource* resource = ArenaScope::current();
+            void* block = resource->allocate(kHeader + n * sizeof(T), kAlignment);
+            *static_cast<std::pmr::memory_resource**>(block) = resource;
+            return reinterpret_cast<T*>(static_cast<char*>(block) + kHeader);
+        }
+
+        void deallocate(T* ptr, size_t n) noexcept {
+            void* block = reinterpret_cast<char*>(ptr) - kHeader;
+            std::pmr::memory_resource* resource = *static_cast<std::pmr::memory_resource**>(block);
+            resource->deallocate(block, kHeader + n * sizeof(T), kAlignment);
+        }
+
+        template <typename U>
+        bool operator==(const ArenaAllocator<U>&) const noexcept { return true; }
+        template <typename U>
+        bool operator!=(const ArenaAllocator<U>&) const noexcept { return false; }
+
+    private:
+        static constexpr size_t kAlignment = alignof(std::max_align_t) > alignof(T) ? alignof(std::max_align_t) : alignof(T);
+        static constexpr size_t kHeader = kAlignment > sizeof(void*) ? kAlignment : sizeof(void*);
+    };
+
+    // String and JSON types whose every node and string lives in an arena
+    using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+    using ArenaJson = nlohmann::basic_json<std::map, std::vector, ArenaString, bool,
+                                           int64_t, uint64_t, double, ArenaAllocator>;
+
+    /**
+     * @brief Parsed JSON document that owns a monotonic arena
+     *
+     * Every allocation of the parse is a pointer bump in the arena, with no
+     * malloc lock and no per-node free; the whole document is released in one
+     * shot when it is destroyed. Move-only.
+     */
+    class ArenaDocument {
+    public:
+        // initial_size is the arena's first block, e.g. a multiple of the payload size
+        explicit ArenaDocument(size_t initial_size = 64 * 1024);
+        ~ArenaDocument();
+
+        ArenaDocument(ArenaDocument&& other) noexcept = default;
+        ArenaDocument& operator=(ArenaDocument&& other) noexcept;
+
+        ArenaDocument(const ArenaDocument&) = delete;
+        ArenaDocument& operator=(const ArenaDocument&) = delete;
+
+        ArenaJson& root() { return *root_; }
+        const ArenaJson& root() const { return *root_; }
+
+        // Arena backing the document; allocate into it with ArenaScope
+        std::pmr::memory_resource* resource() const { return arena_.get(); }
+
+    private:
+        // Declared first so the arena outlives the document's nodes
+        std::unique_ptr<std::pmr::monotonic_buffer_resource> arena_;
+        std::unique_ptr<ArenaJson> root_;
+    };
+
+} // namespace yfinance
+
+#endif // JSON_ARENA_H
@@ -5,12 +5,56 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <initializer_list>
+
+#include "json_arena.h"
 
 // Import nlohmann json namespace
 namespace json = nlohmann;
 
 namespace yfinance {
 
+    /**
+     * @brief Path into a JSON document, compiled once and evaluated many times
+     *
+     * Paths use dotted keys and bracketed indices, e.g.
+     * "quoteSummary.result[0].financialData.currentPrice.raw"; keys containing
+     * dots can be quoted as ["key.with.dots"]. The path is split into steps
+     * when constructed, so evaluating it only walks the document: no parsing,
+     * no temporary strings and no allocations.
+     */
+    class JsonPath {
+    public:
+        // Compile a path; throws std::invalid_argument on malformed syntax
+        explicit JsonPath(const std::string& path);
+
+        // Node the path points to, or nullptr if any step is missing
+        const json::json* find(const json::json& doc) const;
+        json::json* find(json::json& doc) const;
+
+        // Numeric value at the path, or fallback if it is missing or not a number
+        double number_or(const json::json& doc, double fallback) const;
+
+        // Evaluate over many documents; out is resized to docs.size() and
+        // reused between calls, so a warm vector is not reallocated
+        void find_all(const std::vector<json::json>& docs, std::vector<const json::json*>& out) const;
+
+        // Numeric value per document, NaN where the path is missing or not a number
+        void numbers(const std::vector<json::json>& docs, std::vector<double>& out) const;
+
+        const std::string& str() const { return path_; }
+
+    private:
+        struct Step {
+            std::string key;   // Object key, used when is_index is false
+            size_t index = 0;  // Array index, used when is_index is true
+            bool is_index = false;
+        };
+
+        std::string path_;
+        std::vector<Step> steps_;
+    };
+
     /**
      * @brief Utility class for JSON parsing and manipulation
      */
@@ -19,12 +63,40 @@ namespace yfinance {
         // Parse JSON string
         static json::json parse(const std::string& json_str);
 
+        // Parse JSON from a character range in place (e.g. a pooled response buffer)
+        static json::json parse(const char* data, size_t size);
+
+        // Parse into a document backed by its own monotonic arena: no per-node
+        // heap allocation, and everything is freed at once with the document
+        static ArenaDocument parse_arena(const char* data, size_t size);
+        static ArenaDocument parse_arena(const std::string& json_str);
+
+        // Parser used by parse(): "simdjson" when built with USE_SIMDJSON, else "nlohmann"
+        static const char* backend();
+
         // Convert JSON object to string
         static std::string stringify(const json::json& obj, bool pretty = false);
 
-        // Extract specific fields from JSON
+        // Extract specific fields from JSON (returns a copy of the subtree)
         static json::json extract_field(const json::json& obj, const std::string& field);
 
+        // Look up a field without copying: returns a pointer into obj, or
+        // nullptr if obj is not an object or has no such field
+        static const json::json* find(const json::json& obj, const std::string& field);
+        static json::json* find(json::json& obj, const std::string& field);
+
+        // Follow a chain of object keys, e.g. find_path(doc, {"chart", "result"})
+        static const json::json* find_path(const json::json& obj, std::initializer_list<const char*> path);
+        static json::json* find_path(json::json& obj, std::initializer_list<const char*> path);
+
+        // Array element without copying, or nullptr if arr is not an array or index is out of range
+        static const json::json* find_element(const json::json& arr, size_t index);
+        static json::json* find_element(json::json& arr, size_t index);
+
+        // Reference to a field; throws like extract_field if it is missing
+        static const json::json& get_field(const json::json& obj, const std::string& field);
+        static json::json& get_field(json::json& obj, const std::string& field);
+
         // Check if field exists in JSON
         static bool has_field(const json::json& obj, const std::string& field);
 
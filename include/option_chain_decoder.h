@@ -0,0 +1,31 @@
+#ifndef OPTION_CHAIN_DECODER_H
+#define OPTION_CHAIN_DECODER_H
+
+#include <string>
+
+#include "data_structures.h"
+
+namespace yfinance {
+
+    /**
+     * @brief Streaming decoder for /v7/finance/options responses
+     *
+     * Parses the payload with SAX callbacks straight into the columns of an
+     * OptionChain, without building a JSON DOM. Each contract object appends
+     * one row with default values, and its fields overwrite that row, so
+     * contracts missing a field (volume is often absent) stay aligned. Only
+     * the first option chain result is decoded.
+     */
+    class OptionChainDecoder {
+    public:
+        // Decode an options payload; an empty "result" list (a symbol with
+        // no listed options) gives an empty OptionChain. Throws
+        // std::runtime_error on malformed JSON, when Yahoo reports an error
+        // or when the response has no "result" at all
+        static OptionChain decode(const char* data, size_t size);
+        static OptionChain decode(const std::string& payload);
+    };
+
+} // namespace yfinance
+
+#endif // OPTION_CHAIN_DECODER_H
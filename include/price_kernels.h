@@ -0,0 +1,78 @@
+#ifndef PRICE_KERNELS_H
+#define PRICE_KERNELS_H
+
+#include <cstddef>
+#include <vector>
+
+#include "data_structures.h"
+#include "span.h"
+
+namespace yfinance {
+
+    // Instruction sets the kernels are compiled for, in increasing order
+    enum class SimdLevel {
+        Scalar,
+        SSE2,
+        AVX2,
+        AVX512
+    };
+
+    // Display name of a level, e.g. "AVX2"
+    const char* simd_level_name(SimdLevel level);
+
+    // Summary of a column; NaN values are skipped
+    struct ColumnStats {
+        size_t count = 0;             // Non-NaN values
+        double sum = 0.0;
+        double min = kMissingValue;   // NaN when count is 0
+        double max = kMissingValue;
+        double mean = kMissingValue;
+    };
+
+    /**
+     * @brief Vectorized aggregations over price columns
+     *
+     * Every kernel has a scalar, SSE2, AVX2 and AVX-512 implementation built
+     * with per-function target attributes, so the library itself needs no
+     * -m flags; the best level the CPU supports is picked at runtime with
+     * __builtin_cpu_supports. Inputs may be any contiguous doubles (the
+     * PriceHistory vectors, DataFrame column spans) and need no particular
+     * alignment. NaN marks a missing bar and is skipped, never propagated
+     * into sums or extremes. Sums are accumulated in a different order at
+     * each level, so results may differ in the last bits.
+     */
+    class PriceKernels {
+    public:
+        // Best level supported by this CPU (Scalar on non-x86 builds)
+        static SimdLevel detected_level();
+
+        // Level the kernels currently run at (detected_level() by default)
+        static SimdLevel level();
+
+        // Run at a lower level, e.g. to compare them; throws
+        // std::invalid_argument if the CPU does not support the level
+        static void set_level(SimdLevel level);
+
+        // Count, sum, min, max and mean of the non-NaN values in one pass
+        static ColumnStats stats(Span<const double> values);
+
+        // Volume-weighted average price over the bars where both price and
+        // volume are present; NaN if there is no such bar or no volume
+        static double vwap(Span<const double> price, Span<const double> volume);
+
+        // True range of each bar: max(high - low, |high - prev close|,
+        // |low - prev close|). The first bar, and bars after a missing
+        // close, use high - low; bars missing high or low are NaN. out
+        // must hold high.size() values; the inputs must be equally long
+        static void true_range(Span<const double> high, Span<const double> low,
+                               Span<const double> close, Span<double> out);
+
+        // Convenience overloads over a PriceHistory: VWAP of the close and
+        // the true range of every bar
+        static double vwap(const PriceHistory& history);
+        static std::vector<double> true_range(const PriceHistory& history);
+    };
+
+} // namespace yfinance
+
+#endif // PRICE_KERNELS_H
@@ -0,0 +1,56 @@
+#ifndef QUOTE_SUMMARY_DECODER_H
+#define QUOTE_SUMMARY_DECODER_H
+
+#include <cstddef>
+
+#include "json_parser.h"
+#include "data_structures.h"
+
+namespace yfinance {
+
+    // How a quoteSummary field is stored in its typed struct
+    enum class FieldType {
+        Double,
+        Int64,
+        String
+    };
+
+    // Maps one JSON key of a module to a member of its struct
+    struct FieldDescriptor {
+        const char* key;
+        FieldType type;
+        size_t offset;  // offsetof() the member
+    };
+
+    /**
+     * @brief Decodes quoteSummary modules into the typed structs of data_structures.h
+     *
+     * Each struct has a constexpr table of FieldDescriptors; decoding walks the
+     * table once, reads the "raw" member of each {"raw", "fmt", "longFmt"}
+     * object (or the bare value) and stores it at the member's offset. Keys
+     * not in the table, and every formatted string, are dropped.
+     */
+    class QuoteSummaryDecoder {
+    public:
+        // Decode one module object, e.g. decode<FinancialData>(result["financialData"]);
+        // a null or non-object module yields a default (all missing) struct.
+        // Defined for FinancialData, SummaryDetail, DefaultKeyStatistics and QuotePrice.
+        template <typename Module>
+        static Module decode(const json::json& module);
+
+        // Decode every typed module present in a quoteSummary result object
+        // (quoteSummary.result[0], or the object returned by Ticker::get_modules)
+        static QuoteSummary decode_result(const json::json& result);
+
+        // JSON module name of a typed struct, e.g. "financialData"
+        template <typename Module>
+        static const char* module_name();
+
+        // Descriptor table of a typed struct
+        template <typename Module>
+        static const FieldDescriptor* fields(size_t& count);
+    };
+
+} // namespace yfinance
+
+#endif // QUOTE_SUMMARY_DECODER_H
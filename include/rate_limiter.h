@@ -0,0 +1,147 @@
+#ifndef RATE_LIMITER_H
+#define RATE_LIMITER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+
+namespace yfinance {
+
+    /**
+     * @brief Lock-free token bucket
+     *
+     * Implemented as GCRA (generic cell rate algorithm): the whole bucket state
+     * is one atomic "theoretical arrival time", updated with a CAS loop, so any
+     * number of threads can draw from the same bucket without a mutex.
+     */
+    class TokenBucket {
+    public:
+        // A rate of 0 disables the bucket (every request is admitted)
+        explicit TokenBucket(double requests_per_second = 0.0, double burst = 1.0);
+
+        // Take one token; returns zero if granted, otherwise how long to wait
+        std::chrono::nanoseconds try_acquire();
+
+        // Change rate and burst size
+        void set_rate(double requests_per_second, double burst);
+
+    private:
+        std::atomic<int64_t> tat_ns_;       // Theoretical arrival time of the next request
+        std::atomic<int64_t> interval_ns_;  // Time per token (0 = unlimited)
+        std::atomic<int64_t> tolerance_ns_; // How far ahead of schedule a burst may run
+
+        static int64_t now_ns();
+    };
+
+    /**
+     * @brief AIMD controller for the number of requests in flight to one host
+     *
+     * The window grows by one request per window of successes (additive
+     * increase) and halves on 429/503 (multiplicative decrease). Decreases are
+     * limited to one per cooldown so a burst of throttled responses from the
+     * same window only shrinks it once.
+     */
+    class AimdController {
+    public:
+        AimdController(size_t initial_window, size_t min_window, size_t max_window);
+
+        // Reserve an in-flight slot if the window allows it
+        bool try_enter();
+
+        // Release a slot reserved by try_enter()
+        void exit();
+
+        // Feed back the outcome of a request
+        void on_success();
+        void on_throttle();
+
+        // Current window and number of requests in flight
+        size_t window() const;
+        size_t in_flight() const { return in_flight_.load(); }
+
+        // Change the bounds and restart the window at initial_window
+        void set_limits(size_t initial_window, size_t min_window, size_t max_window);
+
+    private:
+        // Window in 1/kScale requests so additive increase can be fractional
+        static constexpr uint64_t kScale = 1024;
+
+        std::atomic<uint64_t> window_scaled_;
+        std::atomic<size_t> in_flight_;
+        std::atomic<size_t> min_window_;
+        std::atomic<size_t> max_window_;
+        std::atomic<int64_t> last_decrease_ns_;
+    };
+
+    // Limits applied to every host unless configured otherwise. The window
+    // starts fully open and only shrinks once a host answers 429/503
+    struct RateLimits {
+        double requests_per_second = 0.0;  // 0 disables the token bucket
+        double burst = 10.0;
+        size_t initial_concurrency = 256;
+        size_t min_concurrency = 1;
+        size_t max_concurrency = 256;
+    };
+
+    /**
+     * @brief Token bucket plus AIMD window for a single host
+     */
+    class HostLimiter {
+    public:
+        explicit HostLimiter(const RateLimits& limits);
+
+        // Block until a slot and a token are available
+        void acquire();
+
+        // Non-blocking variant for the async loop: reserves a slot and a token
+        // and returns zero, or returns how long to wait before asking again
+        std::chrono::nanoseconds try_acquire();
+
+        // Release the slot and feed back the HTTP status (0 for transport errors)
+        void release(long status_code);
+
+        // Apply new limits; the concurrency window restarts at initial_concurrency
+        void configure(const RateLimits& limits);
+
+        AimdController& concurrency() { return concurrency_; }
+
+    private:
+        TokenBucket bucket_;
+        AimdController concurrency_;
+    };
+
+    /**
+     * @brief Process-wide registry of per-host limiters
+     */
+    class RateLimiter {
+    public:
+        static RateLimiter& instance();
+
+        // Limiter for the host of a URL (created with the default limits)
+        std::shared_ptr<HostLimiter> for_url(const std::string& url);
+
+        // Limits used for hosts without their own configuration
+        void set_default_limits(const RateLimits& limits);
+
+        // Override the limits for one host (e.g. "query1.finance.yahoo.com")
+        void set_host_limits(const std::string& host, const RateLimits& limits);
+
+        // Extract "host[:port]" from a URL
+        static std::string host_of(const std::string& url);
+
+    private:
+        RateLimiter() = default;
+
+        std::shared_mutex mutex_;
+        RateLimits default_limits_;
+        std::map<std::string, std::shared_ptr<HostLimiter>> hosts_;
+    };
+
+} // namespace yfinance
+
+#endif // RATE_LIMITER_H
@@ -0,0 +1,100 @@
+#ifndef REQUEST_LOOP_H
+#define REQUEST_LOOP_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include <curl/curl.h>
+
+namespace yfinance {
+
+    /**
+     * @brief Single-threaded curl_multi event loop shared by all async requests
+     *
+     * Callers hand over a fully configured easy handle together with a
+     * completion callback. The loop thread drives every transfer through one
+     * multi handle, so hundreds of requests can be in flight without a thread
+     * per request. Completion callbacks run on the loop thread and must not
+     * block.
+     */
+    class RequestLoop {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using CompletionCallback = std::function<void(CURLcode result)>;
+
+        // Admission check run on the loop thread right before a transfer
+        // starts: returns zero to start it, or how long to wait before asking again
+        using AdmitCallback = std::function<std::chrono::nanoseconds()>;
+
+        // Get the process-wide loop (the thread is started on first use)
+        static RequestLoop& instance();
+
+        RequestLoop(const RequestLoop&) = delete;
+        RequestLoop& operator=(const RequestLoop&) = delete;
+
+        // Queue a configured handle; it is added to the multi handle once the
+        // delay has elapsed, a slot below the in-flight limit is free and the
+        // optional admission check (e.g. a per-host rate limiter) agrees
+        void submit(CURL* handle, CompletionCallback on_complete,
+                    std::chrono::milliseconds delay = std::chrono::milliseconds(0),
+                    AdmitCallback admit = nullptr);
+
+        // Maximum number of transfers driven concurrently
+        void set_max_in_flight(size_t max_in_flight);
+
+        // Maximum HTTP/2 streams multiplexed over one connection
+        void set_max_concurrent_streams(long streams);
+
+        // Maximum connections opened to a single host (0 means unlimited)
+        void set_max_host_connections(long connections);
+
+        // Number of transfers currently attached to the multi handle
+        size_t in_flight() const { return in_flight_.load(); }
+
+        // Number of transfers waiting for their delay or a free slot
+        size_t pending() const;
+
+    private:
+        RequestLoop();
+        ~RequestLoop();
+
+        struct PendingTransfer {
+            CURL* handle;
+            CompletionCallback on_complete;
+            Clock::time_point ready_at;
+            AdmitCallback admit;
+        };
+
+        CURLM* multi_;
+        std::thread thread_;
+        std::atomic<bool> running_;
+        std::atomic<size_t> in_flight_;
+        std::atomic<size_t> max_in_flight_;
+
+        // Multi options are applied on the loop thread when changed
+        std::atomic<long> max_concurrent_streams_;
+        std::atomic<long> max_host_connections_;
+        std::atomic<bool> options_changed_;
+
+        mutable std::mutex mutex_;
+        std::deque<PendingTransfer> pending_;
+
+        // Owned by the loop thread only
+        std::map<CURL*, CompletionCallback> active_;
+
+        void run();
+        void apply_options();
+        void start_ready_transfers();
+        void complete_finished_transfers();
+        int poll_timeout_ms() const;
+    };
+
+} // namespace yfinance
+
+#endif // REQUEST_LOOP_H
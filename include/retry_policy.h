@@ -0,0 +1,80 @@
+#ifndef RETRY_POLICY_H
+#define RETRY_POLICY_H
+
+#include <chrono>
+
+#include <curl/curl.h>
+
+namespace yfinance {
+
+    /**
+     * @brief Which failures are retried, how long to wait and for how long overall
+     *
+     * Backoff uses "decorrelated jitter": each delay is drawn uniformly from
+     * [base_delay, 3 * previous delay] and capped at max_delay, so clients that
+     * failed together do not retry in lockstep. A Retry-After header from the
+     * server takes precedence when it asks for a longer wait, up to
+     * max_retry_after; a server asking for more than that is not retried.
+     */
+    struct RetryPolicy {
+        int max_retries = 3;
+        std::chrono::milliseconds base_delay{500};
+        std::chrono::milliseconds max_delay{20000};
+
+        // Total time budget for a call including all retries (0 = no deadline)
+        std::chrono::milliseconds deadline{0};
+
+        bool honor_retry_after = true;
+
+        // Longest Retry-After honored; a longer one ends the retries
+        std::chrono::milliseconds max_retry_after{60000};
+
+        // Transport errors worth retrying (timeouts, resets, DNS hiccups, ...)
+        static bool is_retryable(CURLcode result);
+
+        // HTTP statuses worth retrying (408, 425, 429, 500, 502, 503, 504)
+        static bool is_retryable_status(long status_code);
+    };
+
+    /**
+     * @brief Retry bookkeeping for a single call
+     *
+     * Never sleeps itself: it only computes the delay, so blocking callers can
+     * sleep while async callers reschedule the transfer on the RequestLoop.
+     */
+    class RetryState {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit RetryState(const RetryPolicy& policy);
+
+        // Decide whether a failed attempt should be retried. result is the
+        // transport result and status_code the HTTP status (0 if none);
+        // retry_after is the server's Retry-After (0 if absent). On true,
+        // delay holds how long to wait before the next attempt.
+        bool should_retry(CURLcode result, long status_code,
+                          std::chrono::milliseconds retry_after, std::chrono::milliseconds& delay);
+
+        // Same decision for backends that classify failures themselves
+        bool should_retry(bool retryable, std::chrono::milliseconds retry_after,
+                          std::chrono::milliseconds& delay);
+
+        // Time left before the deadline (milliseconds::max() without one)
+        std::chrono::milliseconds remaining() const;
+
+        // Number of retries scheduled so far
+        int attempt() const { return attempt_; }
+
+    private:
+        RetryPolicy policy_;
+        int attempt_;
+        std::chrono::milliseconds previous_delay_;
+        Clock::time_point deadline_;
+        bool has_deadline_;
+
+        std::chrono::milliseconds next_backoff();
+    };
+
+} // namespace yfinance
+
+#endif // RETRY_POLICY_H
@@ -0,0 +1,71 @@
+#ifndef SNAPSHOT_STORE_H
+#define SNAPSHOT_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <optional>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+namespace yfinance {
+
+    /**
+     * @brief Directory of response documents stored in a binary encoding
+     *
+     * Reloading a cached document from JSON text means tokenizing it again;
+     * snapshots are stored as CBOR or MessagePack instead, so loading one is a
+     * single read plus a binary decode. Each snapshot is one "<name>.snap"
+     * file: a 16-byte header (magic, version, encoding, fetch time) followed
+     * by the encoded document. Files are replaced with an atomic rename, so
+     * readers never observe a partially written snapshot.
+     */
+    class SnapshotStore {
+    public:
+        enum class Format : uint8_t {
+            Cbor = 1,
+            MessagePack = 2
+        };
+
+        struct Snapshot {
+            nlohmann::json document;
+            std::time_t fetch_time = 0;  // When the document was downloaded
+        };
+
+        // Snapshots are written in the given encoding; either is read back
+        explicit SnapshotStore(const std::string& directory, Format format = Format::Cbor);
+
+        // File name (without extension) for a request; volatile parameters
+        // such as the crumb are ignored, as for FixtureStore
+        static std::string snapshot_name(const std::string& path,
+                                         const std::map<std::string, std::string>& params);
+
+        // Save a document; the directory is created if needed. Returns false on I/O failure
+        bool save(const std::string& name, const nlohmann::json& document,
+                  std::time_t fetch_time = std::time(nullptr)) const;
+
+        // Load a snapshot; nullopt if it is missing, corrupt or of an unknown version
+        std::optional<Snapshot> load(const std::string& name) const;
+
+        // Delete a snapshot
+        void remove(const std::string& name) const;
+
+        // Encode a document with its header, or decode one (throws std::runtime_error)
+        static std::string encode(const nlohmann::json& document, Format format, std::time_t fetch_time);
+        static Snapshot decode(const char* data, size_t size);
+
+        const std::string& directory() const { return directory_; }
+        Format format() const { return format_; }
+
+    private:
+        std::string directory_;
+        Format format_;
+
+        std::string snapshot_path(const std::string& name) const;
+    };
+
+} // namespace yfinance
+
+#endif // SNAPSHOT_STORE_H
@@ -0,0 +1,85 @@
+#ifndef SPAN_H
+#define SPAN_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+namespace yfinance {
+
+    /**
+     * @brief Non-owning view of a contiguous run of T (a C++17 stand-in for std::span)
+     *
+     * Used for typed access to columnar buffers: a Span<double> over a column
+     * reads and writes the values in place, a Span<const double> only reads
+     * them. A Span<T> converts implicitly to Span<const T>.
+     */
+    template <typename T>
+    class Span {
+    public:
+        using element_type = T;
+        using value_type = std::remove_cv_t<T>;
+        using size_type = size_t;
+        using iterator = T*;
+
+        constexpr Span() noexcept : data_(nullptr), size_(0) {}
+        constexpr Span(T* data, size_t size) noexcept : data_(data), size_(size) {}
+
+        template <size_t N>
+        constexpr Span(T (&array)[N]) noexcept : data_(array), size_(N) {}
+
+        // Any contiguous container (std::vector, std::array, ...)
+        template <typename Container,
+                  typename = std::enable_if_t<
+                      !std::is_same<std::decay_t<Container>, Span>::value &&
+                      std::is_convertible<decltype(std::declval<Container&>().data()), T*>::value>>
+        constexpr Span(Container& container) noexcept : data_(container.data()), size_(container.size()) {}
+
+        // Span<T> -> Span<const T>
+        template <typename U, typename = std::enable_if_t<std::is_convertible<U (*)[], T (*)[]>::value>>
+        constexpr Span(const Span<U>& other) noexcept : data_(other.data()), size_(other.size()) {}
+
+        constexpr T* data() const noexcept { return data_; }
+        constexpr size_t size() const noexcept { return size_; }
+        constexpr bool empty() const noexcept { return size_ == 0; }
+
+        constexpr T& operator[](size_t index) const { return data_[index]; }
+
+        // Bounds-checked access
+        T& at(size_t index) const {
+            if (index >= size_) {
+                throw std::out_of_range("Index out of range for Span");
+            }
+            return data_[index];
+        }
+
+        constexpr T& front() const { return data_[0]; }
+        constexpr T& back() const { return data_[size_ - 1]; }
+
+        constexpr iterator begin() const noexcept { return data_; }
+        constexpr iterator end() const noexcept { return data_ + size_; }
+
+        // Elements [offset, offset + count), clamped to the span
+        constexpr Span subspan(size_t offset, size_t count = static_cast<size_t>(-1)) const noexcept {
+            if (offset > size_) {
+                offset = size_;
+            }
+            if (count > size_ - offset) {
+                count = size_ - offset;
+            }
+            return Span(data_ + offset, count);
+        }
+
+        constexpr Span first(size_t count) const noexcept { return subspan(0, count); }
+        constexpr Span last(size_t count) const noexcept {
+            return subspan(count < size_ ? size_ - count : 0);
+        }
+
+    private:
+        T* data_;
+        size_t size_;
+    };
+
+} // namespace yfinance
+
+#endif // SPAN_H
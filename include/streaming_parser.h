@@ -0,0 +1,59 @@
+#ifndef STREAMING_PARSER_H
+#define STREAMING_PARSER_H
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <thread>
+
+namespace yfinance {
+
+    /**
+     * @brief Runs a parser over a response body while it is still downloading
+     *
+     * The consumer (e.g. a nlohmann SAX parse or ChartDecoder) runs on a worker
+     * thread and reads from a std::istream fed chunk by chunk through feed().
+     * The stream blocks until the next chunk arrives, so parsing keeps pace
+     * with the transfer and is done shortly after the last byte.
+     */
+    class StreamingParser {
+    public:
+        using Consumer = std::function<void(std::istream& input)>;
+
+        // Start the worker thread running consumer
+        explicit StreamingParser(Consumer consumer);
+
+        // Aborts if neither finish() nor abort() was called
+        ~StreamingParser();
+
+        StreamingParser(const StreamingParser&) = delete;
+        StreamingParser& operator=(const StreamingParser&) = delete;
+
+        // Hand the next chunk of the body to the consumer (copied)
+        void feed(const char* data, size_t size);
+
+        // End of the body: wait for the consumer and rethrow what it threw
+        void finish();
+
+        // Give up on this body (e.g. the transfer failed); the consumer sees
+        // the input end early and whatever it throws is discarded
+        void abort();
+
+        // Run a consumer inline over a complete body, without a thread
+        static void consume(const Consumer& consumer, const char* data, size_t size);
+
+    private:
+        class ChunkBuffer;
+
+        std::unique_ptr<ChunkBuffer> buffer_;
+        std::thread worker_;
+        std::exception_ptr error_;
+
+        void close_and_join();
+    };
+
+} // namespace yfinance
+
+#endif // STREAMING_PARSER_H
@@ -5,18 +5,32 @@
 #include <memory>
 #include <vector>
 #include <map>
+#include <future>
+#include <chrono>
 
 #include "yf_data.h"
 #include "json_parser.h"
+#include "data_structures.h"
+#include "history_store.h"
 
 namespace yfinance {
 
     /**
      * @brief Represents a single stock ticker with all its data
+     *
+     * A Ticker is a lightweight handle: the symbol plus a shared session.
+     * Construction makes no network requests, so creating thousands of them
+     * is cheap; the session handshake runs once, on the first data request.
+     *
+     * quoteSummary getters share a per-ticker module cache: each request asks
+     * for every module that is missing or queued with prefetch_modules(), and
+     * the modules in the response are kept for the module TTL, so a run of
+     * fundamentals getters costs one round-trip instead of one each.
      */
     class Ticker {
     public:
-        explicit Ticker(const std::string& symbol);
+        // Uses the process-wide session from YfData::shared() when none is given
+        explicit Ticker(const std::string& symbol, std::shared_ptr<YfData> session = nullptr);
         ~Ticker();
 
         // Get the ticker symbol
@@ -33,6 +47,35 @@ namespace yfinance {
             int rounding = 0
         );
 
+        // Fetch historical price data decoded straight into typed columns
+        // (no JSON DOM is built)
+        PriceHistory history_prices(
+            int period_days = 365,
+            const std::string& interval = "1d",
+            bool auto_adjust = true
+        );
+
+        // Bring the stored series for this symbol and interval up to date and
+        // map it: the first call downloads period_days of bars, later calls
+        // only the last stored bar (refreshed, since it may have been stored
+        // while still forming) and the ones after it. Earlier bars are never
+        // rewritten, so prices adjusted for dividends and splits go stale
+        // after the next event; the default stores unadjusted prices, with
+        // the adjusted close as of each download in adjclose
+        MappedHistory sync_history(
+            const HistoryStore& store,
+            int period_days = 365,
+            const std::string& interval = "1d",
+            bool auto_adjust = false
+        );
+
+        // Fetch historical price data asynchronously
+        std::future<nlohmann::json> history_async(
+            int period_days = 365,
+            const std::string& interval = "1d",
+            bool auto_adjust = true
+        );
+
         // Get company information
         nlohmann::json get_info();
 
@@ -108,15 +151,78 @@ namespace yfinance {
         // Get all option dates
         std::vector<std::string> get_option_dates();
 
+        // Listed option expirations, seconds since the epoch (empty for a
+        // symbol without options, as is get_option_dates())
+        std::vector<int64_t> get_option_expirations();
+
+        // Contracts of the nearest expiration decoded into columns
+        OptionChain get_option_chain();
+
+        // Contracts of one expiration (a value from get_option_expirations())
+        OptionChain get_option_chain(int64_t expiration);
+
         // Get news
         nlohmann::json get_news();
 
+        // Get financialData, summaryDetail, defaultKeyStatistics and price
+        // decoded into typed structs (raw values only)
+        QuoteSummary get_quote_summary();
+
+        // quoteSummary modules used by the fundamentals getters above
+        static const std::vector<std::string>& fundamentals_modules();
+
+        // Queue quoteSummary modules to be fetched along with the next
+        // quoteSummary request, e.g. prefetch_modules(fundamentals_modules())
+        void prefetch_modules(const std::vector<std::string>& modules);
+
+        // Get several quoteSummary modules as {"<module>": {...}}, requesting
+        // only those not cached; modules missing from the response are omitted
+        nlohmann::json get_modules(const std::vector<std::string>& modules);
+
+        // How long fetched modules are served from memory (0 disables the cache)
+        void set_module_ttl(std::chrono::milliseconds ttl);
+
+        // Drop all cached modules
+        void clear_module_cache();
+
     private:
+        struct ModuleCache;
+
         std::string symbol_;
-        std::unique_ptr<YfData> data_provider_;
+        std::shared_ptr<YfData> data_provider_;
+
+        // Created on the first quoteSummary request; shared by copies of this Ticker
+        std::shared_ptr<ModuleCache> module_cache_;
+
+        std::shared_ptr<ModuleCache> module_cache();
 
         // Helper method to validate inputs
         void validate_inputs(int period_days, const std::string& interval);
+
+        // Fetch chart events ("dividends", "splits", or "" for all of them)
+        nlohmann::json chart_events(const std::string& event_type);
+
+        // Fetch the given quoteSummary modules (comma separated) and return one
+        // of them (throws if the response lacks that module)
+        nlohmann::json quote_summary_module(const std::string& modules, const std::string& module);
+
+        // Cached or freshly requested modules as {"<module>": {...}}; null if
+        // the response carried no quoteSummary result
+        nlohmann::json fetch_modules(const std::vector<std::string>& modules);
+
+        // First entry of quoteSummary.result in a response, or nullptr
+        static nlohmann::json* quote_summary_result(nlohmann::json& response);
+
+        // Fetch /v7/finance/options and decode it into an OptionChain
+        OptionChain fetch_option_chain(const std::map<std::string, std::string>& params);
+
+        // Fetch /v8/finance/chart and decode it into a PriceHistory
+        PriceHistory fetch_prices(const std::map<std::string, std::string>& params);
+
+        // Build the /v8/finance/chart query parameters
+        std::map<std::string, std::string> history_params(int period_days,
+                                                          const std::string& interval,
+                                                          bool auto_adjust);
     };
 
 } // namespace yfinance
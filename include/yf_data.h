@@ -4,23 +4,53 @@
 #include <string>
 #include <memory>
 #include <map>
+#include <future>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <optional>
 
 #include "http_client.h"
 #include "json_parser.h"
+#include "cookie_cache.h"
+#include "snapshot_store.h"
 
 namespace yfinance {
 
     /**
      * @brief Data provider class that handles communication with Yahoo Finance API
+     *
+     * A YfData instance is a session: it owns the cookie/crumb handshake and is
+     * safe to share between threads and between many Ticker objects.
+     *
+     * Identical requests (same URL, symbol and parameters) issued while one is
+     * already in flight are coalesced: the later callers wait for the first
+     * one's response instead of sending their own.
+     *
+     * Async requests rejected with a 401 refresh the crumb and are sent once
+     * more, like sync ones, when the session is owned by a shared_ptr.
      */
-    class YfData {
+    class YfData : public std::enable_shared_from_this<YfData> {
     public:
+        // Counters for request coalescing
+        struct CoalescingStats {
+            uint64_t requests = 0;   // Requests sent to the network
+            uint64_t coalesced = 0;  // Requests answered by an identical one already in flight
+        };
+
         YfData();
         ~YfData();
 
-        // Initialize session with crumb token
+        // Process-wide session shared by Tickers created without one
+        static std::shared_ptr<YfData> shared();
+
+        // Initialize session with crumb token (always performs the handshake)
         bool init_session();
 
+        // Perform the handshake once, on first use; later calls return immediately
+        bool ensure_session();
+
         // Fetch data from Yahoo Finance API
         nlohmann::json get_raw_data(
             const std::string& symbol,
@@ -28,6 +58,30 @@ namespace yfinance {
             const std::map<std::string, std::string>& params = {}
         );
 
+        // Fetch the raw response body for decoders that parse it themselves
+        // (e.g. ChartDecoder); not coalesced with other requests
+        ResponseBuffer get_raw_buffer(
+            const std::string& symbol,
+            const std::string& path,
+            const std::map<std::string, std::string>& params = {}
+        );
+
+        // Stream the response body into a consumer while it downloads, so the
+        // body is decoded as it arrives (see HttpClient::get_streamed)
+        void get_raw_streamed(
+            const std::string& symbol,
+            const std::string& path,
+            const std::map<std::string, std::string>& params,
+            HttpClient::StreamConsumer consumer
+        );
+
+        // Fetch data asynchronously on the shared request loop
+        std::future<nlohmann::json> get_raw_data_async(
+            const std::string& symbol,
+            const std::string& path,
+            const std::map<std::string, std::string>& params = {}
+        );
+
         // Fetch data with session management
         nlohmann::json get_raw_data_with_session(
             const std::string& symbol,
@@ -39,22 +93,151 @@ namespace yfinance {
         // Cache management
         void clear_cache();
 
+        // Point the session at another server, e.g. a local replay_server
+        // (default https://query1.finance.yahoo.com); the crumb is fetched from
+        // <base_url>/v1/test/getcrumb. Cached cookies and crumbs are kept
+        // apart per base and cookie URL
+        void set_base_url(const std::string& base_url);
+
+        // URL visited first to obtain the session cookie (default https://fc.yahoo.com)
+        void set_cookie_url(const std::string& cookie_url);
+
         // Set proxy for HTTP requests
         void set_proxy(const std::string& proxy);
 
         // Set number of retries for failed requests
         void set_retries(int retries);
 
+        // Persist the cookie and crumb across processes (nullptr disables it)
+        void set_cookie_cache(std::shared_ptr<CookieCache> cache);
+
+        // Maximum age of a cached cookie/crumb; the cookie's own expiry also applies
+        void set_cookie_cache_max_age(int seconds);
+
+        // Save get_raw_data responses to a binary snapshot store and answer
+        // requests from snapshots younger than max_age_seconds without touching
+        // the network (0 only writes snapshots; nullptr disables them)
+        void set_snapshot_store(std::shared_ptr<SnapshotStore> store, int max_age_seconds = 0);
+
+        // Document last saved for a request, whatever its age
+        std::optional<nlohmann::json> load_snapshot(
+            const std::string& symbol,
+            const std::string& path,
+            const std::map<std::string, std::string>& params = {}
+        ) const;
+
+        // Enable or disable coalescing of identical in-flight requests (on by default)
+        void set_coalescing(bool enabled);
+
+        // Number of requests sent and coalesced since creation or the last reset
+        CoalescingStats coalescing_stats() const;
+        void reset_coalescing_stats();
+
     private:
         std::unique_ptr<HttpClient> http_client_;
         std::string base_url_;
+        std::string cookie_url_;
         std::string proxy_;
         int retries_;
         std::string crumb_token_;
         std::string cookie_data_;
 
+        // Guards crumb_token_ and cookie_data_
+        mutable std::mutex session_mutex_;
+
+        // Serializes the handshake so concurrent first requests run it once
+        std::mutex handshake_mutex_;
+        std::atomic<bool> session_attempted_;
+
+        // On-disk cookie/crumb cache shared with other processes
+        std::shared_ptr<CookieCache> cookie_cache_;
+        int cookie_cache_max_age_;
+
+        // Binary snapshots of get_raw_data responses (see set_snapshot_store);
+        // guarded by session_mutex_
+        std::shared_ptr<SnapshotStore> snapshot_store_;
+        int snapshot_max_age_;
+
+        // Snapshot name for a request, with the symbol parameter prepare_request adds
+        static std::string snapshot_name(const std::string& symbol,
+                                         const std::string& path,
+                                         const std::map<std::string, std::string>& params);
+
+        // Requests in flight and their waiting callers; shared with async
+        // completions so they can finish even after the session has gone away
+        using InFlightCallback = std::function<void(const nlohmann::json& result, std::exception_ptr error)>;
+        struct InFlightTable;
+        std::shared_ptr<InFlightTable> in_flight_;
+        std::atomic<bool> coalescing_enabled_;
+
         // Get crumb token for authenticated requests
         bool get_crumb_token();
+
+        // Cookie cache entry for this session's cookie and crumb hosts
+        std::string cookie_cache_key() const;
+
+        // Adopt a cached cookie/crumb instead of performing the handshake
+        bool load_cached_session();
+
+        // Save the current cookie/crumb to the cookie cache
+        void store_cached_session();
+
+        // Redo the handshake after Yahoo rejected the given crumb; returns
+        // immediately if another thread has already replaced it
+        bool refresh_session(const std::string& rejected_crumb);
+
+        // GET a response body, refreshing the session once if the crumb is rejected
+        ResponseBuffer fetch_buffer(const std::string& symbol,
+                                    const std::string& url,
+                                    const std::map<std::string, std::string>& params);
+
+        // fetch_buffer for get_streamed(): a rejected crumb fails before any
+        // body is streamed, so the retry cannot feed the consumer twice
+        void fetch_streamed(const std::string& symbol,
+                            const std::string& url,
+                            const std::map<std::string, std::string>& params,
+                            const HttpClient::StreamConsumer& consumer);
+
+        // Async counterpart of fetch_buffer: on a 401 the handshake runs on a
+        // separate thread (it blocks) and the request is submitted once more
+        void fetch_buffer_async(const std::string& symbol,
+                                const std::string& url,
+                                const std::map<std::string, std::string>& params,
+                                HttpClient::BufferCallback callback,
+                                bool refresh_on_401);
+
+        // GET and parse a JSON document through fetch_buffer
+        nlohmann::json fetch_json(const std::string& symbol,
+                                  const std::string& url,
+                                  const std::map<std::string, std::string>& params);
+
+        // GET a JSON document through fetch_json, sharing the response with
+        // identical requests issued while it is in flight. on_fetched runs
+        // once per network response, on the thread that sent the request,
+        // before the waiters are released
+        nlohmann::json fetch_coalesced(const std::string& symbol,
+                                       const std::string& url,
+                                       const std::map<std::string, std::string>& params,
+                                       const std::function<void(const nlohmann::json&)>& on_fetched = nullptr);
+
+        // Coalescing key: URL with lower-cased scheme and host, symbol and sorted params
+        static std::string request_key(const std::string& symbol,
+                                       const std::string& url,
+                                       const std::map<std::string, std::string>& params);
+
+        // Wait for an identical request if one is in flight (returns true and
+        // calls callback on completion); otherwise registers the caller as the
+        // one sending it and returns false
+        bool join_in_flight(const std::string& key, InFlightCallback callback);
+
+        // Hand the result of a request sent after join_in_flight() to its waiters
+        static void complete_in_flight(InFlightTable& table, const std::string& key,
+                                       const nlohmann::json& result, std::exception_ptr error);
+
+        // Add symbol, crumb and cookie to the request parameters and headers
+        void prepare_request(const std::string& symbol,
+                             std::map<std::string, std::string>& params,
+                             std::map<std::string, std::string>& headers) const;
     };
 
 } // namespace yfinance
@@ -6,6 +6,7 @@
 #include "http_client.h"
 #include "utils.h"
 #include "date_utils.h"
+#include "dataframe.h"
 
 // Main yfinance namespace
 namespace yfinance {
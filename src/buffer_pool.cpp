@@ -0,0 +1,107 @@
+#include "buffer_pool.h"
+
+#include <algorithm>
+
+namespace yfinance {
+
+    ResponseBuffer::~ResponseBuffer() {
+        BufferPool::instance().release(std::move(bytes_));
+    }
+
+    ResponseBuffer& ResponseBuffer::operator=(ResponseBuffer&& other) noexcept {
+        if (this != &other) {
+            BufferPool::instance().release(std::move(bytes_));
+            bytes_ = std::move(other.bytes_);
+            other.bytes_ = std::string();
+        }
+        return *this;
+    }
+
+    std::string ResponseBuffer::release() {
+        std::string bytes = std::move(bytes_);
+        bytes_ = std::string();
+        return bytes;
+    }
+
+    BufferPool& BufferPool::instance() {
+        static BufferPool pool;
+        return pool;
+    }
+
+    ResponseBuffer BufferPool::acquire(size_t size_hint) {
+        ++acquired_;
+
+        std::string storage;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!idle_.empty()) {
+                // Smallest idle buffer that fits, or else the largest one (it
+                // then grows once instead of starting from nothing)
+                auto best = idle_.end();
+                for (auto it = idle_.begin(); it != idle_.end(); ++it) {
+                    if (it->capacity() >= size_hint &&
+                        (best == idle_.end() || it->capacity() < best->capacity())) {
+                        best = it;
+                    }
+                }
+                if (best == idle_.end()) {
+                    best = std::max_element(idle_.begin(), idle_.end(),
+                                            [](const std::string& a, const std::string& b) {
+                                                return a.capacity() < b.capacity();
+                                            });
+                }
+
+                storage = std::move(*best);
+                *best = std::move(idle_.back());
+                idle_.pop_back();
+                ++reused_;
+            }
+        }
+
+        storage.clear();
+        storage.reserve(size_hint);
+        return ResponseBuffer(std::move(storage));
+    }
+
+    void BufferPool::release(std::string&& storage) {
+        // Small strings are not worth pooling
+        if (storage.capacity() < kMinPooledCapacity) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (idle_.size() < max_idle_ && storage.capacity() <= max_buffer_size_) {
+            storage.clear();
+            idle_.push_back(std::move(storage));
+        }
+    }
+
+    void BufferPool::set_max_idle(size_t max_idle) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        max_idle_ = max_idle;
+        if (idle_.size() > max_idle_) {
+            idle_.resize(max_idle_);
+        }
+    }
+
+    void BufferPool::set_max_buffer_size(size_t bytes) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        max_buffer_size_ = bytes;
+        idle_.erase(std::remove_if(idle_.begin(), idle_.end(),
+                                   [bytes](const std::string& s) { return s.capacity() > bytes; }),
+                    idle_.end());
+    }
+
+    size_t BufferPool::idle_count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return idle_.size();
+    }
+
+    BufferPool::Stats BufferPool::stats() const {
+        Stats stats;
+        stats.acquired = acquired_.load();
+        stats.reused = reused_.load();
+        return stats;
+    }
+
+} // namespace yfinance
@@ -0,0 +1,585 @@
+#include "chart_decoder.h"
+
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#ifdef USE_SIMDJSON
+#include "simdjson_input.h"
+#endif
+
+namespace yfinance {
+
+    namespace {
+
+        constexpr double kMissing = std::numeric_limits<double>::quiet_NaN();
+
+#ifdef USE_SIMDJSON
+        using simdjson::ondemand::json_type;
+
+        double number_or_missing(simdjson::ondemand::value value) {
+            return value.is_null() ? kMissing : value.get_double().value();
+        }
+
+        int64_t integer_value(simdjson::ondemand::value value) {
+            if (value.get_number_type().value() == simdjson::ondemand::number_type::floating_point_number) {
+                return static_cast<int64_t>(value.get_double().value());
+            }
+            return value.get_int64().value();
+        }
+
+        // Containers may be null where Yahoo has no data; like the SAX
+        // decoder, those are skipped
+        bool is_object(simdjson::ondemand::value value) {
+            return value.type().value() == json_type::object;
+        }
+
+        bool is_array(simdjson::ondemand::value value) {
+            return value.type().value() == json_type::array;
+        }
+
+        void read_column(simdjson::ondemand::value value, std::vector<double>& column, size_t rows) {
+            if (!is_array(value)) {
+                return;
+            }
+            column.reserve(rows);
+            for (auto element : value.get_array()) {
+                column.push_back(number_or_missing(element.value()));
+            }
+        }
+
+        void read_meta(simdjson::ondemand::object meta, ChartMeta& out) {
+            for (auto field : meta) {
+                std::string_view key = field.unescaped_key().value();
+                auto value = field.value().value();
+                // Like the SAX decoder, a null field keeps its default
+                if (value.is_null()) {
+                    continue;
+                }
+                if (key == "currency") out.currency = std::string(value.get_string().value());
+                else if (key == "symbol") out.symbol = std::string(value.get_string().value());
+                else if (key == "exchangeName") out.exchange_name = std::string(value.get_string().value());
+                else if (key == "instrumentType") out.instrument_type = std::string(value.get_string().value());
+                else if (key == "timezone") out.timezone = std::string(value.get_string().value());
+                else if (key == "exchangeTimezoneName") out.exchange_timezone_name = std::string(value.get_string().value());
+                else if (key == "dataGranularity") out.data_granularity = std::string(value.get_string().value());
+                else if (key == "range") out.range = std::string(value.get_string().value());
+                else if (key == "gmtoffset") out.gmtoffset = integer_value(value);
+                else if (key == "firstTradeDate") out.first_trade_date = integer_value(value);
+                else if (key == "regularMarketTime") out.regular_market_time = integer_value(value);
+                else if (key == "priceHint") out.price_hint = static_cast<int>(integer_value(value));
+                else if (key == "regularMarketPrice") out.regular_market_price = number_or_missing(value);
+                else if (key == "chartPreviousClose") out.chart_previous_close = number_or_missing(value);
+            }
+        }
+
+        void read_events(simdjson::ondemand::object events, PriceHistory& history) {
+            for (auto field : events) {
+                std::string_view kind = field.unescaped_key().value();
+                bool dividends = kind == "dividends";
+                auto list = field.value().value();
+                if ((!dividends && kind != "splits") || !is_object(list)) {
+                    continue;
+                }
+
+                for (auto entry : list.get_object()) {
+                    auto value = entry.value().value();
+                    if (!is_object(value)) {
+                        continue;
+                    }
+                    if (dividends) {
+                        DividendEvent event;
+                        for (auto member : value.get_object()) {
+                            std::string_view key = member.unescaped_key().value();
+                            auto value = member.value().value();
+                            if (value.is_null()) continue;
+                            if (key == "amount") event.amount = value.get_double().value();
+                            else if (key == "date") event.date = integer_value(value);
+                        }
+                        history.dividends.push_back(event);
+                    } else {
+                        SplitEvent event;
+                        for (auto member : value.get_object()) {
+                            std::string_view key = member.unescaped_key().value();
+                            auto value = member.value().value();
+                            if (value.is_null()) continue;
+                            if (key == "numerator") event.numerator = value.get_double().value();
+                            else if (key == "denominator") event.denominator = value.get_double().value();
+                            else if (key == "date") event.date = integer_value(value);
+                            else if (key == "splitRatio") event.ratio = std::string(value.get_string().value());
+                        }
+                        history.splits.push_back(std::move(event));
+                    }
+                }
+            }
+        }
+
+        void read_indicators(simdjson::ondemand::object indicators, PriceHistory& history) {
+            size_t rows = history.timestamp.size();
+            for (auto field : indicators) {
+                std::string_view key = field.unescaped_key().value();
+                auto list = field.value().value();
+                if ((key != "quote" && key != "adjclose") || !is_array(list)) {
+                    continue;
+                }
+
+                // Only the first element of each list carries data
+                for (auto element : list.get_array()) {
+                    auto columns = element.value();
+                    if (!is_object(columns)) {
+                        break;
+                    }
+                    for (auto column : columns.get_object()) {
+                        std::string_view name = column.unescaped_key().value();
+                        std::vector<double>* target = nullptr;
+                        if (key == "adjclose") target = name == "adjclose" ? &history.adjclose : nullptr;
+                        else if (name == "open") target = &history.open;
+                        else if (name == "high") target = &history.high;
+                        else if (name == "low") target = &history.low;
+                        else if (name == "close") target = &history.close;
+                        else if (name == "volume") target = &history.volume;
+
+                        if (target) {
+                            read_column(column.value().value(), *target, rows);
+                        }
+                    }
+                    break;
+                }
+            }
+        }
+
+        // On-demand decoding: walks the fields in document order and reads
+        // the number arrays directly into the columns
+        bool decode_simdjson(const char* data, size_t size, PriceHistory& history, std::string& error) {
+            auto doc = thread_parser().iterate(padded_input(data, size)).value();
+
+            bool has_result = false;
+            for (auto chart_field : doc.get_object()) {
+                auto chart = chart_field.value().value();
+                if (chart_field.unescaped_key().value() != "chart" || !is_object(chart)) {
+                    continue;
+                }
+
+                for (auto field : chart.get_object()) {
+                    std::string_view key = field.unescaped_key().value();
+                    auto value = field.value().value();
+
+                    if (key == "error" && is_object(value)) {
+                        for (auto member : value.get_object()) {
+                            std::string_view name = member.unescaped_key().value();
+                            auto text = member.value().value();
+                            if (!text.is_null() && (name == "description" || (name == "code" && error.empty()))) {
+                                error = std::string(text.get_string().value());
+                            }
+                        }
+                    } else if (key == "result" && is_array(value)) {
+                        for (auto result : value.get_array()) {
+                            auto members = result.value();
+                            if (!is_object(members)) {
+                                break;
+                            }
+                            has_result = true;
+                            for (auto member : members.get_object()) {
+                                std::string_view name = member.unescaped_key().value();
+                                auto field_value = member.value().value();
+                                if (name == "meta" && is_object(field_value)) {
+                                    read_meta(field_value.get_object().value(), history.meta);
+                                } else if (name == "timestamp" && is_array(field_value)) {
+                                    for (auto ts : field_value.get_array()) {
+                                        // A null timestamp cannot be represented; keep the rows aligned
+                                        auto value = ts.value();
+                                        history.timestamp.push_back(value.is_null() ? 0 : integer_value(value));
+                                    }
+                                } else if (name == "events" && is_object(field_value)) {
+                                    read_events(field_value.get_object().value(), history);
+                                } else if (name == "indicators" && is_object(field_value)) {
+                                    read_indicators(field_value.get_object().value(), history);
+                                }
+                            }
+                            break;
+                        }
+                    }
+                }
+            }
+            return has_result;
+        }
+#endif
+
+        /**
+         * SAX handler tracking where in the chart document it is through a
+         * stack of contexts. Containers that are not needed are pushed as
+         * Skip, so their contents cost a context check each and nothing more.
+         */
+        class ChartHandler : public nlohmann::json_sax<nlohmann::json> {
+        public:
+            explicit ChartHandler(PriceHistory& history) : history_(history) {}
+
+            bool null() override {
+                if (context() == Context::Column) {
+                    push_number(kMissing);
+                }
+                return true;
+            }
+
+            bool boolean(bool /*value*/) override {
+                return true;
+            }
+
+            bool number_integer(number_integer_t value) override {
+                return on_integer(static_cast<int64_t>(value));
+            }
+
+            bool number_unsigned(number_unsigned_t value) override {
+                return on_integer(static_cast<int64_t>(value));
+            }
+
+            bool number_float(number_float_t value, const string_t& /*text*/) override {
+                switch (context()) {
+                    case Context::Column:
+                        push_number(value);
+                        break;
+                    case Context::Meta:
+                        meta_number(value);
+                        break;
+                    case Context::Dividend:
+                        dividend_number(value);
+                        break;
+                    case Context::Split:
+                        split_number(value);
+                        break;
+                    default:
+                        break;
+                }
+                return true;
+            }
+
+            bool string(string_t& value) override {
+                switch (context()) {
+                    case Context::Meta:
+                        meta_string(value);
+                        break;
+                    case Context::Split:
+                        if (key_ == "splitRatio") {
+                            history_.splits.back().ratio = std::move(value);
+                        }
+                        break;
+                    case Context::Error:
+                        if (key_ == "description" || (key_ == "code" && error_.empty())) {
+                            error_ = value;
+                        }
+                        break;
+                    default:
+                        break;
+                }
+                return true;
+            }
+
+            bool binary(binary_t& /*value*/) override {
+                return true;
+            }
+
+            bool start_object(std::size_t /*elements*/) override {
+                Context parent = context();
+                Context child = Context::Skip;
+
+                switch (parent) {
+                    case Context::Root:
+                        // The document itself, then its "chart" member
+                        if (stack_.empty()) {
+                            child = Context::Root;
+                        } else if (key_ == "chart") {
+                            child = Context::Chart;
+                        }
+                        break;
+                    case Context::Chart:
+                        child = key_ == "error" ? Context::Error : Context::Skip;
+                        break;
+                    case Context::ResultList:
+                        child = results_++ == 0 ? Context::Result : Context::Skip;
+                        break;
+                    case Context::Result:
+                        if (key_ == "meta") {
+                            child = Context::Meta;
+                        } else if (key_ == "events") {
+                            child = Context::Events;
+                        } else if (key_ == "indicators") {
+                            child = Context::Indicators;
+                        }
+                        break;
+                    case Context::Events:
+                        if (key_ == "dividends") {
+                            child = Context::Dividends;
+                        } else if (key_ == "splits") {
+                            child = Context::Splits;
+                        }
+                        break;
+                    case Context::Dividends:
+                        history_.dividends.emplace_back();
+                        child = Context::Dividend;
+                        break;
+                    case Context::Splits:
+                        history_.splits.emplace_back();
+                        child = Context::Split;
+                        break;
+                    case Context::QuoteList:
+                        child = quotes_++ == 0 ? Context::Quote : Context::Skip;
+                        break;
+                    case Context::AdjcloseList:
+                        child = adjcloses_++ == 0 ? Context::Adjclose : Context::Skip;
+                        break;
+                    default:
+                        break;
+                }
+
+                stack_.push_back(child);
+                return true;
+            }
+
+            bool key(string_t& value) override {
+                key_ = std::move(value);
+                return true;
+            }
+
+            bool end_object() override {
+                stack_.pop_back();
+                return true;
+            }
+
+            bool start_array(std::size_t /*elements*/) override {
+                Context parent = context();
+                Context child = Context::Skip;
+
+                switch (parent) {
+                    case Context::Chart:
+                        if (key_ == "result") {
+                            child = Context::ResultList;
+                        }
+                        break;
+                    case Context::Result:
+                        if (key_ == "timestamp") {
+                            child = Context::Column;
+                            integer_column_ = &history_.timestamp;
+                        }
+                        break;
+                    case Context::Indicators:
+                        if (key_ == "quote") {
+                            child = Context::QuoteList;
+                        } else if (key_ == "adjclose") {
+                            child = Context::AdjcloseList;
+                        }
+                        break;
+                    case Context::Quote:
+                        if ((column_ = quote_column(key_)) != nullptr) {
+                            child = Context::Column;
+                        }
+                        break;
+                    case Context::Adjclose:
+                        if (key_ == "adjclose") {
+                            column_ = &history_.adjclose;
+                            child = Context::Column;
+                        }
+                        break;
+                    default:
+                        break;
+                }
+
+                // Timestamps come first, so the other columns can be sized up front
+                if (child == Context::Column && column_) {
+                    column_->reserve(history_.timestamp.size());
+                }
+
+                stack_.push_back(child);
+                return true;
+            }
+
+            bool end_array() override {
+                if (context() == Context::Column) {
+                    column_ = nullptr;
+                    integer_column_ = nullptr;
+                }
+                stack_.pop_back();
+                return true;
+            }
+
+            bool parse_error(std::size_t /*position*/, const std::string& /*last_token*/,
+                             const nlohmann::detail::exception& ex) override {
+                throw std::runtime_error("JSON parse error: " + std::string(ex.what()));
+            }
+
+            const std::string& error() const { return error_; }
+            bool has_result() const { return results_ > 0; }
+
+        private:
+            enum class Context {
+                Root, Chart, Error, ResultList, Result, Meta,
+                Events, Dividends, Dividend, Splits, Split,
+                Indicators, QuoteList, Quote, AdjcloseList, Adjclose,
+                Column, Skip
+            };
+
+            PriceHistory& history_;
+            std::vector<Context> stack_;
+            std::string key_;
+            std::string error_;
+
+            // Destination of the array being read (Context::Column)
+            std::vector<double>* column_ = nullptr;
+            std::vector<int64_t>* integer_column_ = nullptr;
+
+            int results_ = 0;
+            int quotes_ = 0;
+            int adjcloses_ = 0;
+
+            Context context() const {
+                return stack_.empty() ? Context::Root : stack_.back();
+            }
+
+            std::vector<double>* quote_column(const std::string& name) {
+                if (name == "open") return &history_.open;
+                if (name == "high") return &history_.high;
+                if (name == "low") return &history_.low;
+                if (name == "close") return &history_.close;
+                if (name == "volume") return &history_.volume;
+                return nullptr;
+            }
+
+            void push_number(double value) {
+                if (column_) {
+                    column_->push_back(value);
+                } else if (integer_column_) {
+                    // A null timestamp cannot be represented; keep the rows aligned
+                    integer_column_->push_back(std::isnan(value) ? 0 : static_cast<int64_t>(value));
+                }
+            }
+
+            bool on_integer(int64_t value) {
+                switch (context()) {
+                    case Context::Column:
+                        if (integer_column_) {
+                            integer_column_->push_back(value);
+                        } else {
+                            push_number(static_cast<double>(value));
+                        }
+                        break;
+                    case Context::Meta:
+                        meta_integer(value);
+                        break;
+                    case Context::Dividend:
+                        dividend_number(static_cast<double>(value));
+                        break;
+                    case Context::Split:
+                        split_number(static_cast<double>(value));
+                        break;
+                    default:
+                        break;
+                }
+                return true;
+            }
+
+            void meta_string(std::string& value) {
+                ChartMeta& meta = history_.meta;
+                if (key_ == "currency") meta.currency = std::move(value);
+                else if (key_ == "symbol") meta.symbol = std::move(value);
+                else if (key_ == "exchangeName") meta.exchange_name = std::move(value);
+                else if (key_ == "instrumentType") meta.instrument_type = std::move(value);
+                else if (key_ == "timezone") meta.timezone = std::move(value);
+                else if (key_ == "exchangeTimezoneName") meta.exchange_timezone_name = std::move(value);
+                else if (key_ == "dataGranularity") meta.data_granularity = std::move(value);
+                else if (key_ == "range") meta.range = std::move(value);
+            }
+
+            void meta_integer(int64_t value) {
+                ChartMeta& meta = history_.meta;
+                if (key_ == "gmtoffset") meta.gmtoffset = value;
+                else if (key_ == "firstTradeDate") meta.first_trade_date = value;
+                else if (key_ == "regularMarketTime") meta.regular_market_time = value;
+                else if (key_ == "priceHint") meta.price_hint = static_cast<int>(value);
+                else meta_number(static_cast<double>(value));
+            }
+
+            void meta_number(double value) {
+                ChartMeta& meta = history_.meta;
+                if (key_ == "regularMarketPrice") meta.regular_market_price = value;
+                else if (key_ == "chartPreviousClose") meta.chart_previous_close = value;
+            }
+
+            void dividend_number(double value) {
+                DividendEvent& dividend = history_.dividends.back();
+                if (key_ == "amount") dividend.amount = value;
+                else if (key_ == "date") dividend.date = static_cast<int64_t>(value);
+            }
+
+            void split_number(double value) {
+                SplitEvent& split = history_.splits.back();
+                if (key_ == "numerator") split.numerator = value;
+                else if (key_ == "denominator") split.denominator = value;
+                else if (key_ == "date") split.date = static_cast<int64_t>(value);
+            }
+        };
+
+        // Reject error responses and keep every column aligned with the
+        // timestamps even if the response left one out (e.g. no volume for
+        // some indices)
+        void finish_history(PriceHistory& history, const std::string& error, bool has_result) {
+            if (!error.empty()) {
+                throw std::runtime_error("Chart request failed: " + error);
+            }
+            if (!has_result) {
+                throw std::runtime_error("Chart response contains no result");
+            }
+
+            size_t rows = history.timestamp.size();
+            for (auto* column : {&history.open, &history.high, &history.low, &history.close, &history.volume}) {
+                column->resize(rows, kMissing);
+            }
+            if (!history.adjclose.empty()) {
+                history.adjclose.resize(rows, kMissing);
+            }
+        }
+
+    } // namespace
+
+    PriceHistory ChartDecoder::decode(const char* data, size_t size) {
+        PriceHistory history;
+
+#ifdef USE_SIMDJSON
+        std::string error;
+        bool has_result = false;
+        try {
+            has_result = decode_simdjson(data, size, history, error);
+        } catch (const simdjson::simdjson_error& e) {
+            throw std::runtime_error("JSON parse error: " + std::string(e.what()));
+        }
+        finish_history(history, error, has_result);
+#else
+        ChartHandler handler(history);
+        nlohmann::json::sax_parse(data, data + size, &handler);
+        finish_history(history, handler.error(), handler.has_result());
+#endif
+
+        return history;
+    }
+
+    PriceHistory ChartDecoder::decode(std::istream& input) {
+#ifdef USE_SIMDJSON
+        // The on-demand parser needs the whole document; collect it first
+        std::string payload((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+        return decode(payload.data(), payload.size());
+#else
+        PriceHistory history;
+        ChartHandler handler(history);
+        nlohmann::json::sax_parse(input, &handler);
+        finish_history(history, handler.error(), handler.has_result());
+        return history;
+#endif
+    }
+
+    PriceHistory ChartDecoder::decode(const std::string& payload) {
+        return decode(payload.data(), payload.size());
+    }
+
+} // namespace yfinance
@@ -0,0 +1,119 @@
+#include "connection_pool.h"
+
+namespace yfinance {
+
+    ConnectionPool& ConnectionPool::instance() {
+        static ConnectionPool pool;
+        return pool;
+    }
+
+    ConnectionPool::ConnectionPool() : share_(nullptr), async_share_(nullptr), max_idle_(64) {
+        curl_global_init(CURL_GLOBAL_DEFAULT);
+
+        share_ = create_share(true);
+        async_share_ = create_share(false);
+    }
+
+    CURLSH* ConnectionPool::create_share(bool share_connections) {
+        CURLSH* share = curl_share_init();
+        if (share) {
+            curl_share_setopt(share, CURLSHOPT_LOCKFUNC, lock_share);
+            curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, unlock_share);
+            curl_share_setopt(share, CURLSHOPT_USERDATA, this);
+
+            // Share everything that makes a new request expensive: name
+            // resolution, TLS session resumption and live keep-alive connections
+            curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+            curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+            if (share_connections) {
+                curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+            }
+        }
+        return share;
+    }
+
+    ConnectionPool::~ConnectionPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (CURL* handle : idle_) {
+                curl_easy_cleanup(handle);
+            }
+            idle_.clear();
+        }
+
+        if (share_) {
+            curl_share_cleanup(share_);
+            share_ = nullptr;
+        }
+        if (async_share_) {
+            curl_share_cleanup(async_share_);
+            async_share_ = nullptr;
+        }
+        curl_global_cleanup();
+    }
+
+    CURL* ConnectionPool::acquire() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!idle_.empty()) {
+                CURL* handle = idle_.back();
+                idle_.pop_back();
+                return handle;
+            }
+        }
+
+        CURL* handle = curl_easy_init();
+        if (handle && share_) {
+            curl_easy_setopt(handle, CURLOPT_SHARE, share_);
+        }
+        return handle;
+    }
+
+    void ConnectionPool::release(CURL* handle) {
+        if (!handle) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (idle_.size() < max_idle_) {
+                idle_.push_back(handle);
+                return;
+            }
+        }
+
+        curl_easy_cleanup(handle);
+    }
+
+    void ConnectionPool::set_max_idle(size_t max_idle) {
+        std::vector<CURL*> excess;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            max_idle_ = max_idle;
+            while (idle_.size() > max_idle_) {
+                excess.push_back(idle_.back());
+                idle_.pop_back();
+            }
+        }
+
+        for (CURL* handle : excess) {
+            curl_easy_cleanup(handle);
+        }
+    }
+
+    size_t ConnectionPool::idle_count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return idle_.size();
+    }
+
+    void ConnectionPool::lock_share(CURL* /*handle*/, curl_lock_data data, curl_lock_access /*access*/, void* userptr) {
+        auto* pool = static_cast<ConnectionPool*>(userptr);
+        pool->share_locks_[data].lock();
+    }
+
+    void ConnectionPool::unlock_share(CURL* /*handle*/, curl_lock_data data, void* userptr) {
+        auto* pool = static_cast<ConnectionPool*>(userptr);
+        pool->share_locks_[data].unlock();
+    }
+
+} // namespace yfinance
@@ -0,0 +1,172 @@
+#include "cookie_cache.h"
+#include "json_parser.h"
+#include "date_utils.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+namespace yfinance {
+
+    namespace {
+
+        // Holds an flock on the cache lock file for the lifetime of the object
+        class FileLock {
+        public:
+            FileLock(const std::string& path, int operation) : fd_(::open(path.c_str(), O_RDWR | O_CREAT, 0644)) {
+                if (fd_ >= 0 && ::flock(fd_, operation) != 0) {
+                    ::close(fd_);
+                    fd_ = -1;
+                }
+            }
+
+            ~FileLock() {
+                if (fd_ >= 0) {
+                    ::flock(fd_, LOCK_UN);
+                    ::close(fd_);
+                }
+            }
+
+            FileLock(const FileLock&) = delete;
+            FileLock& operator=(const FileLock&) = delete;
+
+            bool locked() const { return fd_ >= 0; }
+
+        private:
+            int fd_;
+        };
+
+    } // namespace
+
+    CookieCache::CookieCache() : cache_dir_(default_location()) {}
+
+    CookieCache::CookieCache(const std::string& cache_dir) : cache_dir_(cache_dir) {}
+
+    std::string CookieCache::default_location() {
+        const char* xdg_cache = std::getenv("XDG_CACHE_HOME");
+        if (xdg_cache && *xdg_cache) {
+            return std::string(xdg_cache) + "/yfinance-cpp";
+        }
+
+        const char* home = std::getenv("HOME");
+        if (home && *home) {
+            return std::string(home) + "/.cache/yfinance-cpp";
+        }
+
+        return (std::filesystem::temp_directory_path() / "yfinance-cpp").string();
+    }
+
+    std::optional<CookieCache::Entry> CookieCache::lookup(const std::string& strategy) const {
+        if (!ensure_directory()) {
+            return std::nullopt;
+        }
+
+        std::string contents;
+        {
+            FileLock lock(lock_path(), LOCK_SH);
+            if (!lock.locked()) {
+                return std::nullopt;
+            }
+
+            std::ifstream file(entry_path(strategy));
+            if (!file) {
+                return std::nullopt;
+            }
+            std::ostringstream buffer;
+            buffer << file.rdbuf();
+            contents = buffer.str();
+        }
+
+        try {
+            auto doc = JsonParser::parse(contents);
+
+            Entry entry;
+            entry.cookie = doc.at("cookie").get<std::string>();
+            entry.crumb = doc.at("crumb").get<std::string>();
+            entry.fetch_time = doc.at("fetch_time").get<std::time_t>();
+            entry.expires = doc.at("expires").get<std::time_t>();
+
+            if (entry.crumb.empty() || entry.expires <= DateUtils::now()) {
+                return std::nullopt;
+            }
+            return entry;
+        } catch (const std::exception&) {
+            // A corrupt entry is treated as a cache miss
+            return std::nullopt;
+        }
+    }
+
+    bool CookieCache::store(const std::string& strategy, const Entry& entry) {
+        if (!ensure_directory()) {
+            return false;
+        }
+
+        nlohmann::json doc;
+        doc["cookie"] = entry.cookie;
+        doc["crumb"] = entry.crumb;
+        doc["fetch_time"] = entry.fetch_time;
+        doc["expires"] = entry.expires;
+
+        FileLock lock(lock_path(), LOCK_EX);
+        if (!lock.locked()) {
+            return false;
+        }
+
+        // Write to a process-private temp file, then atomically replace the entry
+        std::string path = entry_path(strategy);
+        std::string temp_path = path + ".tmp." + std::to_string(::getpid());
+        {
+            // The entry holds session credentials, so keep it private to the user
+            int fd = ::open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+            if (fd < 0) {
+                return false;
+            }
+
+            std::string contents = JsonParser::stringify(doc);
+            bool written = ::write(fd, contents.data(), contents.size()) == static_cast<ssize_t>(contents.size());
+            ::close(fd);
+            if (!written) {
+                std::remove(temp_path.c_str());
+                return false;
+            }
+        }
+
+        if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+            std::remove(temp_path.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    void CookieCache::remove(const std::string& strategy) {
+        if (!ensure_directory()) {
+            return;
+        }
+
+        FileLock lock(lock_path(), LOCK_EX);
+        std::remove(entry_path(strategy).c_str());
+    }
+
+    std::string CookieCache::entry_path(const std::string& strategy) const {
+        return cache_dir_ + "/cookie-" + strategy + ".json";
+    }
+
+    std::string CookieCache::lock_path() const {
+        return cache_dir_ + "/cookies.lock";
+    }
+
+    bool CookieCache::ensure_directory() const {
+        std::error_code ec;
+        if (std::filesystem::is_directory(cache_dir_, ec)) {
+            return ::access(cache_dir_.c_str(), R_OK | W_OK) == 0;
+        }
+        return std::filesystem::create_directories(cache_dir_, ec) && !ec;
+    }
+
+} // namespace yfinance
@@ -1,27 +1,74 @@
 #include "data_structures.h"
-#include <iostream>
+#include "date_utils.h"
+
+#include <algorithm>
 
 namespace yfinance {
 
-    void DataFrame::print() const {
-        // Print column headers
-        for (const auto& col_name : column_names_) {
-            std::cout << col_name << "\t";
+    namespace {
+
+        // Copy rows [begin, end) of a column; columns shorter than the
+        // timestamps (e.g. an absent adjclose) keep only what they have
+        std::vector<double> slice(const std::vector<double>& column, size_t begin, size_t end) {
+            begin = std::min(begin, column.size());
+            end = std::min(end, column.size());
+            return std::vector<double>(column.begin() + begin, column.begin() + end);
+        }
+
+    } // namespace
+
+    size_t PriceHistory::lower_bound(int64_t t) const {
+        return static_cast<size_t>(std::lower_bound(timestamp.begin(), timestamp.end(), t) - timestamp.begin());
+    }
+
+    std::optional<size_t> PriceHistory::asof(int64_t t) const {
+        size_t after = static_cast<size_t>(std::upper_bound(timestamp.begin(), timestamp.end(), t) - timestamp.begin());
+        if (after == 0) {
+            return std::nullopt;
+        }
+        return after - 1;
+    }
+
+    std::pair<size_t, size_t> PriceHistory::index_range(int64_t start, int64_t end) const {
+        if (end <= start) {
+            return {0, 0};
         }
-        std::cout << std::endl;
-        
-        // Print each row
-        for (size_t row_idx = 0; row_idx < num_rows_; ++row_idx) {
-            for (const auto& col : columns_) {
-                DataValue val = (*col)[row_idx];
-                
-                // Print the value based on its type
-                std::visit([](const auto& value) {
-                    std::cout << value << "\t";
-                }, val);
+        size_t first = lower_bound(start);
+        auto last = std::lower_bound(timestamp.begin() + first, timestamp.end(), end);
+        return {first, static_cast<size_t>(last - timestamp.begin())};
+    }
+
+    PriceHistory PriceHistory::between(int64_t start, int64_t end) const {
+        PriceHistory range;
+        range.meta = meta;
+
+        auto [first, last] = index_range(start, end);
+        range.timestamp.assign(timestamp.begin() + first, timestamp.begin() + last);
+        range.open = slice(open, first, last);
+        range.high = slice(high, first, last);
+        range.low = slice(low, first, last);
+        range.close = slice(close, first, last);
+        range.adjclose = slice(adjclose, first, last);
+        range.volume = slice(volume, first, last);
+
+        for (const auto& dividend : dividends) {
+            if (dividend.date >= start && dividend.date < end) {
+                range.dividends.push_back(dividend);
             }
-            std::cout << std::endl;
         }
+        for (const auto& split : splits) {
+            if (split.date >= start && split.date < end) {
+                range.splits.push_back(split);
+            }
+        }
+        return range;
+    }
+
+    std::string PriceHistory::format_time(size_t index, const std::string& format) const {
+        if (index >= timestamp.size()) {
+            throw std::out_of_range("Index out of range for PriceHistory");
+        }
+        return DateUtils::format_epoch(timestamp[index], meta.gmtoffset, format);
     }
 
-} // namespace yfinance
\ No newline at end of file
+} // namespace yfinance
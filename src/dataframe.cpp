@@ -0,0 +1,458 @@
+#include "dataframe.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <utility>
+
+namespace yfinance {
+
+    namespace {
+
+        constexpr double kNull = std::numeric_limits<double>::quiet_NaN();
+
+        size_t round_up(size_t bytes) {
+            return (bytes + kColumnAlignment - 1) / kColumnAlignment * kColumnAlignment;
+        }
+
+        uint8_t* allocate(size_t bytes) {
+            return static_cast<uint8_t*>(::operator new(bytes, std::align_val_t(kColumnAlignment)));
+        }
+
+        void deallocate(uint8_t* data) {
+            if (data) {
+                ::operator delete(data, std::align_val_t(kColumnAlignment));
+            }
+        }
+
+    } // namespace
+
+    AlignedBuffer::~AlignedBuffer() {
+        deallocate(data_);
+    }
+
+    AlignedBuffer::AlignedBuffer(const AlignedBuffer& other) : AlignedBuffer() {
+        append(other.data_, other.size_);
+    }
+
+    AlignedBuffer& AlignedBuffer::operator=(const AlignedBuffer& other) {
+        if (this != &other) {
+            size_ = 0;
+            append(other.data_, other.size_);
+        }
+        return *this;
+    }
+
+    AlignedBuffer::AlignedBuffer(AlignedBuffer&& other) noexcept
+        : data_(other.data_), size_(other.size_), capacity_(other.capacity_) {
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.capacity_ = 0;
+    }
+
+    AlignedBuffer& AlignedBuffer::operator=(AlignedBuffer&& other) noexcept {
+        if (this != &other) {
+            deallocate(data_);
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.data_ = nullptr;
+            other.size_ = 0;
+            other.capacity_ = 0;
+        }
+        return *this;
+    }
+
+    void AlignedBuffer::grow(size_t bytes) {
+        size_t capacity = round_up(std::max(bytes, capacity_ * 2));
+        uint8_t* data = allocate(capacity);
+        if (size_ > 0) {
+            std::memcpy(data, data_, size_);
+        }
+        deallocate(data_);
+        data_ = data;
+        capacity_ = capacity;
+    }
+
+    void AlignedBuffer::reserve(size_t bytes) {
+        if (bytes > capacity_) {
+            uint8_t* data = allocate(round_up(bytes));
+            if (size_ > 0) {
+                std::memcpy(data, data_, size_);
+            }
+            deallocate(data_);
+            data_ = data;
+            capacity_ = round_up(bytes);
+        }
+    }
+
+    void AlignedBuffer::resize(size_t bytes) {
+        if (bytes > capacity_) {
+            grow(bytes);
+        }
+        if (bytes > size_) {
+            std::memset(data_ + size_, 0, bytes - size_);
+        }
+        size_ = bytes;
+    }
+
+    void AlignedBuffer::append(const void* bytes, size_t count) {
+        if (count == 0) {
+            return;
+        }
+        if (size_ + count > capacity_) {
+            grow(size_ + count);
+        }
+        std::memcpy(data_ + size_, bytes, count);
+        size_ += count;
+    }
+
+    void ValidityBitmap::set(size_t index, bool valid) {
+        uint8_t& byte = bits_.data()[index >> 3];
+        uint8_t mask = static_cast<uint8_t>(1u << (index & 7));
+        bool was_valid = (byte & mask) != 0;
+        if (was_valid == valid) {
+            return;
+        }
+        if (valid) {
+            byte |= mask;
+            --null_count_;
+        } else {
+            byte &= static_cast<uint8_t>(~mask);
+            ++null_count_;
+        }
+    }
+
+    void ValidityBitmap::push_back(bool valid) {
+        if ((size_ & 7) == 0) {
+            uint8_t zero = 0;
+            bits_.append(&zero, 1);
+        }
+        if (valid) {
+            bits_.data()[size_ >> 3] |= static_cast<uint8_t>(1u << (size_ & 7));
+        } else {
+            ++null_count_;
+        }
+        ++size_;
+    }
+
+    void ValidityBitmap::resize(size_t size, bool valid) {
+        if (size < size_) {
+            for (size_t i = size; i < size_; ++i) {
+                null_count_ -= test(i) ? 0 : 1;
+            }
+            size_ = size;
+            bits_.resize((size + 7) / 8);
+            // Keep the bits past the end clear so push_back can OR into them
+            if (size & 7) {
+                bits_.data()[size >> 3] &= static_cast<uint8_t>((1u << (size & 7)) - 1);
+            }
+            return;
+        }
+
+        size_t old_size = size_;
+        bits_.resize((size + 7) / 8);
+        size_ = size;
+        if (valid) {
+            for (size_t i = old_size; i < size; ++i) {
+                // Whole bytes at once once the index is byte-aligned
+                if ((i & 7) == 0 && i + 8 <= size) {
+                    bits_.data()[i >> 3] = 0xff;
+                    i += 7;
+                } else {
+                    bits_.data()[i >> 3] |= static_cast<uint8_t>(1u << (i & 7));
+                }
+            }
+        } else {
+            null_count_ += size - old_size;
+        }
+    }
+
+    void ValidityBitmap::reserve(size_t size) {
+        bits_.reserve((size + 7) / 8);
+    }
+
+    void ValidityBitmap::clear() {
+        bits_.clear();
+        size_ = 0;
+        null_count_ = 0;
+    }
+
+    const char* column_type_name(ColumnType type) {
+        switch (type) {
+            case ColumnType::Double: return "double";
+            case ColumnType::Int64: return "int64";
+            case ColumnType::Timestamp: return "timestamp";
+            case ColumnType::Bool: return "bool";
+            case ColumnType::String: return "string";
+        }
+        return "unknown";
+    }
+
+    Column::Column(std::string name, ColumnType type) : name_(std::move(name)), type_(type) {}
+
+    size_t Column::width() const {
+        switch (type_) {
+            case ColumnType::Double: return sizeof(double);
+            case ColumnType::Int64:
+            case ColumnType::Timestamp: return sizeof(int64_t);
+            case ColumnType::Bool: return sizeof(uint8_t);
+            case ColumnType::String: return sizeof(int32_t);
+        }
+        return 0;
+    }
+
+    void Column::throw_type_mismatch() const {
+        throw std::invalid_argument("Column '" + name_ + "' holds " + column_type_name(type_) + " values");
+    }
+
+    std::string_view Column::string_at(size_t row) const {
+        int32_t code = codes().at(row);
+        return is_valid(row) ? std::string_view(dictionary_[static_cast<size_t>(code)]) : std::string_view();
+    }
+
+    void Column::append_double(double value) {
+        if (type_ != ColumnType::Double) {
+            throw_type_mismatch();
+        }
+        values_.append(&value, sizeof(value));
+        validity_.push_back(!std::isnan(value));
+    }
+
+    void Column::append_int64(int64_t value) {
+        if (type_ != ColumnType::Int64 && type_ != ColumnType::Timestamp) {
+            throw_type_mismatch();
+        }
+        values_.append(&value, sizeof(value));
+        validity_.push_back(true);
+    }
+
+    void Column::append_bool(bool value) {
+        if (type_ != ColumnType::Bool) {
+            throw_type_mismatch();
+        }
+        uint8_t byte = value ? 1 : 0;
+        values_.append(&byte, sizeof(byte));
+        validity_.push_back(true);
+    }
+
+    void Column::append_string(std::string_view value) {
+        if (type_ != ColumnType::String) {
+            throw_type_mismatch();
+        }
+
+        int32_t code;
+        auto it = dictionary_index_.find(value);
+        if (it != dictionary_index_.end()) {
+            code = it->second;
+        } else {
+            code = static_cast<int32_t>(dictionary_.size());
+            dictionary_.emplace_back(value);
+            dictionary_index_.emplace(dictionary_.back(), code);
+        }
+        values_.append(&code, sizeof(code));
+        validity_.push_back(true);
+    }
+
+    void Column::append_null() {
+        values_.resize(values_.size() + width());
+        validity_.push_back(false);
+        clear_value(size() - 1);
+    }
+
+    void Column::append_doubles(Span<const double> values) {
+        if (type_ != ColumnType::Double) {
+            throw_type_mismatch();
+        }
+        values_.append(values.data(), values.size() * sizeof(double));
+        validity_.reserve(validity_.size() + values.size());
+        for (double value : values) {
+            validity_.push_back(!std::isnan(value));
+        }
+    }
+
+    void Column::append_int64s(Span<const int64_t> values) {
+        if (type_ != ColumnType::Int64 && type_ != ColumnType::Timestamp) {
+            throw_type_mismatch();
+        }
+        values_.append(values.data(), values.size() * sizeof(int64_t));
+        validity_.resize(validity_.size() + values.size(), true);
+    }
+
+    void Column::clear_value(size_t row) {
+        if (type_ == ColumnType::Double) {
+            std::memcpy(values_.data() + row * sizeof(double), &kNull, sizeof(double));
+        } else {
+            std::memset(values_.data() + row * width(), 0, width());
+        }
+    }
+
+    void Column::set_valid(size_t row, bool valid) {
+        if (row >= size()) {
+            throw std::out_of_range("Row index out of range for column '" + name_ + "'");
+        }
+        validity_.set(row, valid);
+        if (!valid) {
+            clear_value(row);
+        }
+    }
+
+    void Column::reserve(size_t rows) {
+        values_.reserve(rows * width());
+        validity_.reserve(rows);
+    }
+
+    void Column::resize(size_t rows) {
+        size_t old_size = size();
+        values_.resize(rows * width());
+        validity_.resize(rows, false);
+        if (type_ == ColumnType::Double) {
+            for (size_t row = old_size; row < rows; ++row) {
+                clear_value(row);
+            }
+        }
+    }
+
+    Column& DataFrame::add_column(const std::string& name, ColumnType type) {
+        if (get_column(name)) {
+            throw std::invalid_argument("DataFrame already has a column named '" + name + "'");
+        }
+
+        auto column = std::make_unique<Column>(name, type);
+        column->resize(rows());
+        column_index_.emplace(name, columns_.size());
+        column_names_.push_back(name);
+        columns_.push_back(std::move(column));
+        return *columns_.back();
+    }
+
+    Column* DataFrame::get_column(const std::string& name) {
+        auto it = column_index_.find(name);
+        return it != column_index_.end() ? columns_[it->second].get() : nullptr;
+    }
+
+    size_t DataFrame::column_index(const std::string& name) const {
+        auto it = column_index_.find(name);
+        if (it == column_index_.end()) {
+            throw std::out_of_range("DataFrame has no column named '" + name + "'");
+        }
+        return it->second;
+    }
+
+    const Column* DataFrame::get_column(const std::string& name) const {
+        return const_cast<DataFrame*>(this)->get_column(name);
+    }
+
+    Column& DataFrame::column(const std::string& name) {
+        Column* col = get_column(name);
+        if (!col) {
+            throw std::out_of_range("DataFrame has no column named '" + name + "'");
+        }
+        return *col;
+    }
+
+    const Column& DataFrame::column(const std::string& name) const {
+        return const_cast<DataFrame*>(this)->column(name);
+    }
+
+    Column& DataFrame::column(size_t index) {
+        if (index >= columns_.size()) {
+            throw std::out_of_range("Column index out of range");
+        }
+        return *columns_[index];
+    }
+
+    const Column& DataFrame::column(size_t index) const {
+        return const_cast<DataFrame*>(this)->column(index);
+    }
+
+    RowView DataFrame::get_row(size_t index) const {
+        if (index >= rows()) {
+            throw std::out_of_range("Row index out of range");
+        }
+        return RowView(*this, index);
+    }
+
+    void DataFrame::reserve(size_t rows) {
+        for (auto& col : columns_) {
+            col->reserve(rows);
+        }
+    }
+
+    DataFrame DataFrame::from_history(const PriceHistory& history) {
+        DataFrame frame;
+        size_t rows = history.size();
+
+        // Add every column while the frame is still empty, then fill them
+        Column& date = frame.add_column("Date", ColumnType::Timestamp);
+        std::vector<std::pair<Column*, const std::vector<double>*>> prices = {
+            {&frame.add_column("Open", ColumnType::Double), &history.open},
+            {&frame.add_column("High", ColumnType::Double), &history.high},
+            {&frame.add_column("Low", ColumnType::Double), &history.low},
+            {&frame.add_column("Close", ColumnType::Double), &history.close},
+        };
+        if (!history.adjclose.empty()) {
+            prices.emplace_back(&frame.add_column("Adj Close", ColumnType::Double), &history.adjclose);
+        }
+        Column& volume = frame.add_column("Volume", ColumnType::Int64);
+
+        date.append_int64s(history.timestamp);
+
+        // Columns shorter than the timestamps are padded with nulls
+        for (auto& price : prices) {
+            price.first->reserve(rows);
+            price.first->append_doubles(Span<const double>(*price.second).first(rows));
+            price.first->resize(rows);
+        }
+
+        volume.reserve(rows);
+        for (size_t i = 0; i < rows; ++i) {
+            if (i < history.volume.size() && !std::isnan(history.volume[i])) {
+                volume.append_int64(static_cast<int64_t>(history.volume[i]));
+            } else {
+                volume.append_null();
+            }
+        }
+
+        return frame;
+    }
+
+    void DataFrame::print() const {
+        // Print column headers
+        for (const auto& col_name : column_names_) {
+            std::cout << col_name << "\t";
+        }
+        std::cout << std::endl;
+
+        // Print each row
+        for (size_t row_idx = 0; row_idx < rows(); ++row_idx) {
+            for (const auto& col : columns_) {
+                if (col->is_null(row_idx)) {
+                    std::cout << "null";
+                } else {
+                    switch (col->type()) {
+                        case ColumnType::Double:
+                            std::cout << col->doubles()[row_idx];
+                            break;
+                        case ColumnType::Int64:
+                        case ColumnType::Timestamp:
+                            std::cout << col->int64s()[row_idx];
+                            break;
+                        case ColumnType::Bool:
+                            std::cout << (col->bools()[row_idx] ? "true" : "false");
+                            break;
+                        case ColumnType::String:
+                            std::cout << col->string_at(row_idx);
+                            break;
+                    }
+                }
+                std::cout << "\t";
+            }
+            std::cout << std::endl;
+        }
+    }
+
+} // namespace yfinance
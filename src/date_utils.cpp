@@ -1,6 +1,7 @@
 #include "date_utils.h"
 #include <iomanip>
 #include <sstream>
+#include <stdexcept>
 
 namespace yfinance {
 
@@ -23,6 +24,30 @@ namespace yfinance {
         return oss.str();
     }
 
+    std::string DateUtils::format_epoch(int64_t seconds, int64_t utc_offset, const std::string& format) {
+        std::time_t shifted = static_cast<std::time_t>(seconds + utc_offset);
+        std::tm tm = {};
+        if (!gmtime_r(&shifted, &tm)) {
+            throw std::invalid_argument("Timestamp out of range: " + std::to_string(seconds));
+        }
+
+        char buffer[128];
+        size_t length = std::strftime(buffer, sizeof(buffer), format.c_str(), &tm);
+        return std::string(buffer, length);
+    }
+
+    int64_t DateUtils::parse_epoch(const std::string& date_str, int64_t utc_offset, const std::string& format) {
+        std::tm tm = {};
+        std::istringstream ss(date_str);
+        ss >> std::get_time(&tm, format.c_str());
+
+        if (ss.fail()) {
+            throw std::invalid_argument("Unable to parse date string: " + date_str);
+        }
+
+        return static_cast<int64_t>(timegm(&tm)) - utc_offset;
+    }
+
     std::time_t DateUtils::now() {
         return std::time(nullptr);
     }
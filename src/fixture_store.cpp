@@ -0,0 +1,162 @@
+#include "fixture_store.h"
+#include "json_parser.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <vector>
+
+#include <unistd.h>
+
+namespace yfinance {
+
+    namespace {
+
+        // Query parameters that differ between sessions and must not affect the match
+        bool is_volatile_param(const std::string& param) {
+            return param.compare(0, 6, "crumb=") == 0 || param == "crumb";
+        }
+
+        // Path plus sorted, stable query parameters
+        std::string canonical_target(const std::string& url) {
+            std::string target = url;
+            size_t scheme = target.find("://");
+            if (scheme != std::string::npos) {
+                size_t path_start = target.find('/', scheme + 3);
+                target = path_start == std::string::npos ? "/" : target.substr(path_start);
+            }
+
+            size_t query_start = target.find('?');
+            std::string path = target.substr(0, query_start);
+            if (path.empty()) {
+                path = "/";
+            }
+            if (query_start == std::string::npos) {
+                return path;
+            }
+
+            std::vector<std::string> params;
+            for (const auto& param : Utils::split_string(target.substr(query_start + 1), '&')) {
+                if (!param.empty() && !is_volatile_param(param)) {
+                    params.push_back(param);
+                }
+            }
+            std::sort(params.begin(), params.end());
+
+            std::string canonical = path;
+            char separator = '?';
+            for (const auto& param : params) {
+                canonical += separator;
+                canonical += param;
+                separator = '&';
+            }
+            return canonical;
+        }
+
+        uint64_t fnv1a(const std::string& text) {
+            uint64_t hash = 14695981039346656037ULL;
+            for (unsigned char c : text) {
+                hash ^= c;
+                hash *= 1099511628211ULL;
+            }
+            return hash;
+        }
+
+        bool write_file(const std::string& path, const std::string& contents) {
+            // Unique temp name so concurrent recorders never interleave writes
+            static std::atomic<uint64_t> counter{0};
+            std::string temp_path = path + ".tmp." + std::to_string(::getpid()) + "." + std::to_string(counter++);
+            {
+                std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+                if (!file) {
+                    return false;
+                }
+                file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+                if (!file) {
+                    return false;
+                }
+            }
+            return std::rename(temp_path.c_str(), path.c_str()) == 0;
+        }
+
+        std::optional<std::string> read_file(const std::string& path) {
+            std::ifstream file(path, std::ios::binary);
+            if (!file) {
+                return std::nullopt;
+            }
+            std::ostringstream contents;
+            contents << file.rdbuf();
+            return contents.str();
+        }
+
+    } // namespace
+
+    FixtureStore::FixtureStore(const std::string& directory) : directory_(directory) {}
+
+    std::string FixtureStore::fixture_name(const std::string& method, const std::string& url) {
+        std::string target = canonical_target(url);
+
+        // Readable prefix from the path, hash of the full request for uniqueness
+        std::string prefix = Utils::to_lowercase(method) + "_";
+        size_t path_end = target.find('?');
+        for (size_t i = 0; i < std::min(path_end, target.size()) && prefix.size() < 64; ++i) {
+            char c = target[i];
+            if (std::isalnum(static_cast<unsigned char>(c))) {
+                prefix += c;
+            } else if (prefix.back() != '_') {
+                prefix += '_';
+            }
+        }
+
+        char hash[17];
+        std::snprintf(hash, sizeof(hash), "%016llx",
+                      static_cast<unsigned long long>(fnv1a(method + " " + target)));
+        return prefix + (prefix.back() == '_' ? "" : "_") + hash;
+    }
+
+    void FixtureStore::save(const std::string& method, const std::string& url, const Fixture& fixture) const {
+        std::error_code ec;
+        std::filesystem::create_directories(directory_, ec);
+
+        std::string base = directory_ + "/" + fixture_name(method, url);
+
+        nlohmann::json meta;
+        meta["method"] = method;
+        meta["target"] = canonical_target(url);
+        meta["status"] = fixture.status;
+        meta["content_type"] = fixture.content_type;
+
+        // Body first, so a fixture whose metadata exists is always complete
+        if (write_file(base + ".body", fixture.body)) {
+            write_file(base + ".json", JsonParser::stringify(meta, true));
+        }
+    }
+
+    std::optional<FixtureStore::Fixture> FixtureStore::load(const std::string& method, const std::string& url) const {
+        std::string base = directory_ + "/" + fixture_name(method, url);
+
+        auto meta_text = read_file(base + ".json");
+        auto body = read_file(base + ".body");
+        if (!meta_text || !body) {
+            return std::nullopt;
+        }
+
+        try {
+            auto meta = JsonParser::parse(*meta_text);
+            Fixture fixture;
+            fixture.status = meta.value("status", 200L);
+            fixture.content_type = meta.value("content_type", std::string());
+            fixture.body = std::move(*body);
+            return fixture;
+        } catch (const std::exception&) {
+            return std::nullopt;
+        }
+    }
+
+} // namespace yfinance
@@ -0,0 +1,576 @@
+#include "history_store.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#include <nlohmann/json.hpp>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace yfinance {
+
+    namespace {
+
+        constexpr char kMagic[4] = {'Y', 'F', 'C', 'L'};
+        constexpr uint8_t kVersion = 1;
+        constexpr char kInt64Column = 'i';
+        constexpr char kDoubleColumn = 'd';
+
+        // Header layout: magic[4] version[1] type[1] reserved[58]. Its size
+        // keeps the values behind it 64-byte aligned in a page-aligned mapping
+        constexpr size_t kHeaderSize = 64;
+        constexpr size_t kValueSize = 8;
+
+        constexpr const char* kColumnNames[] = {"timestamp", "open", "high", "low", "close", "adjclose", "volume"};
+        constexpr size_t kColumnCount = sizeof(kColumnNames) / sizeof(kColumnNames[0]);
+
+        char column_type(size_t column) {
+            return column == 0 ? kInt64Column : kDoubleColumn;
+        }
+
+        std::string system_error(const std::string& action, const std::string& path) {
+            return action + " " + path + ": " + std::strerror(errno);
+        }
+
+        // Closes the descriptor (and so releases any flock) on scope exit
+        class FileDescriptor {
+        public:
+            explicit FileDescriptor(int fd = -1) : fd_(fd) {}
+            FileDescriptor(const FileDescriptor&) = delete;
+            FileDescriptor& operator=(const FileDescriptor&) = delete;
+            FileDescriptor(FileDescriptor&& other) noexcept : fd_(other.fd_) { other.fd_ = -1; }
+            ~FileDescriptor() {
+                if (fd_ >= 0) {
+                    ::close(fd_);
+                }
+            }
+
+            int get() const { return fd_; }
+
+            // Hand the descriptor over to the caller
+            int release() {
+                int fd = fd_;
+                fd_ = -1;
+                return fd;
+            }
+
+        private:
+            int fd_;
+        };
+
+        void read_exact(int fd, void* data, size_t size, off_t offset, const std::string& path) {
+            char* out = static_cast<char*>(data);
+            while (size > 0) {
+                ssize_t n = ::pread(fd, out, size, offset);
+                if (n <= 0) {
+                    throw std::runtime_error(system_error("Failed to read", path));
+                }
+                out += n;
+                size -= static_cast<size_t>(n);
+                offset += n;
+            }
+        }
+
+        void write_exact(int fd, const void* data, size_t size, off_t offset, const std::string& path) {
+            const char* in = static_cast<const char*>(data);
+            while (size > 0) {
+                ssize_t n = ::pwrite(fd, in, size, offset);
+                if (n <= 0) {
+                    throw std::runtime_error(system_error("Failed to write", path));
+                }
+                in += n;
+                size -= static_cast<size_t>(n);
+                offset += n;
+            }
+        }
+
+        void check_header(const char* header, char type, const std::string& path) {
+            if (std::memcmp(header, kMagic, sizeof(kMagic)) != 0) {
+                throw std::runtime_error("Not a history column: " + path);
+            }
+            if (static_cast<uint8_t>(header[4]) != kVersion) {
+                throw std::runtime_error("Unsupported history column version " +
+                                         std::to_string(static_cast<uint8_t>(header[4])) + ": " + path);
+            }
+            if (header[5] != type) {
+                throw std::runtime_error("Unexpected history column type: " + path);
+            }
+        }
+
+        // Bars in a column file of the given size. A file shorter than the
+        // header is a torn first append and holds none
+        size_t column_rows(off_t file_size) {
+            if (file_size < static_cast<off_t>(kHeaderSize)) {
+                return 0;
+            }
+            return (static_cast<size_t>(file_size) - kHeaderSize) / kValueSize;
+        }
+
+        std::string column_path(const std::string& series, size_t column) {
+            return series + "/" + kColumnNames[column] + ".col";
+        }
+
+        nlohmann::json meta_to_json(const ChartMeta& meta) {
+            return {
+                {"currency", meta.currency},
+                {"symbol", meta.symbol},
+                {"exchangeName", meta.exchange_name},
+                {"instrumentType", meta.instrument_type},
+                {"timezone", meta.timezone},
+                {"exchangeTimezoneName", meta.exchange_timezone_name},
+                {"gmtoffset", meta.gmtoffset},
+                {"firstTradeDate", meta.first_trade_date},
+                {"regularMarketTime", meta.regular_market_time},
+                {"regularMarketPrice", meta.regular_market_price},
+                {"chartPreviousClose", meta.chart_previous_close},
+                {"priceHint", meta.price_hint},
+                {"dataGranularity", meta.data_granularity},
+                {"range", meta.range}
+            };
+        }
+
+        ChartMeta meta_from_json(const nlohmann::json& json) {
+            ChartMeta meta;
+            meta.currency = json.value("currency", "");
+            meta.symbol = json.value("symbol", "");
+            meta.exchange_name = json.value("exchangeName", "");
+            meta.instrument_type = json.value("instrumentType", "");
+            meta.timezone = json.value("timezone", "");
+            meta.exchange_timezone_name = json.value("exchangeTimezoneName", "");
+            meta.gmtoffset = json.value("gmtoffset", int64_t{0});
+            meta.first_trade_date = json.value("firstTradeDate", int64_t{0});
+            meta.regular_market_time = json.value("regularMarketTime", int64_t{0});
+            meta.regular_market_price = json.value("regularMarketPrice", 0.0);
+            meta.chart_previous_close = json.value("chartPreviousClose", 0.0);
+            meta.price_hint = json.value("priceHint", 0);
+            meta.data_granularity = json.value("dataGranularity", "");
+            meta.range = json.value("range", "");
+            return meta;
+        }
+
+        // Contents of meta.json: {"meta": {...}, "dividends": [...], "splits": [...]}
+        struct SeriesInfo {
+            ChartMeta meta;
+            std::vector<DividendEvent> dividends;
+            std::vector<SplitEvent> splits;
+        };
+
+        SeriesInfo read_info(const std::string& path) {
+            SeriesInfo info;
+            std::ifstream file(path);
+            if (!file) {
+                return info;
+            }
+
+            nlohmann::json json;
+            try {
+                json = nlohmann::json::parse(file);
+            } catch (const nlohmann::json::exception& e) {
+                throw std::runtime_error("Corrupt " + path + ": " + e.what());
+            }
+            if (json.contains("meta")) {
+                info.meta = meta_from_json(json["meta"]);
+            }
+            for (const auto& dividend : json.value("dividends", nlohmann::json::array())) {
+                info.dividends.push_back({dividend.value("date", int64_t{0}), dividend.value("amount", 0.0)});
+            }
+            for (const auto& split : json.value("splits", nlohmann::json::array())) {
+                info.splits.push_back({split.value("date", int64_t{0}), split.value("numerator", 0.0),
+                                       split.value("denominator", 0.0), split.value("splitRatio", "")});
+            }
+            return info;
+        }
+
+        void write_info(const std::string& path, const SeriesInfo& info) {
+            nlohmann::json json;
+            json["meta"] = meta_to_json(info.meta);
+            json["dividends"] = nlohmann::json::array();
+            for (const auto& dividend : info.dividends) {
+                json["dividends"].push_back({{"date", dividend.date}, {"amount", dividend.amount}});
+            }
+            json["splits"] = nlohmann::json::array();
+            for (const auto& split : info.splits) {
+                json["splits"].push_back({{"date", split.date}, {"numerator", split.numerator},
+                                          {"denominator", split.denominator}, {"splitRatio", split.ratio}});
+            }
+
+            // Replaced with a rename so readers never see a partial file
+            static std::atomic<uint64_t> counter{0};
+            std::string temp_path = path + ".tmp." + std::to_string(::getpid()) + "." + std::to_string(counter++);
+            {
+                std::ofstream file(temp_path, std::ios::trunc);
+                file << json.dump();
+                if (!file.flush()) {
+                    std::remove(temp_path.c_str());
+                    throw std::runtime_error("Failed to write " + path);
+                }
+            }
+            if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+                std::remove(temp_path.c_str());
+                throw std::runtime_error(system_error("Failed to replace", path));
+            }
+        }
+
+        // Add the events whose dates are not stored yet, keeping them sorted by date
+        template <typename Event>
+        void merge_events(std::vector<Event>& stored, const std::vector<Event>& incoming) {
+            for (const auto& event : incoming) {
+                auto it = std::find_if(stored.begin(), stored.end(),
+                                       [&event](const Event& existing) { return existing.date == event.date; });
+                if (it == stored.end()) {
+                    stored.push_back(event);
+                }
+            }
+            std::sort(stored.begin(), stored.end(),
+                      [](const Event& a, const Event& b) { return a.date < b.date; });
+        }
+
+        // Symbols such as "^GSPC" or "EURUSD=X" are kept as they are; path
+        // separators and other unusual characters become '_'
+        std::string path_component(const std::string& name) {
+            if (name.empty() || name == "." || name == "..") {
+                throw std::invalid_argument("Invalid history store key \"" + name + "\"");
+            }
+            std::string component = name;
+            for (char& c : component) {
+                if (!std::isalnum(static_cast<unsigned char>(c)) && std::strchr("-_.^=", c) == nullptr) {
+                    c = '_';
+                }
+            }
+            return component;
+        }
+
+    } // namespace
+
+    // MappedHistory
+
+    MappedHistory::MappedHistory(MappedHistory&& other) noexcept
+        : mappings_(other.mappings_), lock_fd_(other.lock_fd_), size_(other.size_), meta_(std::move(other.meta_)),
+          dividends_(std::move(other.dividends_)), splits_(std::move(other.splits_)) {
+        other.mappings_ = {};
+        other.lock_fd_ = -1;
+        other.size_ = 0;
+    }
+
+    MappedHistory& MappedHistory::operator=(MappedHistory&& other) noexcept {
+        if (this != &other) {
+            release();
+            mappings_ = other.mappings_;
+            lock_fd_ = other.lock_fd_;
+            size_ = other.size_;
+            meta_ = std::move(other.meta_);
+            dividends_ = std::move(other.dividends_);
+            splits_ = std::move(other.splits_);
+            other.mappings_ = {};
+            other.lock_fd_ = -1;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    MappedHistory::~MappedHistory() {
+        release();
+    }
+
+    void MappedHistory::release() {
+        for (auto& mapping : mappings_) {
+            if (mapping.address != nullptr) {
+                ::munmap(mapping.address, mapping.length);
+            }
+            mapping = {};
+        }
+        if (lock_fd_ >= 0) {
+            ::close(lock_fd_);
+            lock_fd_ = -1;
+        }
+    }
+
+    const double* MappedHistory::doubles(size_t column) const {
+        const auto& mapping = mappings_[column];
+        if (mapping.address == nullptr) {
+            return nullptr;
+        }
+        return reinterpret_cast<const double*>(static_cast<const char*>(mapping.address) + kHeaderSize);
+    }
+
+    Span<const int64_t> MappedHistory::timestamp() const {
+        const auto& mapping = mappings_[0];
+        if (mapping.address == nullptr) {
+            return {};
+        }
+        return {reinterpret_cast<const int64_t*>(static_cast<const char*>(mapping.address) + kHeaderSize), size_};
+    }
+
+    Span<const double> MappedHistory::open() const { return {doubles(1), size_}; }
+    Span<const double> MappedHistory::high() const { return {doubles(2), size_}; }
+    Span<const double> MappedHistory::low() const { return {doubles(3), size_}; }
+    Span<const double> MappedHistory::close() const { return {doubles(4), size_}; }
+    Span<const double> MappedHistory::adjclose() const { return {doubles(5), size_}; }
+    Span<const double> MappedHistory::volume() const { return {doubles(6), size_}; }
+
+    size_t MappedHistory::lower_bound(int64_t t) const {
+        auto times = timestamp();
+        return static_cast<size_t>(std::lower_bound(times.begin(), times.end(), t) - times.begin());
+    }
+
+    std::optional<size_t> MappedHistory::asof(int64_t t) const {
+        auto times = timestamp();
+        size_t after = static_cast<size_t>(std::upper_bound(times.begin(), times.end(), t) - times.begin());
+        if (after == 0) {
+            return std::nullopt;
+        }
+        return after - 1;
+    }
+
+    std::pair<size_t, size_t> MappedHistory::index_range(int64_t start, int64_t end) const {
+        if (end <= start) {
+            return {0, 0};
+        }
+        auto times = timestamp();
+        size_t first = lower_bound(start);
+        auto last = std::lower_bound(times.begin() + first, times.end(), end);
+        return {first, static_cast<size_t>(last - times.begin())};
+    }
+
+    PriceHistory MappedHistory::to_price_history() const {
+        return between(std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max());
+    }
+
+    PriceHistory MappedHistory::between(int64_t start, int64_t end) const {
+        PriceHistory range;
+        range.meta = meta_;
+
+        // Appends take the lock exclusively, so the rewritten last bar is
+        // never copied half updated
+        if (lock_fd_ >= 0 && ::flock(lock_fd_, LOCK_SH) != 0) {
+            throw std::runtime_error(std::string("Failed to lock history: ") + std::strerror(errno));
+        }
+        struct Unlock {
+            int fd;
+            ~Unlock() {
+                if (fd >= 0) {
+                    ::flock(fd, LOCK_UN);
+                }
+            }
+        } unlock{lock_fd_};
+
+        auto [first, last] = index_range(start, end);
+        auto copy = [first, last](Span<const double> column) {
+            return std::vector<double>(column.begin() + first, column.begin() + last);
+        };
+        auto times = timestamp();
+        range.timestamp.assign(times.begin() + first, times.begin() + last);
+        range.open = copy(open());
+        range.high = copy(high());
+        range.low = copy(low());
+        range.close = copy(close());
+        range.adjclose = copy(adjclose());
+        range.volume = copy(volume());
+
+        for (const auto& dividend : dividends_) {
+            if (dividend.date >= start && dividend.date < end) {
+                range.dividends.push_back(dividend);
+            }
+        }
+        for (const auto& split : splits_) {
+            if (split.date >= start && split.date < end) {
+                range.splits.push_back(split);
+            }
+        }
+        return range;
+    }
+
+    // HistoryStore
+
+    HistoryStore::HistoryStore(const std::string& directory) : directory_(directory) {}
+
+    std::string HistoryStore::series_path(const std::string& symbol, const std::string& interval) const {
+        return directory_ + "/" + path_component(symbol) + "/" + path_component(interval);
+    }
+
+    size_t HistoryStore::append(const std::string& symbol, const std::string& interval,
+                                const PriceHistory& history) const {
+        std::string series = series_path(symbol, interval);
+        std::error_code ec;
+        std::filesystem::create_directories(series, ec);
+        if (ec) {
+            throw std::runtime_error("Failed to create " + series + ": " + ec.message());
+        }
+
+        std::vector<FileDescriptor> files;
+        files.reserve(kColumnCount);
+        for (size_t column = 0; column < kColumnCount; ++column) {
+            std::string path = column_path(series, column);
+            int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+            if (fd < 0) {
+                throw std::runtime_error(system_error("Failed to open", path));
+            }
+            files.emplace_back(fd);
+            if (column == 0 && ::flock(fd, LOCK_EX) != 0) {
+                throw std::runtime_error(system_error("Failed to lock", path));
+            }
+        }
+
+        // Write missing headers, then agree on the shortest column
+        size_t rows = std::numeric_limits<size_t>::max();
+        std::vector<off_t> sizes(kColumnCount);
+        for (size_t column = 0; column < kColumnCount; ++column) {
+            std::string path = column_path(series, column);
+            int fd = files[column].get();
+            struct stat info;
+            if (::fstat(fd, &info) != 0) {
+                throw std::runtime_error(system_error("Failed to stat", path));
+            }
+            sizes[column] = info.st_size;
+            if (info.st_size < static_cast<off_t>(kHeaderSize)) {
+                char header[kHeaderSize] = {};
+                std::memcpy(header, kMagic, sizeof(kMagic));
+                header[4] = static_cast<char>(kVersion);
+                header[5] = column_type(column);
+                write_exact(fd, header, kHeaderSize, 0, path);
+                sizes[column] = kHeaderSize;
+            } else {
+                char header[kHeaderSize];
+                read_exact(fd, header, kHeaderSize, 0, path);
+                check_header(header, column_type(column), path);
+            }
+            rows = std::min(rows, column_rows(sizes[column]));
+        }
+
+        // Drop the tail of a torn append
+        off_t end = static_cast<off_t>(kHeaderSize + rows * kValueSize);
+        for (size_t column = 0; column < kColumnCount; ++column) {
+            if (sizes[column] != end && ::ftruncate(files[column].get(), end) != 0) {
+                throw std::runtime_error(system_error("Failed to truncate", column_path(series, column)));
+            }
+        }
+
+        // Start at the last stored bar if history has it again: that bar may
+        // have been stored while its period was still open, so it is
+        // rewritten with the newer values
+        size_t first = 0;
+        off_t offset = end;
+        bool rewrite = false;
+        if (rows > 0) {
+            int64_t last = 0;
+            read_exact(files[0].get(), &last, kValueSize, end - static_cast<off_t>(kValueSize), column_path(series, 0));
+            first = history.lower_bound(last);
+            rewrite = first < history.size() && history.timestamp[first] == last;
+            if (rewrite) {
+                offset -= static_cast<off_t>(kValueSize);
+            }
+        }
+        size_t count = history.size() - first;
+
+        if (count > 0) {
+            write_exact(files[0].get(), history.timestamp.data() + first, count * kValueSize, offset,
+                        column_path(series, 0));
+
+            const std::vector<double>* columns[] = {&history.open, &history.high, &history.low, &history.close,
+                                                    &history.adjclose, &history.volume};
+            std::vector<double> padded;
+            for (size_t column = 1; column < kColumnCount; ++column) {
+                const std::vector<double>& values = *columns[column - 1];
+                const double* data = values.data() + first;
+                // A column shorter than the timestamps (an absent adjclose) is stored as NaN
+                if (values.size() < history.size()) {
+                    padded.assign(count, kMissingValue);
+                    if (values.size() > first) {
+                        std::copy(values.begin() + first, values.end(), padded.begin());
+                    }
+                    data = padded.data();
+                }
+                write_exact(files[column].get(), data, count * kValueSize, offset, column_path(series, column));
+            }
+        }
+
+        std::string info_path = series + "/meta.json";
+        SeriesInfo info = read_info(info_path);
+        info.meta = history.meta;
+        merge_events(info.dividends, history.dividends);
+        merge_events(info.splits, history.splits);
+        write_info(info_path, info);
+
+        return rewrite ? count - 1 : count;
+    }
+
+    std::optional<MappedHistory> HistoryStore::open(const std::string& symbol, const std::string& interval) const {
+        std::string series = series_path(symbol, interval);
+        std::error_code ec;
+        if (!std::filesystem::is_directory(series, ec)) {
+            return std::nullopt;
+        }
+
+        std::vector<FileDescriptor> files;
+        std::vector<off_t> sizes(kColumnCount, 0);
+        size_t rows = std::numeric_limits<size_t>::max();
+        for (size_t column = 0; column < kColumnCount; ++column) {
+            std::string path = column_path(series, column);
+            files.emplace_back(::open(path.c_str(), O_RDONLY));
+            int fd = files.back().get();
+            if (fd >= 0) {
+                struct stat info;
+                if (::fstat(fd, &info) != 0) {
+                    throw std::runtime_error(system_error("Failed to stat", path));
+                }
+                sizes[column] = info.st_size;
+                if (info.st_size >= static_cast<off_t>(kHeaderSize)) {
+                    char header[kHeaderSize];
+                    read_exact(fd, header, kHeaderSize, 0, path);
+                    check_header(header, column_type(column), path);
+                }
+            } else if (errno != ENOENT) {
+                throw std::runtime_error(system_error("Failed to open", path));
+            }
+            rows = std::min(rows, column_rows(sizes[column]));
+        }
+
+        MappedHistory mapped;
+        mapped.size_ = rows;
+        // Map only the agreed rows, so a concurrent append or trim never
+        // changes the mapped range
+        size_t length = kHeaderSize + rows * kValueSize;
+        for (size_t column = 0; column < kColumnCount && rows > 0; ++column) {
+            void* address = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, files[column].get(), 0);
+            if (address == MAP_FAILED) {
+                throw std::runtime_error(system_error("Failed to map", column_path(series, column)));
+            }
+            mapped.mappings_[column] = {address, length};
+        }
+        if (rows > 0) {
+            mapped.lock_fd_ = files[0].release();
+        }
+
+        SeriesInfo info = read_info(series + "/meta.json");
+        mapped.meta_ = std::move(info.meta);
+        mapped.dividends_ = std::move(info.dividends);
+        mapped.splits_ = std::move(info.splits);
+        return mapped;
+    }
+
+    std::optional<int64_t> HistoryStore::last_timestamp(const std::string& symbol, const std::string& interval) const {
+        auto mapped = open(symbol, interval);
+        if (!mapped || mapped->size() == 0) {
+            return std::nullopt;
+        }
+        return mapped->timestamp().back();
+    }
+
+    void HistoryStore::remove(const std::string& symbol, const std::string& interval) const {
+        std::error_code ec;
+        std::filesystem::remove_all(series_path(symbol, interval), ec);
+    }
+
+} // namespace yfinance
@@ -1,11 +1,18 @@
 #include "http_client.h"
 #include "utils.h"
 #include "json_parser.h"
+#include "connection_pool.h"
+#include "request_loop.h"
+#include "rate_limiter.h"
+#include "fixture_store.h"
 
 #include <iostream>
 #include <thread>
 #include <algorithm>
 #include <regex>
+#include <cctype>
+#include <cstdlib>
+#include <mutex>
 
 #ifdef USE_CPR
 #include <cpr/cpr.h>
@@ -18,46 +25,134 @@
 
 namespace yfinance {
 
-    HttpClient::HttpClient() : proxy_(""), user_agent_("Mozilla/5.0 (compatible; yfinance-cpp/1.0)"), cookies_(""), retries_(3), timeout_(30) {
-#ifdef USE_CPR
-        // CPR initialization if needed
-#elif defined(USE_CPP_HTTP_LIB)
-        // cpp-httplib doesn't need special initialization
+    namespace {
+
+        // Smaller bodies are parsed after the transfer; a worker thread is not worth it
+        constexpr curl_off_t kMinStreamedBody = 64 * 1024;
+
+        // Whether the response being received carries a Content-Encoding
+        // (libcurl decodes it, so Content-Length no longer matches the body
+        // we see). Assumed true when this libcurl cannot report headers
+        bool has_content_encoding(CURL* handle) {
+#if LIBCURL_VERSION_NUM >= 0x075400
+            struct curl_header* header = nullptr;
+            return curl_easy_header(handle, "Content-Encoding", 0, CURLH_HEADER, -1, &header) == CURLHE_OK;
 #else
-        curl_global_init(CURL_GLOBAL_DEFAULT);
-        curl_handle_ = curl_easy_init();
-        if (curl_handle_) {
-            // Enable cookie handling
-            curl_easy_setopt(curl_handle_, CURLOPT_COOKIEFILE, ""); // Initialize cookie engine
+            (void)handle;
+            return true;
+#endif
         }
+
+        // Fixture directory responses are recorded into (set_record_directory)
+        std::mutex recorder_mutex;
+        std::shared_ptr<FixtureStore> recorder_store;
+        std::atomic<bool> recording{false};
+
+        std::shared_ptr<FixtureStore> active_recorder() {
+            static bool from_environment = [] {
+                const char* dir = std::getenv("YFINANCE_RECORD_DIR");
+                if (dir && *dir) {
+                    std::lock_guard<std::mutex> lock(recorder_mutex);
+                    recorder_store = std::make_shared<FixtureStore>(dir);
+                    recording = true;
+                }
+                return true;
+            }();
+            (void)from_environment;
+
+            if (!recording) {
+                return nullptr;
+            }
+            std::lock_guard<std::mutex> lock(recorder_mutex);
+            return recorder_store;
+        }
+
+    } // namespace
+
+    // Cookies received by a client, shared with its in-flight async requests
+    struct HttpClient::CookieJar {
+        std::mutex mutex;
+        std::string header;              // "name=value; name2=value2"
+        std::vector<std::string> lines;  // Netscape cookie-file lines for libcurl
+    };
+
+#ifndef USE_CPR
+#ifndef USE_CPP_HTTP_LIB
+    // Per-request libcurl state, used by both the blocking and the async paths
+    struct HttpClient::Transfer {
+        PooledHandle handle;
+        std::string method;
+        std::string url;
+        std::string data;
+        std::map<std::string, std::string> headers;
+        std::string proxy;
+        std::string ca_info;
+        int timeout;
+        RetryState retry;
+        std::chrono::milliseconds retry_after;
+        HttpVersion http_version;
+        bool async;
+        std::shared_ptr<CookieJar> cookie_jar;
+        std::shared_ptr<HostLimiter> limiter;
+        bool admitted;  // Async: holds a limiter slot that completion must release
+
+        struct curl_slist* header_list;
+        ResponseBuffer response;
+        std::string content_type;
+        bool body_started;
+
+        // Set for get_streamed(); stream exists while a 2xx body is being streamed
+        StreamingParser::Consumer consumer;
+        std::unique_ptr<StreamingParser> stream;
+        bool buffer_body;  // Also keep streamed bytes (for recording)
+
+        Transfer(const HttpClient& client,
+                 const std::string& request_method,
+                 const std::string& request_url,
+                 const std::map<std::string, std::string>& request_headers,
+                 const std::string& request_data)
+            : method(request_method), url(request_url), data(request_data), headers(request_headers),
+              proxy(client.proxy_), ca_info(client.ca_info_), timeout(client.timeout_),
+              retry(client.get_retry_policy()), retry_after(0),
+              http_version(client.http_version_), async(false), cookie_jar(client.cookie_jar_),
+              limiter(RateLimiter::instance().for_url(request_url)), admitted(false), header_list(nullptr),
+              body_started(false),
+              buffer_body(true) {}
+
+        ~Transfer() {
+            if (header_list) {
+                curl_slist_free_all(header_list);
+            }
+        }
+    };
+#endif
 #endif
-    }
 
-    HttpClient::~HttpClient() {
+    HttpClient::HttpClient() : proxy_(""), user_agent_("Mozilla/5.0 (compatible; yfinance-cpp/1.0)"), timeout_(30),
+                               http_version_(HttpVersion::Http1_1), cookie_jar_(std::make_shared<CookieJar>()) {
 #ifdef USE_CPR
-        // CPR cleanup if needed
+        // CPR initialization if needed
 #elif defined(USE_CPP_HTTP_LIB)
-        // No cleanup needed for cpp-httplib
+        // cpp-httplib doesn't need special initialization
 #else
-        if (curl_handle_) {
-            curl_easy_cleanup(curl_handle_);
-            curl_handle_ = nullptr;
-        }
-        curl_global_cleanup();
+        // Easy handles are borrowed from the process-wide ConnectionPool per request
+        ConnectionPool::instance();
 #endif
     }
 
+    HttpClient::~HttpClient() = default;
+
     nlohmann::json HttpClient::get(const std::string& url,
                                   const std::map<std::string, std::string>& headers,
                                   const std::map<std::string, std::string>& params) {
-        std::string response = get_text(url, headers, params);
+        ResponseBuffer response = get_buffer(url, headers, params);
 
         if (response.empty()) {
             throw HttpClientException("Empty response from server for URL: " + url);
         }
 
         try {
-            return JsonParser::parse(response);
+            return JsonParser::parse(response.data(), response.size());
         } catch (const std::exception& e) {
             throw HttpClientException("Failed to parse JSON response from " + url + ": " + std::string(e.what()));
         }
@@ -66,45 +161,151 @@ namespace yfinance {
     std::string HttpClient::get_text(const std::string& url,
                                    const std::map<std::string, std::string>& headers,
                                    const std::map<std::string, std::string>& params) {
-        // Build query string from params
-        std::string query_string = "";
-        for (const auto& param : params) {
-            if (!query_string.empty()) {
-                query_string += "&";
-            }
-            query_string += Utils::url_encode(param.first) + "=" + Utils::url_encode(param.second);
-        }
+        return perform_request("GET", build_url(url, params), headers, "").release();
+    }
 
-        std::string full_url = url;
-        if (!query_string.empty()) {
-            full_url += "?" + query_string;
-        }
+    ResponseBuffer HttpClient::get_buffer(const std::string& url,
+                                          const std::map<std::string, std::string>& headers,
+                                          const std::map<std::string, std::string>& params) {
+        return perform_request("GET", build_url(url, params), headers, "");
+    }
 
-        return perform_request("GET", full_url, headers, "");
+    void HttpClient::get_streamed(const std::string& url,
+                                  const std::map<std::string, std::string>& headers,
+                                  const std::map<std::string, std::string>& params,
+                                  StreamConsumer consumer) {
+        perform_request("GET", build_url(url, params), headers, "", std::move(consumer));
+    }
+
+    void HttpClient::consume_response(const StreamConsumer& consumer, const std::string& url,
+                                      const char* data, size_t size) {
+        try {
+            StreamingParser::consume(consumer, data, size);
+        } catch (const std::exception& e) {
+            throw HttpClientException("Failed to parse response from " + url + ": " + std::string(e.what()));
+        }
     }
 
     nlohmann::json HttpClient::post(const std::string& url,
                                    const std::string& data,
                                    const std::map<std::string, std::string>& headers) {
-        std::string response = perform_request("POST", url, headers, data);
+        ResponseBuffer response = perform_request("POST", url, headers, data);
 
         if (response.empty()) {
             throw HttpClientException("Empty response from server for URL: " + url);
         }
 
         try {
-            return JsonParser::parse(response);
+            return JsonParser::parse(response.data(), response.size());
         } catch (const std::exception& e) {
             throw HttpClientException("Failed to parse JSON response from " + url + ": " + std::string(e.what()));
         }
     }
 
+    std::future<nlohmann::json> HttpClient::get_async(const std::string& url,
+                                                      const std::map<std::string, std::string>& headers,
+                                                      const std::map<std::string, std::string>& params) {
+        auto promise = std::make_shared<std::promise<nlohmann::json>>();
+        auto future = promise->get_future();
+
+        get_buffer_async(url, headers, params, [promise, url](ResponseBuffer response, std::exception_ptr error) {
+            if (error) {
+                promise->set_exception(error);
+                return;
+            }
+
+            if (response.empty()) {
+                promise->set_exception(std::make_exception_ptr(
+                    HttpClientException("Empty response from server for URL: " + url)));
+                return;
+            }
+
+            try {
+                promise->set_value(JsonParser::parse(response.data(), response.size()));
+            } catch (const std::exception& e) {
+                promise->set_exception(std::make_exception_ptr(
+                    HttpClientException("Failed to parse JSON response from " + url + ": " + std::string(e.what()))));
+            }
+        });
+
+        return future;
+    }
+
+    std::future<std::string> HttpClient::get_text_async(const std::string& url,
+                                                        const std::map<std::string, std::string>& headers,
+                                                        const std::map<std::string, std::string>& params) {
+        auto promise = std::make_shared<std::promise<std::string>>();
+        auto future = promise->get_future();
+
+        get_text_async(url, headers, params, [promise](std::string response, std::exception_ptr error) {
+            if (error) {
+                promise->set_exception(error);
+            } else {
+                promise->set_value(std::move(response));
+            }
+        });
+
+        return future;
+    }
+
+    void HttpClient::get_text_async(const std::string& url,
+                                    const std::map<std::string, std::string>& headers,
+                                    const std::map<std::string, std::string>& params,
+                                    ResponseCallback callback) {
+        get_buffer_async(url, headers, params, [callback](ResponseBuffer response, std::exception_ptr error) {
+            callback(error ? std::string() : response.release(), error);
+        });
+    }
+
+    void HttpClient::get_buffer_async(const std::string& url,
+                                      const std::map<std::string, std::string>& headers,
+                                      const std::map<std::string, std::string>& params,
+                                      BufferCallback callback) {
+        auto request_headers = headers;
+        if (request_headers.find("User-Agent") == request_headers.end()) {
+            request_headers["User-Agent"] = user_agent_;
+        }
+
+#if defined(USE_CPR) || defined(USE_CPP_HTTP_LIB)
+        // No event loop for these backends; complete the request inline
+        ResponseBuffer response;
+        try {
+            response = perform_request("GET", build_url(url, params), request_headers, "");
+        } catch (...) {
+            callback(ResponseBuffer(), std::current_exception());
+            return;
+        }
+        callback(std::move(response), nullptr);
+#else
+        auto transfer = std::make_shared<Transfer>(*this, "GET", build_url(url, params), request_headers, "");
+        if (!transfer->handle) {
+            callback(ResponseBuffer(), std::make_exception_ptr(HttpClientException("CURL handle not initialized")));
+            return;
+        }
+
+        transfer->async = true;
+
+        submit_transfer(std::move(transfer), std::move(callback), std::chrono::milliseconds(0));
+#endif
+    }
+
     void HttpClient::set_proxy(const std::string& proxy) {
         proxy_ = proxy;
     }
 
     void HttpClient::set_retries(int retries) {
-        retries_ = retries;
+        std::lock_guard<std::mutex> lock(retry_mutex_);
+        retry_policy_.max_retries = retries;
+    }
+
+    void HttpClient::set_retry_policy(const RetryPolicy& policy) {
+        std::lock_guard<std::mutex> lock(retry_mutex_);
+        retry_policy_ = policy;
+    }
+
+    RetryPolicy HttpClient::get_retry_policy() const {
+        std::lock_guard<std::mutex> lock(retry_mutex_);
+        return retry_policy_;
     }
 
     void HttpClient::set_timeout(int seconds) {
@@ -115,310 +316,495 @@ namespace yfinance {
         user_agent_ = user_agent;
     }
 
-    bool HttpClient::is_transient_error(const std::string& error_message) {
-        std::string lower_error = Utils::to_lowercase(error_message);
+    void HttpClient::set_http_version(HttpVersion version) {
+        http_version_ = version;
+    }
+
+    void HttpClient::set_ca_info(const std::string& ca_bundle_path) {
+        ca_info_ = ca_bundle_path;
+    }
 
-        // Check for common transient error patterns
-        std::vector<std::string> transient_patterns = {
-            "timeout", "connection refused", "connection reset", "network is unreachable",
-            "temporary failure in name resolution", "too many redirects", "could not resolve host"
-        };
+    void HttpClient::set_record_directory(const std::string& directory) {
+        active_recorder();  // Apply YFINANCE_RECORD_DIR first so this call wins
 
-        for (const auto& pattern : transient_patterns) {
-            if (lower_error.find(pattern) != std::string::npos) {
-                return true;
+        std::lock_guard<std::mutex> lock(recorder_mutex);
+        recorder_store = directory.empty() ? nullptr : std::make_shared<FixtureStore>(directory);
+        recording = !directory.empty();
+    }
+
+    void HttpClient::set_max_concurrent_streams(long streams) {
+#if !defined(USE_CPR) && !defined(USE_CPP_HTTP_LIB)
+        RequestLoop::instance().set_max_concurrent_streams(streams);
+#else
+        (void)streams;
+#endif
+    }
+
+    void HttpClient::set_max_host_connections(long connections) {
+#if !defined(USE_CPR) && !defined(USE_CPP_HTTP_LIB)
+        RequestLoop::instance().set_max_host_connections(connections);
+#else
+        (void)connections;
+#endif
+    }
+
+    std::string HttpClient::get_cookies() const {
+        std::lock_guard<std::mutex> lock(cookie_jar_->mutex);
+        return cookie_jar_->header;
+    }
+
+    void HttpClient::set_cookies(const std::string& cookies) {
+        std::lock_guard<std::mutex> lock(cookie_jar_->mutex);
+        cookie_jar_->header = cookies;
+    }
+
+    std::time_t HttpClient::get_cookie_expiry() const {
+        std::lock_guard<std::mutex> lock(cookie_jar_->mutex);
+
+        std::time_t earliest = 0;
+        for (const auto& line : cookie_jar_->lines) {
+            // Netscape format: domain, flag, path, secure, expiry, name, value
+            auto fields = Utils::split_string(line, '\t');
+            if (fields.size() < 7) {
+                continue;
+            }
+            std::time_t expiry = static_cast<std::time_t>(std::strtoll(fields[4].c_str(), nullptr, 10));
+            if (expiry > 0 && (earliest == 0 || expiry < earliest)) {
+                earliest = expiry;
+            }
+        }
+        return earliest;
+    }
+
+    std::string HttpClient::build_url(const std::string& url,
+                                      const std::map<std::string, std::string>& params) {
+        // Build query string from params
+        std::string query_string = "";
+        for (const auto& param : params) {
+            if (!query_string.empty()) {
+                query_string += "&";
             }
+            query_string += Utils::url_encode(param.first) + "=" + Utils::url_encode(param.second);
         }
 
-        return false;
+        std::string full_url = url;
+        if (!query_string.empty()) {
+            full_url += "?" + query_string;
+        }
+
+        return full_url;
     }
 
-    std::string HttpClient::perform_request(const std::string& method,
-                                           const std::string& url,
-                                           const std::map<std::string, std::string>& headers,
-                                           const std::string& data) {
+    ResponseBuffer HttpClient::perform_request(const std::string& method,
+                                              const std::string& url,
+                                              const std::map<std::string, std::string>& headers,
+                                              const std::string& data,
+                                              StreamConsumer consumer) {
         // Add user-agent to headers if not already present
         auto request_headers = headers;
         if (request_headers.find("User-Agent") == request_headers.end()) {
             request_headers["User-Agent"] = user_agent_;
         }
 
-        // Retry mechanism
-        for (int attempt = 0; attempt <= retries_; ++attempt) {
-            try {
+#if defined(USE_CPR) || defined(USE_CPP_HTTP_LIB)
+        RetryState retry(get_retry_policy());
+        std::chrono::milliseconds delay(0);
+
+        while (true) {
 #ifdef USE_CPR
-                cpr::Header cpr_headers;
-                for (const auto& header : request_headers) {
-                    cpr_headers.insert({header.first, header.second});
-                }
+            cpr::Header cpr_headers;
+            for (const auto& header : request_headers) {
+                cpr_headers.insert({header.first, header.second});
+            }
 
-                cpr::Parameters cpr_params; // For parameters if needed
-
-                if (method == "GET") {
-                    cpr::Response response = cpr::Get(
-                        cpr::Url{url},
-                        cpr_headers,
-                        cpr::Timeout{timeout_ * 1000}
-                    );
-
-                    if (response.error.code != cpr::ErrorCode::OK) {
-                        std::string error_msg = response.error.message;
-                        if (attempt < retries_ && is_transient_error(error_msg)) {
-                            Utils::sleep_ms(1000 * (attempt + 1)); // Exponential backoff
-                            continue;
-                        } else {
-                            throw HttpClientException("Request failed: " + error_msg);
-                        }
-                    }
+            cpr::Response response;
+            if (method == "GET") {
+                response = cpr::Get(cpr::Url{url}, cpr_headers, cpr::Timeout{timeout_ * 1000});
+            } else if (method == "POST") {
+                response = cpr::Post(cpr::Url{url}, cpr::Body{data}, cpr_headers, cpr::Timeout{timeout_ * 1000});
+            } else {
+                throw HttpClientException("Unsupported HTTP method: " + method);
+            }
 
-                    // Check for HTTP error status codes
-                    if (response.status_code >= 400) {
-                        throw HttpClientException("HTTP error " + std::to_string(response.status_code) +
-                                                 " for URL: " + url);
-                    }
+            // cpr reports network-level failures only, all of them worth another try
+            if (response.error.code != cpr::ErrorCode::OK) {
+                if (retry.should_retry(true, std::chrono::milliseconds(0), delay)) {
+                    Utils::sleep_ms(static_cast<int>(delay.count()));
+                    continue;
+                }
+                throw HttpClientException("Request failed: " + response.error.message);
+            }
 
-                    return response.text;
-                } else if (method == "POST") {
-                    cpr::Response response = cpr::Post(
-                        cpr::Url{url},
-                        cpr::Body{data},
-                        cpr_headers,
-                        cpr::Timeout{timeout_ * 1000}
-                    );
-
-                    if (response.error.code != cpr::ErrorCode::OK) {
-                        std::string error_msg = response.error.message;
-                        if (attempt < retries_ && is_transient_error(error_msg)) {
-                            Utils::sleep_ms(1000 * (attempt + 1)); // Exponential backoff
-                            continue;
-                        } else {
-                            throw HttpClientException("Request failed: " + error_msg);
-                        }
-                    }
+            long status_code = response.status_code;
+            std::string body = std::move(response.text);
+            auto retry_after_header = response.header.find("Retry-After");
+            std::string retry_after_value = retry_after_header != response.header.end() ? retry_after_header->second : "";
+#else
+            httplib::Client client(url);
 
-                    // Check for HTTP error status codes
-                    if (response.status_code >= 400) {
-                        throw HttpClientException("HTTP error " + std::to_string(response.status_code) +
-                                                 " for URL: " + url);
-                    }
+            // Set timeout
+            client.set_connection_timeout(timeout_);
+            client.set_read_timeout(timeout_);
+            client.set_write_timeout(timeout_);
 
-                    return response.text;
-                }
+            if (!proxy_.empty()) {
+                client.set_proxy(proxy_);
+            }
 
-#elif defined(USE_CPP_HTTP_LIB)
-                httplib::Client client(url);
+            httplib::Headers httplib_headers;
+            for (const auto& header : request_headers) {
+                httplib_headers.insert(header);
+            }
 
-                // Set timeout
-                client.set_connection_timeout(timeout_);
-                client.set_read_timeout(timeout_);
-                client.set_write_timeout(timeout_);
+            httplib::Result response;
+            if (method == "GET") {
+                response = client.Get(url.c_str(), httplib_headers);
+            } else if (method == "POST") {
+                response = client.Post(url.c_str(), httplib_headers, data, "application/json");
+            } else {
+                throw HttpClientException("Unsupported HTTP method: " + method);
+            }
 
-                if (!proxy_.empty()) {
-                    client.set_proxy(proxy_);
+            if (!response) {
+                if (retry.should_retry(true, std::chrono::milliseconds(0), delay)) {
+                    Utils::sleep_ms(static_cast<int>(delay.count()));
+                    continue;
                 }
+                throw HttpClientException("Request failed: No response received");
+            }
 
-                httplib::Headers httplib_headers;
-                for (const auto& header : request_headers) {
-                    httplib_headers.insert(header);
-                }
+            long status_code = response->status;
+            std::string body = std::move(response->body);
+            std::string retry_after_value = response->get_header_value("Retry-After");
+#endif
 
-                if (method == "GET") {
-                    auto response = client.Get(url.c_str(), httplib_headers);
-                    if (response) {
-                        if (response->status >= 200 && response->status < 300) {
-                            return response->body;
-                        } else if (response->status >= 400 && response->status < 600) {
-                            // Handle HTTP error codes
-                            if (attempt < retries_) {
-                                Utils::sleep_ms(1000 * (attempt + 1)); // Exponential backoff
-                                continue;
-                            } else {
-                                throw HttpClientException("HTTP error " + std::to_string(response->status) +
-                                                         " for URL: " + url);
-                            }
-                        } else {
-                            // Unexpected status code
-                            if (attempt < retries_) {
-                                Utils::sleep_ms(1000 * (attempt + 1)); // Exponential backoff
-                                continue;
-                            } else {
-                                throw HttpClientException("Unexpected status code " + std::to_string(response->status) +
-                                                         " for URL: " + url);
-                            }
-                        }
-                    } else {
-                        std::string error_msg = "No response received";
-                        if (attempt < retries_ && is_transient_error(error_msg)) {
-                            Utils::sleep_ms(1000 * (attempt + 1)); // Exponential backoff
-                            continue;
-                        } else {
-                            throw HttpClientException("Request failed: " + error_msg);
-                        }
-                    }
-                } else if (method == "POST") {
-                    auto response = client.Post(url.c_str(), httplib_headers, data, "application/json");
-                    if (response) {
-                        if (response->status >= 200 && response->status < 300) {
-                            return response->body;
-                        } else if (response->status >= 400 && response->status < 600) {
-                            // Handle HTTP error codes
-                            if (attempt < retries_) {
-                                Utils::sleep_ms(1000 * (attempt + 1)); // Exponential backoff
-                                continue;
-                            } else {
-                                throw HttpClientException("HTTP error " + std::to_string(response->status) +
-                                                         " for URL: " + url);
-                            }
-                        } else {
-                            // Unexpected status code
-                            if (attempt < retries_) {
-                                Utils::sleep_ms(1000 * (attempt + 1)); // Exponential backoff
-                                continue;
-                            } else {
-                                throw HttpClientException("Unexpected status code " + std::to_string(response->status) +
-                                                         " for URL: " + url);
-                            }
-                        }
-                    } else {
-                        std::string error_msg = "No response received";
-                        if (attempt < retries_ && is_transient_error(error_msg)) {
-                            Utils::sleep_ms(1000 * (attempt + 1)); // Exponential backoff
-                            continue;
-                        } else {
-                            throw HttpClientException("Request failed: " + error_msg);
-                        }
-                    }
-                }
-#else
-                // Using the persistent libcurl handle for cookie/session management
-                if (!curl_handle_) {
-                    throw HttpClientException("CURL handle not initialized");
+            if (status_code >= 400) {
+                // Only the delta-seconds form is honoured by these backends
+                std::chrono::milliseconds retry_after(0);
+                if (!retry_after_value.empty() && std::isdigit(static_cast<unsigned char>(retry_after_value[0]))) {
+                    retry_after = std::chrono::seconds(std::strtol(retry_after_value.c_str(), nullptr, 10));
                 }
 
-                CURLcode res;
-                std::string read_buffer;
+                if (retry.should_retry(RetryPolicy::is_retryable_status(status_code), retry_after, delay)) {
+                    Utils::sleep_ms(static_cast<int>(delay.count()));
+                    continue;
+                }
+                throw HttpClientException("HTTP error " + std::to_string(status_code) + " for URL: " + url, status_code);
+            }
 
-                // Reset the handle to clear previous settings
-                curl_easy_reset(curl_handle_);
+            if (consumer) {
+                consume_response(consumer, url, body.data(), body.size());
+            }
+            return ResponseBuffer(std::move(body));
+        }
+#else
+        // Transient failures are retried by the blocking thread here; async
+        // requests take the same decisions in submit_transfer without sleeping
+        Transfer transfer(*this, method, url, request_headers, data);
+        if (!transfer.handle) {
+            throw HttpClientException("CURL handle not initialized");
+        }
+        transfer.consumer = std::move(consumer);
+
+        std::chrono::milliseconds delay(0);
+        while (true) {
+            // Wait for room in the host's concurrency window and a rate token
+            transfer.limiter->acquire();
+
+            prepare_transfer(transfer);
+            CURLcode res = curl_easy_perform(transfer.handle.get());
+            long response_code = finish_transfer(transfer);
+            if (res == CURLE_OK) {
+                record_response(transfer, response_code);
+            }
 
-                curl_easy_setopt(curl_handle_, CURLOPT_URL, url.c_str());
+            // 429/503 shrink the host's window, successes grow it back
+            transfer.limiter->release(res == CURLE_OK ? response_code : 0);
 
-                if (method == "POST") {
-                    curl_easy_setopt(curl_handle_, CURLOPT_POSTFIELDS, data.c_str());
+            if (res != CURLE_OK || response_code >= 400) {
+                // A body cut off mid-stream is dropped with its parse
+                if (transfer.stream) {
+                    transfer.stream->abort();
+                    transfer.stream.reset();
                 }
 
-                struct curl_slist *chunk = NULL;
-                for (const auto& header : request_headers) {
-                    std::string header_str = header.first + ": " + header.second;
-                    chunk = curl_slist_append(chunk, header_str.c_str());
-                }
-                if (chunk) {
-                    curl_easy_setopt(curl_handle_, CURLOPT_HTTPHEADER, chunk);
+                if (transfer.retry.should_retry(res, response_code, transfer.retry_after, delay)) {
+                    Utils::sleep_ms(static_cast<int>(delay.count()));
+                    continue;
                 }
 
-                if (!proxy_.empty()) {
-                    curl_easy_setopt(curl_handle_, CURLOPT_PROXY, proxy_.c_str());
+                if (res != CURLE_OK) {
+                    throw HttpClientException("Request failed: " + std::string(curl_easy_strerror(res)));
                 }
+                throw HttpClientException("HTTP error " + std::to_string(response_code) +
+                                         " for URL: " + url, response_code);
+            }
 
-                curl_easy_setopt(curl_handle_, CURLOPT_TIMEOUT, timeout_);
-
-                // Enable automatic decompression
-                curl_easy_setopt(curl_handle_, CURLOPT_ACCEPT_ENCODING, "");
-
-                // Use the cookie engine that was initialized in constructor
-                curl_easy_setopt(curl_handle_, CURLOPT_COOKIEFILE, ""); // Enable cookies
-
-                // For reading response
-                curl_easy_setopt(curl_handle_, CURLOPT_WRITEFUNCTION, WriteCallback);
-                curl_easy_setopt(curl_handle_, CURLOPT_WRITEDATA, &read_buffer);
-
-                // Follow redirects as the Python version does
-                curl_easy_setopt(curl_handle_, CURLOPT_FOLLOWLOCATION, 1L);
-
-                res = curl_easy_perform(curl_handle_);
-
-                long response_code;
-                curl_easy_getinfo(curl_handle_, CURLINFO_RESPONSE_CODE, &response_code);
-
-                // Get cookies after the request to update our cookie store
-                struct curl_slist *cookies = NULL;
-                res = curl_easy_getinfo(curl_handle_, CURLINFO_COOKIELIST, &cookies);
-                if (res == CURLE_OK && cookies) {
-                    struct curl_slist *current = cookies;
-                    std::string all_cookies = "";
-
-                    while (current) {
-                        // Extract just the cookie name=value part
-                        std::string cookie_line = std::string(current->data);
-                        size_t tab_pos = cookie_line.rfind('\t');
-                        if (tab_pos != std::string::npos) {
-                            std::string cookie_part = cookie_line.substr(tab_pos + 1);
-                            size_t eq_pos = cookie_part.find('=');
-                            if (eq_pos != std::string::npos) {
-                                if (!cookies_.empty()) {
-                                    cookies_ += "; ";
-                                }
-                                cookies_ += cookie_part;
-                            }
-                        }
-                        current = current->next;
-                    }
-                    curl_slist_free_all(cookies);
+            if (transfer.stream) {
+                // Usually already done: the parser kept pace with the transfer
+                try {
+                    transfer.stream->finish();
+                } catch (const std::exception& e) {
+                    throw HttpClientException("Failed to parse response from " + url + ": " + std::string(e.what()));
                 }
+                transfer.stream.reset();
+            } else if (transfer.consumer) {
+                consume_response(transfer.consumer, url, transfer.response.data(), transfer.response.size());
+            }
 
-                if (chunk) {
-                    curl_slist_free_all(chunk);
-                }
+            return std::move(transfer.response);
+        }
+#endif
+    }
 
-                if (res != CURLE_OK) {
-                    std::string error_msg = curl_easy_strerror(res);
-                    if (attempt < retries_ && is_transient_error(error_msg)) {
-                        Utils::sleep_ms(1000 * (attempt + 1)); // Exponential backoff
-                        continue;
-                    } else {
-                        throw HttpClientException("Request failed: " + error_msg);
-                    }
-                }
+#ifdef USE_CPR
+    // No additional functions needed for CPR
+#elif defined(USE_CPP_HTTP_LIB)
+    // No additional functions needed for cpp-httplib
+#else
+    void HttpClient::prepare_transfer(Transfer& transfer) {
+        CURL* curl = transfer.handle.get();
+
+        // Reset the handle to clear settings left by its previous user;
+        // live connections and the share attachment survive the reset
+        curl_easy_reset(curl);
+        curl_easy_setopt(curl, CURLOPT_SHARE, transfer.async ? ConnectionPool::instance().async_share()
+                                                             : ConnectionPool::instance().share());
+
+        transfer.response.clear();
+        transfer.body_started = false;
+        if (transfer.stream) {
+            transfer.stream->abort();
+            transfer.stream.reset();
+        }
+        if (transfer.header_list) {
+            curl_slist_free_all(transfer.header_list);
+            transfer.header_list = nullptr;
+        }
+
+        curl_easy_setopt(curl, CURLOPT_URL, transfer.url.c_str());
+
+        if (transfer.method == "POST") {
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, transfer.data.c_str());
+        }
+
+        for (const auto& header : transfer.headers) {
+            std::string header_str = header.first + ": " + header.second;
+            transfer.header_list = curl_slist_append(transfer.header_list, header_str.c_str());
+        }
+        if (transfer.header_list) {
+            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, transfer.header_list);
+        }
+
+        if (!transfer.proxy.empty()) {
+            curl_easy_setopt(curl, CURLOPT_PROXY, transfer.proxy.c_str());
+        }
+
+        if (!transfer.ca_info.empty()) {
+            curl_easy_setopt(curl, CURLOPT_CAINFO, transfer.ca_info.c_str());
+        }
+
+        // Never let one attempt run past the call's deadline
+        long timeout_ms = static_cast<long>(transfer.timeout) * 1000;
+        auto remaining = transfer.retry.remaining();
+        if (remaining != std::chrono::milliseconds::max()) {
+            long budget_ms = std::max(static_cast<long>(remaining.count()), 1L);
+            timeout_ms = timeout_ms > 0 ? std::min(timeout_ms, budget_ms) : budget_ms;
+        }
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, timeout_ms);
+
+        // Keep pooled connections alive between requests
+        curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+
+        switch (transfer.http_version) {
+            case HttpVersion::Http2:
+                curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+                break;
+            case HttpVersion::Http2PriorKnowledge:
+                curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2_PRIOR_KNOWLEDGE);
+                break;
+            case HttpVersion::Http1_1:
+            default:
+                curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_1_1);
+                break;
+        }
+        if (transfer.async && transfer.http_version != HttpVersion::Http1_1) {
+            // Wait for an existing HTTP/2 connection to multiplex onto rather
+            // than opening a new connection per concurrent request
+            curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+        }
+
+        // Enable automatic decompression
+        curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "");
+
+        // Pooled handles keep cookies from their previous user, so drop
+        // them and load this client's own cookie jar instead
+        curl_easy_setopt(curl, CURLOPT_COOKIEFILE, ""); // Enable cookies
+        curl_easy_setopt(curl, CURLOPT_COOKIELIST, "ALL");
+        {
+            std::lock_guard<std::mutex> lock(transfer.cookie_jar->mutex);
+            for (const auto& cookie_line : transfer.cookie_jar->lines) {
+                curl_easy_setopt(curl, CURLOPT_COOKIELIST, cookie_line.c_str());
+            }
+        }
+
+        // For reading response
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &transfer);
+
+        // Follow redirects as the Python version does
+        curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+    }
 
-                // Check HTTP response code
-                if (response_code >= 400) {
-                    if (attempt < retries_) {
-                        Utils::sleep_ms(1000 * (attempt + 1)); // Exponential backoff
-                        continue;
-                    } else {
-                        throw HttpClientException("HTTP error " + std::to_string(response_code) +
-                                                 " for URL: " + url);
+    long HttpClient::finish_transfer(Transfer& transfer) {
+        CURL* curl = transfer.handle.get();
+
+        long response_code = 0;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code);
+
+        // Retry-After in seconds, parsed by libcurl from either the delay or the date form
+        curl_off_t retry_after = 0;
+        curl_easy_getinfo(curl, CURLINFO_RETRY_AFTER, &retry_after);
+        transfer.retry_after = std::chrono::seconds(retry_after);
+
+        char* content_type = nullptr;
+        curl_easy_getinfo(curl, CURLINFO_CONTENT_TYPE, &content_type);
+        transfer.content_type = content_type ? content_type : "";
+
+        // Save cookies after the request to update our cookie store
+        struct curl_slist *cookies = NULL;
+        if (curl_easy_getinfo(curl, CURLINFO_COOKIELIST, &cookies) == CURLE_OK && cookies) {
+            std::vector<std::string> lines;
+            std::string all_cookies = "";
+
+            for (struct curl_slist *current = cookies; current; current = current->next) {
+                std::string cookie_line = std::string(current->data);
+                lines.push_back(cookie_line);
+
+                // Netscape format: domain, flag, path, secure, expiry, name, value
+                auto fields = Utils::split_string(cookie_line, '\t');
+                if (fields.size() >= 7) {
+                    if (!all_cookies.empty()) {
+                        all_cookies += "; ";
                     }
+                    all_cookies += fields[5] + "=" + fields[6];
                 }
+            }
+            curl_slist_free_all(cookies);
 
-                return read_buffer;
-#endif
-            } catch (const HttpClientException& e) {
-                // Don't retry for specific HTTP errors (like 404, 401, etc.)
-                throw; // Re-throw HTTP client exceptions immediately
-            } catch (const std::exception& e) {
-                std::string error_msg = e.what();
-                if (attempt < retries_ && is_transient_error(error_msg)) {
-                    Utils::sleep_ms(1000 * (attempt + 1)); // Exponential backoff
-                    continue;
+            std::lock_guard<std::mutex> lock(transfer.cookie_jar->mutex);
+            transfer.cookie_jar->lines = std::move(lines);
+            if (!all_cookies.empty()) {
+                transfer.cookie_jar->header = all_cookies;
+            }
+        }
+
+        // Leave the pooled handle without any of this client's cookies
+        curl_easy_setopt(curl, CURLOPT_COOKIELIST, "ALL");
+
+        if (transfer.header_list) {
+            curl_slist_free_all(transfer.header_list);
+            transfer.header_list = nullptr;
+        }
+
+        return response_code;
+    }
+
+    void HttpClient::record_response(const Transfer& transfer, long response_code) {
+        auto recorder = active_recorder();
+        if (!recorder) {
+            return;
+        }
+
+        FixtureStore::Fixture fixture;
+        fixture.status = response_code;
+        fixture.content_type = transfer.content_type;
+        fixture.body.assign(transfer.response.data(), transfer.response.size());
+        recorder->save(transfer.method, transfer.url, fixture);
+    }
+
+    void HttpClient::submit_transfer(std::shared_ptr<Transfer> transfer,
+                                     BufferCallback callback,
+                                     std::chrono::milliseconds delay) {
+        prepare_transfer(*transfer);
+
+        CURL* handle = transfer->handle.get();
+        RequestLoop::instance().submit(handle, [transfer, callback](CURLcode res) {
+            long response_code = finish_transfer(*transfer);
+            if (res == CURLE_OK) {
+                record_response(*transfer, response_code);
+            }
+            // A transfer aborted at shutdown before admission never took a slot
+            if (transfer->admitted) {
+                transfer->admitted = false;
+                transfer->limiter->release(res == CURLE_OK ? response_code : 0);
+            }
+
+            if (res != CURLE_OK || response_code >= 400) {
+                std::chrono::milliseconds delay(0);
+                if (transfer->retry.should_retry(res, response_code, transfer->retry_after, delay)) {
+                    // Reschedule on the loop instead of holding a thread for the backoff
+                    submit_transfer(transfer, callback, delay);
+                } else if (res != CURLE_OK) {
+                    callback(ResponseBuffer(), std::make_exception_ptr(HttpClientException(
+                        "Request failed: " + std::string(curl_easy_strerror(res)))));
                 } else {
-                    throw HttpClientException("Request failed: " + error_msg);
+                    callback(ResponseBuffer(), std::make_exception_ptr(HttpClientException(
+                        "HTTP error " + std::to_string(response_code) + " for URL: " + transfer->url, response_code)));
                 }
+                return;
             }
-        }
 
-        throw HttpClientException("Max retries exceeded for URL: " + url);
+            callback(std::move(transfer->response), nullptr);
+        }, delay, [transfer]() {
+            // Admission and completion both run on the loop thread
+            auto wait = transfer->limiter->try_acquire();
+            transfer->admitted = wait.count() == 0;
+            return wait;
+        });
     }
 
-#ifdef USE_CPR
-    // No additional functions needed for CPR
-#elif defined(USE_CPP_HTTP_LIB)
-    // No additional functions needed for cpp-httplib
-#else
     // Callback function for libcurl
-    size_t HttpClient::WriteCallback(void *contents, size_t size, size_t nmemb, std::string *userp) {
+    size_t HttpClient::WriteCallback(void *contents, size_t size, size_t nmemb, void *userp) {
+        auto* transfer = static_cast<Transfer*>(userp);
         size_t totalSize = size * nmemb;
-        userp->append((char*)contents, totalSize);
+
+        if (!transfer->body_started) {
+            transfer->body_started = true;
+
+            curl_off_t content_length = -1;
+            curl_easy_getinfo(transfer->handle.get(), CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &content_length);
+
+            // Stream successful bodies that are large (or of unknown size)
+            // into the consumer; error bodies are only buffered
+            if (transfer->consumer) {
+                long status = 0;
+                curl_easy_getinfo(transfer->handle.get(), CURLINFO_RESPONSE_CODE, &status);
+                if (status >= 200 && status < 300 && (content_length < 0 || content_length >= kMinStreamedBody)) {
+                    transfer->stream = std::make_unique<StreamingParser>(transfer->consumer);
+                }
+            }
+            transfer->buffer_body = !transfer->stream || active_recorder() != nullptr;
+
+            // Size the buffer for the whole body up front when the server
+            // announced it, so large responses are received without
+            // reallocating. With a Content-Encoding the announced length is
+            // the compressed one while this callback sees decoded bytes, so
+            // such bodies grow as they arrive instead
+            size_t expected = content_length > 0 && !has_content_encoding(transfer->handle.get())
+                                  ? static_cast<size_t>(content_length)
+                                  : totalSize;
+            if (transfer->buffer_body && transfer->response.capacity() < expected) {
+                transfer->response = BufferPool::instance().acquire(expected);
+            }
+        }
+
+        if (transfer->stream) {
+            transfer->stream->feed(static_cast<const char*>(contents), totalSize);
+        }
+        if (transfer->buffer_body) {
+            transfer->response.append(static_cast<const char*>(contents), totalSize);
+        }
         return totalSize;
     }
 #endif
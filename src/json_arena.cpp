@@ -0,0 +1,41 @@
+#include "json_arena.h"
+
+namespace yfinance {
+
+    namespace {
+        thread_local std::pmr::memory_resource* t_current_resource = nullptr;
+    }
+
+    ArenaScope::ArenaScope(std::pmr::memory_resource* resource) : previous_(t_current_resource) {
+        t_current_resource = resource;
+    }
+
+    ArenaScope::~ArenaScope() {
+        t_current_resource = previous_;
+    }
+
+    std::pmr::memory_resource* ArenaScope::current() {
+        return t_current_resource ? t_current_resource : std::pmr::new_delete_resource();
+    }
+
+    ArenaDocument::ArenaDocument(size_t initial_size)
+        : arena_(std::make_unique<std::pmr::monotonic_buffer_resource>(initial_size)) {
+        ArenaScope scope(arena_.get());
+        root_ = std::make_unique<ArenaJson>();
+    }
+
+    ArenaDocument::~ArenaDocument() {
+        // Nodes are destroyed before the arena; their frees into it are no-ops
+        root_.reset();
+    }
+
+    ArenaDocument& ArenaDocument::operator=(ArenaDocument&& other) noexcept {
+        if (this != &other) {
+            root_.reset();
+            arena_ = std::move(other.arena_);
+            root_ = std::move(other.root_);
+        }
+        return *this;
+    }
+
+} // namespace yfinance
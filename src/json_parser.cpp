@@ -1,15 +1,127 @@
 #include "json_parser.h"
+#include <charconv>
 #include <sstream>
+#include <limits>
 #include <stdexcept>
 
+#ifdef USE_SIMDJSON
+#include "simdjson_input.h"
+#endif
+
 namespace yfinance {
 
+#ifdef USE_SIMDJSON
+    namespace {
+
+        template <typename Value>
+        nlohmann::json scalar_to_json(Value& value, simdjson::ondemand::json_type type) {
+            switch (type) {
+                case simdjson::ondemand::json_type::number:
+                    switch (value.get_number_type().value()) {
+                        case simdjson::ondemand::number_type::signed_integer:
+                            return value.get_int64().value();
+                        case simdjson::ondemand::number_type::unsigned_integer:
+                            return value.get_uint64().value();
+                        case simdjson::ondemand::number_type::floating_point_number:
+                            return value.get_double().value();
+                        default: {
+                            // Beyond 64 bits; nlohmann stores these as double too
+                            std::string_view token = value.raw_json_token();
+                            return std::stod(std::string(token));
+                        }
+                    }
+                case simdjson::ondemand::json_type::string:
+                    return std::string(value.get_string().value());
+                case simdjson::ondemand::json_type::boolean:
+                    return value.get_bool().value();
+                case simdjson::ondemand::json_type::null:
+                default:
+                    return nullptr;
+            }
+        }
+
+        // Build the nlohmann DOM from an on-demand value
+        nlohmann::json to_json(simdjson::ondemand::value value) {
+            auto type = value.type().value();
+            if (type == simdjson::ondemand::json_type::object) {
+                nlohmann::json object = nlohmann::json::object();
+                for (auto field : value.get_object()) {
+                    std::string key(field.unescaped_key().value());
+                    object[std::move(key)] = to_json(field.value());
+                }
+                return object;
+            }
+            if (type == simdjson::ondemand::json_type::array) {
+                nlohmann::json array = nlohmann::json::array();
+                for (auto element : value.get_array()) {
+                    array.push_back(to_json(element.value()));
+                }
+                return array;
+            }
+            return scalar_to_json(value, type);
+        }
+
+    } // namespace
+#endif
+
     nlohmann::json JsonParser::parse(const std::string& json_str) {
+        return parse(json_str.data(), json_str.size());
+    }
+
+    nlohmann::json JsonParser::parse(const char* data, size_t size) {
+#ifdef USE_SIMDJSON
+        try {
+            auto doc = thread_parser().iterate(padded_input(data, size)).value();
+            auto type = doc.type().value();
+
+            nlohmann::json result;
+            if (type == simdjson::ondemand::json_type::object || type == simdjson::ondemand::json_type::array) {
+                result = to_json(doc.get_value().value());
+            } else {
+                result = scalar_to_json(doc, type);
+            }
+
+            if (!doc.at_end()) {
+                throw std::runtime_error("unexpected content after the JSON document");
+            }
+            return result;
+        } catch (const simdjson::simdjson_error& e) {
+            throw std::runtime_error("JSON parse error: " + std::string(e.what()));
+        } catch (const std::runtime_error& e) {
+            throw std::runtime_error("JSON parse error: " + std::string(e.what()));
+        }
+#else
+        try {
+            return nlohmann::json::parse(data, data + size);
+        } catch (const std::exception& e) {
+            throw std::runtime_error("JSON parse error: " + std::string(e.what()));
+        }
+#endif
+    }
+
+    ArenaDocument JsonParser::parse_arena(const std::string& json_str) {
+        return parse_arena(json_str.data(), json_str.size());
+    }
+
+    ArenaDocument JsonParser::parse_arena(const char* data, size_t size) {
+        // A DOM takes a few times the size of its text; start the arena there
+        // so most documents fit in the first block
+        ArenaDocument document(size * 4 + 4096);
+        ArenaScope scope(document.resource());
         try {
-            return nlohmann::json::parse(json_str);
+            document.root() = ArenaJson::parse(data, data + size);
         } catch (const std::exception& e) {
             throw std::runtime_error("JSON parse error: " + std::string(e.what()));
         }
+        return document;
+    }
+
+    const char* JsonParser::backend() {
+#ifdef USE_SIMDJSON
+        return "simdjson";
+#else
+        return "nlohmann";
+#endif
     }
 
     std::string JsonParser::stringify(const nlohmann::json& obj, bool pretty) {
@@ -32,6 +144,61 @@ namespace yfinance {
         }
     }
 
+    const nlohmann::json* JsonParser::find(const nlohmann::json& obj, const std::string& field) {
+        // json::find returns end() for non-objects, so no type check is needed
+        auto it = obj.find(field);
+        return it != obj.end() ? &*it : nullptr;
+    }
+
+    nlohmann::json* JsonParser::find(nlohmann::json& obj, const std::string& field) {
+        auto it = obj.find(field);
+        return it != obj.end() ? &*it : nullptr;
+    }
+
+    const nlohmann::json* JsonParser::find_path(const nlohmann::json& obj, std::initializer_list<const char*> path) {
+        const nlohmann::json* node = &obj;
+        for (const char* key : path) {
+            auto it = node->find(key);
+            if (it == node->end()) {
+                return nullptr;
+            }
+            node = &*it;
+        }
+        return node;
+    }
+
+    nlohmann::json* JsonParser::find_path(nlohmann::json& obj, std::initializer_list<const char*> path) {
+        return const_cast<nlohmann::json*>(find_path(static_cast<const nlohmann::json&>(obj), path));
+    }
+
+    const nlohmann::json* JsonParser::find_element(const nlohmann::json& arr, size_t index) {
+        if (!arr.is_array() || index >= arr.size()) {
+            return nullptr;
+        }
+        return &arr[index];
+    }
+
+    nlohmann::json* JsonParser::find_element(nlohmann::json& arr, size_t index) {
+        if (!arr.is_array() || index >= arr.size()) {
+            return nullptr;
+        }
+        return &arr[index];
+    }
+
+    const nlohmann::json& JsonParser::get_field(const nlohmann::json& obj, const std::string& field) {
+        if (const nlohmann::json* value = find(obj, field)) {
+            return *value;
+        }
+        throw std::runtime_error("Field '" + field + "' not found in JSON object");
+    }
+
+    nlohmann::json& JsonParser::get_field(nlohmann::json& obj, const std::string& field) {
+        if (nlohmann::json* value = find(obj, field)) {
+            return *value;
+        }
+        throw std::runtime_error("Field '" + field + "' not found in JSON object");
+    }
+
     bool JsonParser::has_field(const nlohmann::json& obj, const std::string& field) {
         return obj.contains(field);
     }
@@ -71,4 +238,112 @@ namespace yfinance {
         return keys;
     }
 
-} // namespace yfinance
\ No newline at end of file
+    JsonPath::JsonPath(const std::string& path) : path_(path) {
+        auto fail = [&path](const std::string& reason) {
+            return std::invalid_argument("Invalid JSON path '" + path + "': " + reason);
+        };
+
+        size_t pos = 0;
+        const size_t n = path.size();
+        // Optional JSONPath-style root
+        if (path.compare(0, 1, "$") == 0) {
+            pos = 1;
+        }
+
+        bool expect_key = pos == 0;
+        while (pos < n) {
+            char c = path[pos];
+            if (c == '.') {
+                if (expect_key) {
+                    throw fail("empty key at offset " + std::to_string(pos));
+                }
+                expect_key = true;
+                ++pos;
+            } else if (c == '[') {
+                size_t close = path.find(']', pos);
+                if (close == std::string::npos) {
+                    throw fail("unterminated '['");
+                }
+                std::string inner = path.substr(pos + 1, close - pos - 1);
+
+                Step step;
+                if (inner.size() >= 2 && (inner.front() == '"' || inner.front() == '\'') && inner.back() == inner.front()) {
+                    step.key = inner.substr(1, inner.size() - 2);
+                } else {
+                    // The whole subscript must be an in-range unsigned index
+                    const char* first = inner.data();
+                    const char* last = first + inner.size();
+                    auto [end, ec] = std::from_chars(first, last, step.index);
+                    if (ec != std::errc() || end != last) {
+                        throw fail("bad subscript [" + inner + "]");
+                    }
+                    step.is_index = true;
+                }
+                steps_.push_back(std::move(step));
+                expect_key = false;
+                pos = close + 1;
+            } else {
+                if (!expect_key) {
+                    throw fail("expected '.' or '[' at offset " + std::to_string(pos));
+                }
+                size_t end = path.find_first_of(".[", pos);
+                if (end == std::string::npos) {
+                    end = n;
+                }
+                Step step;
+                step.key = path.substr(pos, end - pos);
+                steps_.push_back(std::move(step));
+                expect_key = false;
+                pos = end;
+            }
+        }
+
+        if (expect_key && !steps_.empty()) {
+            throw fail("trailing '.'");
+        }
+    }
+
+    const nlohmann::json* JsonPath::find(const nlohmann::json& doc) const {
+        const nlohmann::json* node = &doc;
+        for (const Step& step : steps_) {
+            if (step.is_index) {
+                if (!node->is_array() || step.index >= node->size()) {
+                    return nullptr;
+                }
+                node = &(*node)[step.index];
+            } else {
+                auto it = node->find(step.key);
+                if (it == node->end()) {
+                    return nullptr;
+                }
+                node = &*it;
+            }
+        }
+        return node;
+    }
+
+    nlohmann::json* JsonPath::find(nlohmann::json& doc) const {
+        return const_cast<nlohmann::json*>(find(static_cast<const nlohmann::json&>(doc)));
+    }
+
+    double JsonPath::number_or(const nlohmann::json& doc, double fallback) const {
+        const nlohmann::json* node = find(doc);
+        return node && node->is_number() ? node->get<double>() : fallback;
+    }
+
+    void JsonPath::find_all(const std::vector<nlohmann::json>& docs, std::vector<const nlohmann::json*>& out) const {
+        out.resize(docs.size());
+        for (size_t i = 0; i < docs.size(); ++i) {
+            out[i] = find(docs[i]);
+        }
+    }
+
+    void JsonPath::numbers(const std::vector<nlohmann::json>& docs, std::vector<double>& out) const {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        out.resize(docs.size());
+        for (size_t i = 0; i < docs.size(); ++i) {
+            out[i] = number_or(docs[i], nan);
+        }
+    }
+
+} // namespace yfinance
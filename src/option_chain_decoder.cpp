@@ -0,0 +1,286 @@
+#include "option_chain_decoder.h"
+
+#include <stdexcept>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace yfinance {
+
+    namespace {
+
+        /**
+         * SAX handler tracking where in the options document it is through a
+         * stack of contexts, like the chart decoder's. Containers that are not
+         * needed (the quote apart from its price, hasMiniOptions, ...) are
+         * pushed as Skip.
+         */
+        class OptionChainHandler : public nlohmann::json_sax<nlohmann::json> {
+        public:
+            explicit OptionChainHandler(OptionChain& chain) : chain_(chain) {}
+
+            bool null() override {
+                return true;
+            }
+
+            bool boolean(bool value) override {
+                if (context() == Context::Contract && key_ == "inTheMoney") {
+                    chain_.in_the_money.back() = value ? 1 : 0;
+                }
+                return true;
+            }
+
+            bool number_integer(number_integer_t value) override {
+                return on_integer(static_cast<int64_t>(value));
+            }
+
+            bool number_unsigned(number_unsigned_t value) override {
+                return on_integer(static_cast<int64_t>(value));
+            }
+
+            bool number_float(number_float_t value, const string_t& /*text*/) override {
+                return on_number(value);
+            }
+
+            bool string(string_t& value) override {
+                switch (context()) {
+                    case Context::Contract:
+                        if (key_ == "contractSymbol") {
+                            chain_.contract_symbol.back() = std::move(value);
+                        }
+                        break;
+                    case Context::Result:
+                        if (key_ == "underlyingSymbol") {
+                            chain_.underlying_symbol = std::move(value);
+                        }
+                        break;
+                    case Context::Error:
+                        if (key_ == "description" || (key_ == "code" && error_.empty())) {
+                            error_ = value;
+                        }
+                        break;
+                    default:
+                        break;
+                }
+                return true;
+            }
+
+            bool binary(binary_t& /*value*/) override {
+                return true;
+            }
+
+            bool start_object(std::size_t /*elements*/) override {
+                Context parent = context();
+                Context child = Context::Skip;
+
+                switch (parent) {
+                    case Context::Root:
+                        // The document itself, then its "optionChain" member
+                        if (stack_.empty()) {
+                            child = Context::Root;
+                        } else if (key_ == "optionChain") {
+                            child = Context::Chain;
+                        }
+                        break;
+                    case Context::Chain:
+                        child = key_ == "error" ? Context::Error : Context::Skip;
+                        break;
+                    case Context::ResultList:
+                        child = results_++ == 0 ? Context::Result : Context::Skip;
+                        break;
+                    case Context::Result:
+                        child = key_ == "quote" ? Context::Quote : Context::Skip;
+                        break;
+                    case Context::OptionsList:
+                        child = Context::Expiry;
+                        break;
+                    case Context::Contracts:
+                        append_contract();
+                        child = Context::Contract;
+                        break;
+                    default:
+                        break;
+                }
+
+                stack_.push_back(child);
+                return true;
+            }
+
+            bool key(string_t& value) override {
+                key_ = std::move(value);
+                return true;
+            }
+
+            bool end_object() override {
+                stack_.pop_back();
+                return true;
+            }
+
+            bool start_array(std::size_t /*elements*/) override {
+                Context parent = context();
+                Context child = Context::Skip;
+
+                switch (parent) {
+                    case Context::Chain:
+                        if (key_ == "result") {
+                            child = Context::ResultList;
+                            has_result_list_ = true;
+                        }
+                        break;
+                    case Context::Result:
+                        if (key_ == "expirationDates") {
+                            child = Context::Expirations;
+                        } else if (key_ == "strikes") {
+                            child = Context::Strikes;
+                        } else if (key_ == "options") {
+                            child = Context::OptionsList;
+                        }
+                        break;
+                    case Context::Expiry:
+                        if (key_ == "calls" || key_ == "puts") {
+                            calls_ = key_ == "calls";
+                            child = Context::Contracts;
+                        }
+                        break;
+                    default:
+                        break;
+                }
+
+                stack_.push_back(child);
+                return true;
+            }
+
+            bool end_array() override {
+                stack_.pop_back();
+                return true;
+            }
+
+            bool parse_error(std::size_t /*position*/, const std::string& /*last_token*/,
+                             const nlohmann::detail::exception& ex) override {
+                throw std::runtime_error("JSON parse error: " + std::string(ex.what()));
+            }
+
+            const std::string& error() const { return error_; }
+            bool has_result() const { return results_ > 0; }
+            bool has_result_list() const { return has_result_list_; }
+
+        private:
+            enum class Context {
+                Root, Chain, Error, ResultList, Result, Quote,
+                Expirations, Strikes, OptionsList, Expiry, Contracts, Contract,
+                Skip
+            };
+
+            OptionChain& chain_;
+            std::vector<Context> stack_;
+            std::string key_;
+            std::string error_;
+
+            int results_ = 0;
+            bool has_result_list_ = false;
+            bool calls_ = true;  // Whether the current contract list is "calls"
+
+            Context context() const {
+                return stack_.empty() ? Context::Root : stack_.back();
+            }
+
+            // New row with every field missing; the contract's fields fill it in
+            void append_contract() {
+                chain_.contract_symbol.emplace_back();
+                chain_.strike.push_back(kMissingValue);
+                chain_.last_price.push_back(kMissingValue);
+                chain_.bid.push_back(kMissingValue);
+                chain_.ask.push_back(kMissingValue);
+                chain_.change.push_back(kMissingValue);
+                chain_.percent_change.push_back(kMissingValue);
+                chain_.volume.push_back(0);
+                chain_.open_interest.push_back(0);
+                chain_.implied_volatility.push_back(kMissingValue);
+                chain_.expiration.push_back(0);
+                chain_.last_trade_date.push_back(0);
+                chain_.is_call.push_back(calls_ ? 1 : 0);
+                chain_.in_the_money.push_back(0);
+            }
+
+            bool on_integer(int64_t value) {
+                switch (context()) {
+                    case Context::Contract:
+                        if (!contract_integer(value)) {
+                            contract_number(static_cast<double>(value));
+                        }
+                        break;
+                    case Context::Expirations:
+                        chain_.expiration_dates.push_back(value);
+                        break;
+                    default:
+                        return on_number(static_cast<double>(value));
+                }
+                return true;
+            }
+
+            bool on_number(double value) {
+                switch (context()) {
+                    case Context::Contract:
+                        contract_number(value);
+                        break;
+                    case Context::Quote:
+                        if (key_ == "regularMarketPrice") {
+                            chain_.underlying_price = value;
+                        }
+                        break;
+                    case Context::Strikes:
+                        chain_.strikes.push_back(value);
+                        break;
+                    case Context::Expirations:
+                        chain_.expiration_dates.push_back(static_cast<int64_t>(value));
+                        break;
+                    default:
+                        break;
+                }
+                return true;
+            }
+
+            // Integer columns; returns false if the key is not one of them
+            bool contract_integer(int64_t value) {
+                if (key_ == "volume") chain_.volume.back() = value;
+                else if (key_ == "openInterest") chain_.open_interest.back() = value;
+                else if (key_ == "expiration") chain_.expiration.back() = value;
+                else if (key_ == "lastTradeDate") chain_.last_trade_date.back() = value;
+                else return false;
+                return true;
+            }
+
+            void contract_number(double value) {
+                if (key_ == "strike") chain_.strike.back() = value;
+                else if (key_ == "lastPrice") chain_.last_price.back() = value;
+                else if (key_ == "bid") chain_.bid.back() = value;
+                else if (key_ == "ask") chain_.ask.back() = value;
+                else if (key_ == "change") chain_.change.back() = value;
+                else if (key_ == "percentChange") chain_.percent_change.back() = value;
+                else if (key_ == "impliedVolatility") chain_.implied_volatility.back() = value;
+                else contract_integer(static_cast<int64_t>(value));
+            }
+        };
+
+    } // namespace
+
+    OptionChain OptionChainDecoder::decode(const char* data, size_t size) {
+        OptionChain chain;
+        OptionChainHandler handler(chain);
+        nlohmann::json::sax_parse(data, data + size, &handler);
+
+        if (!handler.error().empty()) {
+            throw std::runtime_error("Options request failed: " + handler.error());
+        }
+        // An empty result list is how a symbol without listed options answers
+        if (!handler.has_result() && !handler.has_result_list()) {
+            throw std::runtime_error("Options response contains no result");
+        }
+        return chain;
+    }
+
+    OptionChain OptionChainDecoder::decode(const std::string& payload) {
+        return decode(payload.data(), payload.size());
+    }
+
+} // namespace yfinance
@@ -0,0 +1,460 @@
+#include "price_kernels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define YF_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace yfinance {
+
+    namespace {
+
+        constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+        // Running totals of stats(); min/max stay +-infinity until a value is seen
+        struct Totals {
+            size_t count = 0;
+            double sum = 0.0;
+            double min = kInfinity;
+            double max = -kInfinity;
+        };
+
+        struct VwapTotals {
+            double price_volume = 0.0;
+            double volume = 0.0;
+        };
+
+        // Scalar kernels; the vector kernels use them for the tail that does
+        // not fill a whole register
+
+        void stats_scalar(const double* values, size_t begin, size_t end, Totals& totals) {
+            for (size_t i = begin; i < end; ++i) {
+                double value = values[i];
+                if (!std::isnan(value)) {
+                    ++totals.count;
+                    totals.sum += value;
+                    totals.min = std::min(totals.min, value);
+                    totals.max = std::max(totals.max, value);
+                }
+            }
+        }
+
+        void vwap_scalar(const double* price, const double* volume, size_t begin, size_t end, VwapTotals& totals) {
+            for (size_t i = begin; i < end; ++i) {
+                if (!std::isnan(price[i]) && !std::isnan(volume[i])) {
+                    totals.price_volume += price[i] * volume[i];
+                    totals.volume += volume[i];
+                }
+            }
+        }
+
+        // Same NaN rules as the max_pd sequence in the vector kernels
+        double true_range_bar(double high, double low, double prev_close) {
+            double range = high - low;
+            if (std::isnan(range) || std::isnan(prev_close)) {
+                return range;
+            }
+            return std::max(std::fabs(low - prev_close), std::max(std::fabs(high - prev_close), range));
+        }
+
+        // Bars [begin, end) with begin >= 1
+        void true_range_scalar(const double* high, const double* low, const double* close,
+                               double* out, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                out[i] = true_range_bar(high[i], low[i], close[i - 1]);
+            }
+        }
+
+        Totals stats_scalar_kernel(const double* values, size_t size) {
+            Totals totals;
+            stats_scalar(values, 0, size, totals);
+            return totals;
+        }
+
+        VwapTotals vwap_scalar_kernel(const double* price, const double* volume, size_t size) {
+            VwapTotals totals;
+            vwap_scalar(price, volume, 0, size, totals);
+            return totals;
+        }
+
+        void true_range_scalar_kernel(const double* high, const double* low, const double* close,
+                                      double* out, size_t size) {
+            true_range_scalar(high, low, close, out, 1, size);
+        }
+
+#ifdef YF_KERNELS_X86
+        // Vector kernels. NaN is masked out with an ordered compare; min/max
+        // take the accumulator as their second operand, which *_min_pd and
+        // *_max_pd return whenever the other operand is NaN.
+
+        __attribute__((target("sse2")))
+        Totals stats_sse2(const double* values, size_t size) {
+            __m128d sum = _mm_setzero_pd();
+            __m128d min = _mm_set1_pd(kInfinity);
+            __m128d max = _mm_set1_pd(-kInfinity);
+            __m128i count = _mm_setzero_si128();
+
+            size_t i = 0;
+            for (; i + 2 <= size; i += 2) {
+                __m128d v = _mm_loadu_pd(values + i);
+                __m128d present = _mm_cmpord_pd(v, v);
+                sum = _mm_add_pd(sum, _mm_and_pd(v, present));
+                min = _mm_min_pd(v, min);
+                max = _mm_max_pd(v, max);
+                // A set compare lane is -1 as an integer
+                count = _mm_sub_epi64(count, _mm_castpd_si128(present));
+            }
+
+            alignas(16) double lanes[3][2];
+            alignas(16) int64_t counts[2];
+            _mm_store_pd(lanes[0], sum);
+            _mm_store_pd(lanes[1], min);
+            _mm_store_pd(lanes[2], max);
+            _mm_store_si128(reinterpret_cast<__m128i*>(counts), count);
+
+            Totals totals;
+            totals.count = static_cast<size_t>(counts[0] + counts[1]);
+            totals.sum = lanes[0][0] + lanes[0][1];
+            totals.min = std::min(lanes[1][0], lanes[1][1]);
+            totals.max = std::max(lanes[2][0], lanes[2][1]);
+            stats_scalar(values, i, size, totals);
+            return totals;
+        }
+
+        __attribute__((target("sse2")))
+        VwapTotals vwap_sse2(const double* price, const double* volume, size_t size) {
+            __m128d price_volume = _mm_setzero_pd();
+            __m128d total_volume = _mm_setzero_pd();
+
+            size_t i = 0;
+            for (; i + 2 <= size; i += 2) {
+                __m128d p = _mm_loadu_pd(price + i);
+                __m128d v = _mm_loadu_pd(volume + i);
+                __m128d present = _mm_cmpord_pd(p, v);
+                price_volume = _mm_add_pd(price_volume, _mm_and_pd(_mm_mul_pd(p, v), present));
+                total_volume = _mm_add_pd(total_volume, _mm_and_pd(v, present));
+            }
+
+            alignas(16) double lanes[2][2];
+            _mm_store_pd(lanes[0], price_volume);
+            _mm_store_pd(lanes[1], total_volume);
+
+            VwapTotals totals;
+            totals.price_volume = lanes[0][0] + lanes[0][1];
+            totals.volume = lanes[1][0] + lanes[1][1];
+            vwap_scalar(price, volume, i, size, totals);
+            return totals;
+        }
+
+        __attribute__((target("sse2")))
+        void true_range_sse2(const double* high, const double* low, const double* close,
+                             double* out, size_t size) {
+            const __m128d sign = _mm_set1_pd(-0.0);
+
+            size_t i = 1;
+            for (; i + 2 <= size; i += 2) {
+                __m128d h = _mm_loadu_pd(high + i);
+                __m128d l = _mm_loadu_pd(low + i);
+                __m128d prev = _mm_loadu_pd(close + i - 1);
+                __m128d range = _mm_sub_pd(h, l);
+                __m128d high_gap = _mm_andnot_pd(sign, _mm_sub_pd(h, prev));
+                __m128d low_gap = _mm_andnot_pd(sign, _mm_sub_pd(l, prev));
+                _mm_storeu_pd(out + i, _mm_max_pd(low_gap, _mm_max_pd(high_gap, range)));
+            }
+            true_range_scalar(high, low, close, out, i, size);
+        }
+
+        __attribute__((target("avx2")))
+        Totals stats_avx2(const double* values, size_t size) {
+            __m256d sum = _mm256_setzero_pd();
+            __m256d min = _mm256_set1_pd(kInfinity);
+            __m256d max = _mm256_set1_pd(-kInfinity);
+            __m256i count = _mm256_setzero_si256();
+
+            size_t i = 0;
+            for (; i + 4 <= size; i += 4) {
+                __m256d v = _mm256_loadu_pd(values + i);
+                __m256d present = _mm256_cmp_pd(v, v, _CMP_ORD_Q);
+                sum = _mm256_add_pd(sum, _mm256_and_pd(v, present));
+                min = _mm256_min_pd(v, min);
+                max = _mm256_max_pd(v, max);
+                count = _mm256_sub_epi64(count, _mm256_castpd_si256(present));
+            }
+
+            alignas(32) double lanes[3][4];
+            alignas(32) int64_t counts[4];
+            _mm256_store_pd(lanes[0], sum);
+            _mm256_store_pd(lanes[1], min);
+            _mm256_store_pd(lanes[2], max);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(counts), count);
+
+            Totals totals;
+            totals.count = static_cast<size_t>((counts[0] + counts[1]) + (counts[2] + counts[3]));
+            totals.sum = (lanes[0][0] + lanes[0][1]) + (lanes[0][2] + lanes[0][3]);
+            totals.min = std::min(std::min(lanes[1][0], lanes[1][1]), std::min(lanes[1][2], lanes[1][3]));
+            totals.max = std::max(std::max(lanes[2][0], lanes[2][1]), std::max(lanes[2][2], lanes[2][3]));
+            stats_scalar(values, i, size, totals);
+            return totals;
+        }
+
+        __attribute__((target("avx2")))
+        VwapTotals vwap_avx2(const double* price, const double* volume, size_t size) {
+            __m256d price_volume = _mm256_setzero_pd();
+            __m256d total_volume = _mm256_setzero_pd();
+
+            size_t i = 0;
+            for (; i + 4 <= size; i += 4) {
+                __m256d p = _mm256_loadu_pd(price + i);
+                __m256d v = _mm256_loadu_pd(volume + i);
+                __m256d present = _mm256_cmp_pd(p, v, _CMP_ORD_Q);
+                price_volume = _mm256_add_pd(price_volume, _mm256_and_pd(_mm256_mul_pd(p, v), present));
+                total_volume = _mm256_add_pd(total_volume, _mm256_and_pd(v, present));
+            }
+
+            alignas(32) double lanes[2][4];
+            _mm256_store_pd(lanes[0], price_volume);
+            _mm256_store_pd(lanes[1], total_volume);
+
+            VwapTotals totals;
+            totals.price_volume = (lanes[0][0] + lanes[0][1]) + (lanes[0][2] + lanes[0][3]);
+            totals.volume = (lanes[1][0] + lanes[1][1]) + (lanes[1][2] + lanes[1][3]);
+            vwap_scalar(price, volume, i, size, totals);
+            return totals;
+        }
+
+        __attribute__((target("avx2")))
+        void true_range_avx2(const double* high, const double* low, const double* close,
+                             double* out, size_t size) {
+            const __m256d sign = _mm256_set1_pd(-0.0);
+
+            size_t i = 1;
+            for (; i + 4 <= size; i += 4) {
+                __m256d h = _mm256_loadu_pd(high + i);
+                __m256d l = _mm256_loadu_pd(low + i);
+                __m256d prev = _mm256_loadu_pd(close + i - 1);
+                __m256d range = _mm256_sub_pd(h, l);
+                __m256d high_gap = _mm256_andnot_pd(sign, _mm256_sub_pd(h, prev));
+                __m256d low_gap = _mm256_andnot_pd(sign, _mm256_sub_pd(l, prev));
+                _mm256_storeu_pd(out + i, _mm256_max_pd(low_gap, _mm256_max_pd(high_gap, range)));
+            }
+            true_range_scalar(high, low, close, out, i, size);
+        }
+
+        // The unmasked _mm512_min_pd/_mm512_max_pd trip -Wmaybe-uninitialized
+        // in GCC 12's headers, so the AVX-512 kernels use maskz with every lane
+        constexpr __mmask8 kAllLanes = 0xFF;
+
+        __attribute__((target("avx512f")))
+        Totals stats_avx512(const double* values, size_t size) {
+            __m512d sum = _mm512_setzero_pd();
+            __m512d min = _mm512_set1_pd(kInfinity);
+            __m512d max = _mm512_set1_pd(-kInfinity);
+            const __m512i one = _mm512_set1_epi64(1);
+            __m512i count = _mm512_setzero_si512();
+
+            size_t i = 0;
+            for (; i + 8 <= size; i += 8) {
+                __m512d v = _mm512_loadu_pd(values + i);
+                __mmask8 present = _mm512_cmp_pd_mask(v, v, _CMP_ORD_Q);
+                sum = _mm512_mask_add_pd(sum, present, sum, v);
+                min = _mm512_maskz_min_pd(kAllLanes, v, min);
+                max = _mm512_maskz_max_pd(kAllLanes, v, max);
+                count = _mm512_mask_add_epi64(count, present, count, one);
+            }
+
+            alignas(64) double lanes[3][8];
+            alignas(64) int64_t counts[8];
+            _mm512_store_pd(lanes[0], sum);
+            _mm512_store_pd(lanes[1], min);
+            _mm512_store_pd(lanes[2], max);
+            _mm512_store_si512(counts, count);
+
+            Totals totals;
+            for (int lane = 0; lane < 8; ++lane) {
+                totals.count += static_cast<size_t>(counts[lane]);
+                totals.sum += lanes[0][lane];
+                totals.min = std::min(totals.min, lanes[1][lane]);
+                totals.max = std::max(totals.max, lanes[2][lane]);
+            }
+            stats_scalar(values, i, size, totals);
+            return totals;
+        }
+
+        __attribute__((target("avx512f")))
+        VwapTotals vwap_avx512(const double* price, const double* volume, size_t size) {
+            __m512d price_volume = _mm512_setzero_pd();
+            __m512d total_volume = _mm512_setzero_pd();
+
+            size_t i = 0;
+            for (; i + 8 <= size; i += 8) {
+                __m512d p = _mm512_loadu_pd(price + i);
+                __m512d v = _mm512_loadu_pd(volume + i);
+                __mmask8 present = _mm512_cmp_pd_mask(p, v, _CMP_ORD_Q);
+                price_volume = _mm512_mask_add_pd(price_volume, present, price_volume, _mm512_mul_pd(p, v));
+                total_volume = _mm512_mask_add_pd(total_volume, present, total_volume, v);
+            }
+
+            alignas(64) double lanes[2][8];
+            _mm512_store_pd(lanes[0], price_volume);
+            _mm512_store_pd(lanes[1], total_volume);
+
+            VwapTotals totals;
+            for (int lane = 0; lane < 8; ++lane) {
+                totals.price_volume += lanes[0][lane];
+                totals.volume += lanes[1][lane];
+            }
+            vwap_scalar(price, volume, i, size, totals);
+            return totals;
+        }
+
+        __attribute__((target("avx512f")))
+        void true_range_avx512(const double* high, const double* low, const double* close,
+                               double* out, size_t size) {
+            size_t i = 1;
+            for (; i + 8 <= size; i += 8) {
+                __m512d h = _mm512_loadu_pd(high + i);
+                __m512d l = _mm512_loadu_pd(low + i);
+                __m512d prev = _mm512_loadu_pd(close + i - 1);
+                __m512d range = _mm512_sub_pd(h, l);
+                __m512d high_gap = _mm512_abs_pd(_mm512_sub_pd(h, prev));
+                __m512d low_gap = _mm512_abs_pd(_mm512_sub_pd(l, prev));
+                __m512d widest = _mm512_maskz_max_pd(kAllLanes, high_gap, range);
+                _mm512_storeu_pd(out + i, _mm512_maskz_max_pd(kAllLanes, low_gap, widest));
+            }
+            true_range_scalar(high, low, close, out, i, size);
+        }
+#endif
+
+        struct KernelTable {
+            Totals (*stats)(const double* values, size_t size);
+            VwapTotals (*vwap)(const double* price, const double* volume, size_t size);
+            void (*true_range)(const double* high, const double* low, const double* close,
+                               double* out, size_t size);
+        };
+
+        const KernelTable& kernels_for(SimdLevel level) {
+            static const KernelTable scalar = {stats_scalar_kernel, vwap_scalar_kernel, true_range_scalar_kernel};
+#ifdef YF_KERNELS_X86
+            static const KernelTable sse2 = {stats_sse2, vwap_sse2, true_range_sse2};
+            static const KernelTable avx2 = {stats_avx2, vwap_avx2, true_range_avx2};
+            static const KernelTable avx512 = {stats_avx512, vwap_avx512, true_range_avx512};
+            switch (level) {
+                case SimdLevel::SSE2: return sse2;
+                case SimdLevel::AVX2: return avx2;
+                case SimdLevel::AVX512: return avx512;
+                default: break;
+            }
+#else
+            (void)level;
+#endif
+            return scalar;
+        }
+
+        SimdLevel detect_level() {
+#ifdef YF_KERNELS_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) {
+                return SimdLevel::AVX512;
+            }
+            if (__builtin_cpu_supports("avx2")) {
+                return SimdLevel::AVX2;
+            }
+            if (__builtin_cpu_supports("sse2")) {
+                return SimdLevel::SSE2;
+            }
+#endif
+            return SimdLevel::Scalar;
+        }
+
+        std::atomic<SimdLevel>& active_level() {
+            static std::atomic<SimdLevel> level{PriceKernels::detected_level()};
+            return level;
+        }
+
+        const KernelTable& kernels() {
+            return kernels_for(active_level().load(std::memory_order_relaxed));
+        }
+
+    } // namespace
+
+    const char* simd_level_name(SimdLevel level) {
+        switch (level) {
+            case SimdLevel::Scalar: return "scalar";
+            case SimdLevel::SSE2: return "SSE2";
+            case SimdLevel::AVX2: return "AVX2";
+            case SimdLevel::AVX512: return "AVX-512";
+        }
+        return "unknown";
+    }
+
+    SimdLevel PriceKernels::detected_level() {
+        static const SimdLevel level = detect_level();
+        return level;
+    }
+
+    SimdLevel PriceKernels::level() {
+        return active_level().load();
+    }
+
+    void PriceKernels::set_level(SimdLevel level) {
+        if (level > detected_level()) {
+            throw std::invalid_argument(std::string(simd_level_name(level)) + " is not supported by this CPU");
+        }
+        active_level().store(level);
+    }
+
+    ColumnStats PriceKernels::stats(Span<const double> values) {
+        Totals totals = kernels().stats(values.data(), values.size());
+
+        ColumnStats stats;
+        stats.count = totals.count;
+        stats.sum = totals.sum;
+        if (totals.count > 0) {
+            stats.min = totals.min;
+            stats.max = totals.max;
+            stats.mean = totals.sum / static_cast<double>(totals.count);
+        }
+        return stats;
+    }
+
+    double PriceKernels::vwap(Span<const double> price, Span<const double> volume) {
+        if (price.size() != volume.size()) {
+            throw std::invalid_argument("VWAP needs price and volume columns of equal length");
+        }
+        VwapTotals totals = kernels().vwap(price.data(), volume.data(), price.size());
+        return totals.volume != 0.0 ? totals.price_volume / totals.volume : kMissingValue;
+    }
+
+    void PriceKernels::true_range(Span<const double> high, Span<const double> low,
+                                  Span<const double> close, Span<double> out) {
+        size_t size = high.size();
+        if (low.size() != size || close.size() != size || out.size() < size) {
+            throw std::invalid_argument("True range needs high, low, close and output columns of equal length");
+        }
+        if (size == 0) {
+            return;
+        }
+
+        out[0] = high[0] - low[0];
+        kernels().true_range(high.data(), low.data(), close.data(), out.data(), size);
+    }
+
+    double PriceKernels::vwap(const PriceHistory& history) {
+        return vwap(history.close, history.volume);
+    }
+
+    std::vector<double> PriceKernels::true_range(const PriceHistory& history) {
+        std::vector<double> out(history.high.size());
+        true_range(history.high, history.low, history.close, out);
+        return out;
+    }
+
+} // namespace yfinance
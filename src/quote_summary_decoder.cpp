@@ -0,0 +1,277 @@
+#include "quote_summary_decoder.h"
+
+#include <string>
+#include <type_traits>
+
+namespace yfinance {
+
+    namespace {
+
+        // offsetof is only guaranteed for standard-layout types
+        static_assert(std::is_standard_layout<FinancialData>::value &&
+                      std::is_standard_layout<SummaryDetail>::value &&
+                      std::is_standard_layout<DefaultKeyStatistics>::value &&
+                      std::is_standard_layout<QuotePrice>::value,
+                      "typed quoteSummary modules must be standard-layout");
+
+#define YF_FIELD(Struct, key, type, member) FieldDescriptor{key, FieldType::type, offsetof(Struct, member)}
+
+        constexpr FieldDescriptor kFinancialDataFields[] = {
+            YF_FIELD(FinancialData, "currentPrice", Double, current_price),
+            YF_FIELD(FinancialData, "targetHighPrice", Double, target_high_price),
+            YF_FIELD(FinancialData, "targetLowPrice", Double, target_low_price),
+            YF_FIELD(FinancialData, "targetMeanPrice", Double, target_mean_price),
+            YF_FIELD(FinancialData, "targetMedianPrice", Double, target_median_price),
+            YF_FIELD(FinancialData, "recommendationMean", Double, recommendation_mean),
+            YF_FIELD(FinancialData, "numberOfAnalystOpinions", Int64, number_of_analyst_opinions),
+            YF_FIELD(FinancialData, "totalCash", Double, total_cash),
+            YF_FIELD(FinancialData, "totalCashPerShare", Double, total_cash_per_share),
+            YF_FIELD(FinancialData, "ebitda", Double, ebitda),
+            YF_FIELD(FinancialData, "totalDebt", Double, total_debt),
+            YF_FIELD(FinancialData, "quickRatio", Double, quick_ratio),
+            YF_FIELD(FinancialData, "currentRatio", Double, current_ratio),
+            YF_FIELD(FinancialData, "totalRevenue", Double, total_revenue),
+            YF_FIELD(FinancialData, "debtToEquity", Double, debt_to_equity),
+            YF_FIELD(FinancialData, "revenuePerShare", Double, revenue_per_share),
+            YF_FIELD(FinancialData, "returnOnAssets", Double, return_on_assets),
+            YF_FIELD(FinancialData, "returnOnEquity", Double, return_on_equity),
+            YF_FIELD(FinancialData, "grossProfits", Double, gross_profits),
+            YF_FIELD(FinancialData, "freeCashflow", Double, free_cashflow),
+            YF_FIELD(FinancialData, "operatingCashflow", Double, operating_cashflow),
+            YF_FIELD(FinancialData, "earningsGrowth", Double, earnings_growth),
+            YF_FIELD(FinancialData, "revenueGrowth", Double, revenue_growth),
+            YF_FIELD(FinancialData, "grossMargins", Double, gross_margins),
+            YF_FIELD(FinancialData, "ebitdaMargins", Double, ebitda_margins),
+            YF_FIELD(FinancialData, "operatingMargins", Double, operating_margins),
+            YF_FIELD(FinancialData, "profitMargins", Double, profit_margins),
+            YF_FIELD(FinancialData, "recommendationKey", String, recommendation_key),
+            YF_FIELD(FinancialData, "financialCurrency", String, financial_currency),
+        };
+
+        constexpr FieldDescriptor kSummaryDetailFields[] = {
+            YF_FIELD(SummaryDetail, "previousClose", Double, previous_close),
+            YF_FIELD(SummaryDetail, "open", Double, open),
+            YF_FIELD(SummaryDetail, "dayLow", Double, day_low),
+            YF_FIELD(SummaryDetail, "dayHigh", Double, day_high),
+            YF_FIELD(SummaryDetail, "regularMarketPreviousClose", Double, regular_market_previous_close),
+            YF_FIELD(SummaryDetail, "regularMarketOpen", Double, regular_market_open),
+            YF_FIELD(SummaryDetail, "regularMarketDayLow", Double, regular_market_day_low),
+            YF_FIELD(SummaryDetail, "regularMarketDayHigh", Double, regular_market_day_high),
+            YF_FIELD(SummaryDetail, "dividendRate", Double, dividend_rate),
+            YF_FIELD(SummaryDetail, "dividendYield", Double, dividend_yield),
+            YF_FIELD(SummaryDetail, "exDividendDate", Int64, ex_dividend_date),
+            YF_FIELD(SummaryDetail, "payoutRatio", Double, payout_ratio),
+            YF_FIELD(SummaryDetail, "fiveYearAvgDividendYield", Double, five_year_avg_dividend_yield),
+            YF_FIELD(SummaryDetail, "beta", Double, beta),
+            YF_FIELD(SummaryDetail, "trailingPE", Double, trailing_pe),
+            YF_FIELD(SummaryDetail, "forwardPE", Double, forward_pe),
+            YF_FIELD(SummaryDetail, "volume", Int64, volume),
+            YF_FIELD(SummaryDetail, "regularMarketVolume", Int64, regular_market_volume),
+            YF_FIELD(SummaryDetail, "averageVolume", Int64, average_volume),
+            YF_FIELD(SummaryDetail, "averageVolume10days", Int64, average_volume_10days),
+            YF_FIELD(SummaryDetail, "bid", Double, bid),
+            YF_FIELD(SummaryDetail, "ask", Double, ask),
+            YF_FIELD(SummaryDetail, "bidSize", Int64, bid_size),
+            YF_FIELD(SummaryDetail, "askSize", Int64, ask_size),
+            YF_FIELD(SummaryDetail, "marketCap", Int64, market_cap),
+            YF_FIELD(SummaryDetail, "fiftyTwoWeekLow", Double, fifty_two_week_low),
+            YF_FIELD(SummaryDetail, "fiftyTwoWeekHigh", Double, fifty_two_week_high),
+            YF_FIELD(SummaryDetail, "priceToSalesTrailing12Months", Double, price_to_sales_trailing_12_months),
+            YF_FIELD(SummaryDetail, "fiftyDayAverage", Double, fifty_day_average),
+            YF_FIELD(SummaryDetail, "twoHundredDayAverage", Double, two_hundred_day_average),
+            YF_FIELD(SummaryDetail, "trailingAnnualDividendRate", Double, trailing_annual_dividend_rate),
+            YF_FIELD(SummaryDetail, "trailingAnnualDividendYield", Double, trailing_annual_dividend_yield),
+            YF_FIELD(SummaryDetail, "currency", String, currency),
+        };
+
+        constexpr FieldDescriptor kDefaultKeyStatisticsFields[] = {
+            YF_FIELD(DefaultKeyStatistics, "enterpriseValue", Int64, enterprise_value),
+            YF_FIELD(DefaultKeyStatistics, "forwardPE", Double, forward_pe),
+            YF_FIELD(DefaultKeyStatistics, "profitMargins", Double, profit_margins),
+            YF_FIELD(DefaultKeyStatistics, "floatShares", Int64, float_shares),
+            YF_FIELD(DefaultKeyStatistics, "sharesOutstanding", Int64, shares_outstanding),
+            YF_FIELD(DefaultKeyStatistics, "sharesShort", Int64, shares_short),
+            YF_FIELD(DefaultKeyStatistics, "shortRatio", Double, short_ratio),
+            YF_FIELD(DefaultKeyStatistics, "shortPercentOfFloat", Double, short_percent_of_float),
+            YF_FIELD(DefaultKeyStatistics, "heldPercentInsiders", Double, held_percent_insiders),
+            YF_FIELD(DefaultKeyStatistics, "heldPercentInstitutions", Double, held_percent_institutions),
+            YF_FIELD(DefaultKeyStatistics, "beta", Double, beta),
+            YF_FIELD(DefaultKeyStatistics, "bookValue", Double, book_value),
+            YF_FIELD(DefaultKeyStatistics, "priceToBook", Double, price_to_book),
+            YF_FIELD(DefaultKeyStatistics, "lastFiscalYearEnd", Int64, last_fiscal_year_end),
+            YF_FIELD(DefaultKeyStatistics, "nextFiscalYearEnd", Int64, next_fiscal_year_end),
+            YF_FIELD(DefaultKeyStatistics, "mostRecentQuarter", Int64, most_recent_quarter),
+            YF_FIELD(DefaultKeyStatistics, "netIncomeToCommon", Int64, net_income_to_common),
+            YF_FIELD(DefaultKeyStatistics, "trailingEps", Double, trailing_eps),
+            YF_FIELD(DefaultKeyStatistics, "forwardEps", Double, forward_eps),
+            YF_FIELD(DefaultKeyStatistics, "pegRatio", Double, peg_ratio),
+            YF_FIELD(DefaultKeyStatistics, "enterpriseToRevenue", Double, enterprise_to_revenue),
+            YF_FIELD(DefaultKeyStatistics, "enterpriseToEbitda", Double, enterprise_to_ebitda),
+            YF_FIELD(DefaultKeyStatistics, "52WeekChange", Double, fifty_two_week_change),
+            YF_FIELD(DefaultKeyStatistics, "SandP52WeekChange", Double, sandp_fifty_two_week_change),
+            YF_FIELD(DefaultKeyStatistics, "lastSplitDate", Int64, last_split_date),
+            YF_FIELD(DefaultKeyStatistics, "lastDividendValue", Double, last_dividend_value),
+            YF_FIELD(DefaultKeyStatistics, "lastDividendDate", Int64, last_dividend_date),
+            YF_FIELD(DefaultKeyStatistics, "lastSplitFactor", String, last_split_factor),
+        };
+
+        constexpr FieldDescriptor kQuotePriceFields[] = {
+            YF_FIELD(QuotePrice, "regularMarketPrice", Double, regular_market_price),
+            YF_FIELD(QuotePrice, "regularMarketChange", Double, regular_market_change),
+            YF_FIELD(QuotePrice, "regularMarketChangePercent", Double, regular_market_change_percent),
+            YF_FIELD(QuotePrice, "regularMarketDayHigh", Double, regular_market_day_high),
+            YF_FIELD(QuotePrice, "regularMarketDayLow", Double, regular_market_day_low),
+            YF_FIELD(QuotePrice, "regularMarketOpen", Double, regular_market_open),
+            YF_FIELD(QuotePrice, "regularMarketPreviousClose", Double, regular_market_previous_close),
+            YF_FIELD(QuotePrice, "regularMarketTime", Int64, regular_market_time),
+            YF_FIELD(QuotePrice, "regularMarketVolume", Int64, regular_market_volume),
+            YF_FIELD(QuotePrice, "preMarketPrice", Double, pre_market_price),
+            YF_FIELD(QuotePrice, "postMarketPrice", Double, post_market_price),
+            YF_FIELD(QuotePrice, "marketCap", Int64, market_cap),
+            YF_FIELD(QuotePrice, "symbol", String, symbol),
+            YF_FIELD(QuotePrice, "shortName", String, short_name),
+            YF_FIELD(QuotePrice, "longName", String, long_name),
+            YF_FIELD(QuotePrice, "exchange", String, exchange),
+            YF_FIELD(QuotePrice, "exchangeName", String, exchange_name),
+            YF_FIELD(QuotePrice, "quoteType", String, quote_type),
+            YF_FIELD(QuotePrice, "currency", String, currency),
+            YF_FIELD(QuotePrice, "marketState", String, market_state),
+        };
+
+#undef YF_FIELD
+
+        template <typename Module>
+        struct ModuleTraits;
+
+        template <>
+        struct ModuleTraits<FinancialData> {
+            static constexpr const char* name = "financialData";
+            static constexpr const FieldDescriptor* fields = kFinancialDataFields;
+            static constexpr size_t count = sizeof(kFinancialDataFields) / sizeof(FieldDescriptor);
+        };
+
+        template <>
+        struct ModuleTraits<SummaryDetail> {
+            static constexpr const char* name = "summaryDetail";
+            static constexpr const FieldDescriptor* fields = kSummaryDetailFields;
+            static constexpr size_t count = sizeof(kSummaryDetailFields) / sizeof(FieldDescriptor);
+        };
+
+        template <>
+        struct ModuleTraits<DefaultKeyStatistics> {
+            static constexpr const char* name = "defaultKeyStatistics";
+            static constexpr const FieldDescriptor* fields = kDefaultKeyStatisticsFields;
+            static constexpr size_t count = sizeof(kDefaultKeyStatisticsFields) / sizeof(FieldDescriptor);
+        };
+
+        template <>
+        struct ModuleTraits<QuotePrice> {
+            static constexpr const char* name = "price";
+            static constexpr const FieldDescriptor* fields = kQuotePriceFields;
+            static constexpr size_t count = sizeof(kQuotePriceFields) / sizeof(FieldDescriptor);
+        };
+
+        // Value of a field: the "raw" member of a formatted value object, or
+        // the value itself; nullptr for {} (Yahoo's "not available")
+        const nlohmann::json* raw_value(const nlohmann::json& field) {
+            if (field.is_object()) {
+                auto raw = field.find("raw");
+                return raw != field.end() ? &*raw : nullptr;
+            }
+            return field.is_null() ? nullptr : &field;
+        }
+
+        void store(const FieldDescriptor& descriptor, const nlohmann::json& value, char* base) {
+            void* member = base + descriptor.offset;
+            switch (descriptor.type) {
+                case FieldType::Double:
+                    if (value.is_number()) {
+                        *static_cast<double*>(member) = value.get<double>();
+                    }
+                    break;
+                case FieldType::Int64:
+                    if (value.is_number_integer()) {
+                        *static_cast<int64_t*>(member) = value.get<int64_t>();
+                    } else if (value.is_number_float()) {
+                        *static_cast<int64_t*>(member) = static_cast<int64_t>(value.get<double>());
+                    }
+                    break;
+                case FieldType::String:
+                    if (value.is_string()) {
+                        *static_cast<std::string*>(member) = value.get<std::string>();
+                    }
+                    break;
+            }
+        }
+
+    } // namespace
+
+    template <typename Module>
+    Module QuoteSummaryDecoder::decode(const nlohmann::json& module) {
+        using Traits = ModuleTraits<Module>;
+
+        Module decoded;
+        if (!module.is_object()) {
+            return decoded;
+        }
+
+        char* base = reinterpret_cast<char*>(&decoded);
+        for (size_t i = 0; i < Traits::count; ++i) {
+            const FieldDescriptor& descriptor = Traits::fields[i];
+            // Look up by const char*: the transparent comparator avoids a key string
+            auto field = module.find(descriptor.key);
+            if (field == module.end()) {
+                continue;
+            }
+            if (const nlohmann::json* value = raw_value(*field)) {
+                store(descriptor, *value, base);
+            }
+        }
+        return decoded;
+    }
+
+    template <typename Module>
+    const char* QuoteSummaryDecoder::module_name() {
+        return ModuleTraits<Module>::name;
+    }
+
+    template <typename Module>
+    const FieldDescriptor* QuoteSummaryDecoder::fields(size_t& count) {
+        count = ModuleTraits<Module>::count;
+        return ModuleTraits<Module>::fields;
+    }
+
+    QuoteSummary QuoteSummaryDecoder::decode_result(const nlohmann::json& result) {
+        QuoteSummary summary;
+        if (const nlohmann::json* module = JsonParser::find(result, module_name<FinancialData>())) {
+            summary.financial_data = decode<FinancialData>(*module);
+        }
+        if (const nlohmann::json* module = JsonParser::find(result, module_name<SummaryDetail>())) {
+            summary.summary_detail = decode<SummaryDetail>(*module);
+        }
+        if (const nlohmann::json* module = JsonParser::find(result, module_name<DefaultKeyStatistics>())) {
+            summary.key_statistics = decode<DefaultKeyStatistics>(*module);
+        }
+        if (const nlohmann::json* module = JsonParser::find(result, module_name<QuotePrice>())) {
+            summary.price = decode<QuotePrice>(*module);
+        }
+        return summary;
+    }
+
+    // The typed modules are the only instantiations
+    template FinancialData QuoteSummaryDecoder::decode<FinancialData>(const nlohmann::json&);
+    template SummaryDetail QuoteSummaryDecoder::decode<SummaryDetail>(const nlohmann::json&);
+    template DefaultKeyStatistics QuoteSummaryDecoder::decode<DefaultKeyStatistics>(const nlohmann::json&);
+    template QuotePrice QuoteSummaryDecoder::decode<QuotePrice>(const nlohmann::json&);
+
+    template const char* QuoteSummaryDecoder::module_name<FinancialData>();
+    template const char* QuoteSummaryDecoder::module_name<SummaryDetail>();
+    template const char* QuoteSummaryDecoder::module_name<DefaultKeyStatistics>();
+    template const char* QuoteSummaryDecoder::module_name<QuotePrice>();
+
+    template const FieldDescriptor* QuoteSummaryDecoder::fields<FinancialData>(size_t&);
+    template const FieldDescriptor* QuoteSummaryDecoder::fields<SummaryDetail>(size_t&);
+    template const FieldDescriptor* QuoteSummaryDecoder::fields<DefaultKeyStatistics>(size_t&);
+    template const FieldDescriptor* QuoteSummaryDecoder::fields<QuotePrice>(size_t&);
+
+} // namespace yfinance
@@ -0,0 +1,227 @@
+#include "rate_limiter.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+namespace yfinance {
+
+    namespace {
+        // How long a caller waits before re-checking a full concurrency window
+        constexpr std::chrono::milliseconds kWindowFullWait(2);
+
+        // Minimum spacing between two multiplicative decreases
+        constexpr int64_t kDecreaseCooldownNs = 1000LL * 1000 * 1000;
+    }
+
+    // --- TokenBucket ---
+
+    TokenBucket::TokenBucket(double requests_per_second, double burst)
+        : tat_ns_(0), interval_ns_(0), tolerance_ns_(0) {
+        set_rate(requests_per_second, burst);
+    }
+
+    int64_t TokenBucket::now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void TokenBucket::set_rate(double requests_per_second, double burst) {
+        int64_t interval = requests_per_second > 0.0
+            ? static_cast<int64_t>(1e9 / requests_per_second)
+            : 0;
+        double extra_tokens = std::max(0.0, burst - 1.0);
+
+        interval_ns_ = interval;
+        tolerance_ns_ = static_cast<int64_t>(extra_tokens * static_cast<double>(interval));
+    }
+
+    std::chrono::nanoseconds TokenBucket::try_acquire() {
+        int64_t interval = interval_ns_.load(std::memory_order_relaxed);
+        if (interval <= 0) {
+            return std::chrono::nanoseconds(0);
+        }
+        int64_t tolerance = tolerance_ns_.load(std::memory_order_relaxed);
+
+        int64_t now = now_ns();
+        int64_t tat = tat_ns_.load(std::memory_order_acquire);
+        while (true) {
+            // The request conforms if it is at most `tolerance` ahead of schedule
+            if (tat - now > tolerance) {
+                return std::chrono::nanoseconds(tat - now - tolerance);
+            }
+
+            int64_t next_tat = std::max(tat, now) + interval;
+            if (tat_ns_.compare_exchange_weak(tat, next_tat, std::memory_order_acq_rel)) {
+                return std::chrono::nanoseconds(0);
+            }
+        }
+    }
+
+    // --- AimdController ---
+
+    AimdController::AimdController(size_t initial_window, size_t min_window, size_t max_window)
+        : window_scaled_(0), in_flight_(0), min_window_(std::max<size_t>(1, min_window)),
+          max_window_(std::max(std::max<size_t>(1, min_window), max_window)), last_decrease_ns_(0) {
+        size_t initial = std::min(std::max(initial_window, min_window_.load()), max_window_.load());
+        window_scaled_ = initial * kScale;
+    }
+
+    bool AimdController::try_enter() {
+        size_t limit = window();
+        size_t current = in_flight_.load(std::memory_order_relaxed);
+        while (current < limit) {
+            if (in_flight_.compare_exchange_weak(current, current + 1, std::memory_order_acq_rel)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void AimdController::exit() {
+        in_flight_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    void AimdController::on_success() {
+        uint64_t max_scaled = max_window_.load() * kScale;
+        uint64_t current = window_scaled_.load(std::memory_order_relaxed);
+        while (current < max_scaled) {
+            // +1 request per full window of successes
+            uint64_t next = std::min(max_scaled, current + std::max<uint64_t>(1, kScale * kScale / current));
+            if (window_scaled_.compare_exchange_weak(current, next, std::memory_order_acq_rel)) {
+                return;
+            }
+        }
+    }
+
+    void AimdController::on_throttle() {
+        int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+
+        int64_t last = last_decrease_ns_.load(std::memory_order_relaxed);
+        if (last != 0 && now - last < kDecreaseCooldownNs) {
+            return;
+        }
+        if (!last_decrease_ns_.compare_exchange_strong(last, now, std::memory_order_acq_rel)) {
+            return; // Another thread is already halving the window
+        }
+
+        uint64_t min_scaled = min_window_.load() * kScale;
+        uint64_t current = window_scaled_.load(std::memory_order_relaxed);
+        while (!window_scaled_.compare_exchange_weak(current, std::max(min_scaled, current / 2),
+                                                     std::memory_order_acq_rel)) {
+        }
+    }
+
+    size_t AimdController::window() const {
+        size_t window = static_cast<size_t>(window_scaled_.load(std::memory_order_relaxed) / kScale);
+        return std::max(window, min_window_.load(std::memory_order_relaxed));
+    }
+
+    void AimdController::set_limits(size_t initial_window, size_t min_window, size_t max_window) {
+        min_window_ = std::max<size_t>(1, min_window);
+        max_window_ = std::max(min_window_.load(), max_window);
+
+        size_t initial = std::min(std::max(initial_window, min_window_.load()), max_window_.load());
+        window_scaled_ = initial * kScale;
+    }
+
+    // --- HostLimiter ---
+
+    HostLimiter::HostLimiter(const RateLimits& limits)
+        : bucket_(limits.requests_per_second, limits.burst),
+          concurrency_(limits.initial_concurrency, limits.min_concurrency, limits.max_concurrency) {}
+
+    void HostLimiter::acquire() {
+        while (true) {
+            auto wait = try_acquire();
+            if (wait.count() == 0) {
+                return;
+            }
+            std::this_thread::sleep_for(wait);
+        }
+    }
+
+    std::chrono::nanoseconds HostLimiter::try_acquire() {
+        if (!concurrency_.try_enter()) {
+            return kWindowFullWait;
+        }
+
+        auto wait = bucket_.try_acquire();
+        if (wait.count() > 0) {
+            concurrency_.exit();
+        }
+        return wait;
+    }
+
+    void HostLimiter::release(long status_code) {
+        concurrency_.exit();
+
+        if (status_code == 429 || status_code == 503) {
+            concurrency_.on_throttle();
+        } else if (status_code > 0 && status_code < 400) {
+            concurrency_.on_success();
+        }
+    }
+
+    void HostLimiter::configure(const RateLimits& limits) {
+        bucket_.set_rate(limits.requests_per_second, limits.burst);
+        concurrency_.set_limits(limits.initial_concurrency, limits.min_concurrency, limits.max_concurrency);
+    }
+
+    // --- RateLimiter ---
+
+    RateLimiter& RateLimiter::instance() {
+        static RateLimiter limiter;
+        return limiter;
+    }
+
+    std::shared_ptr<HostLimiter> RateLimiter::for_url(const std::string& url) {
+        std::string host = host_of(url);
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto it = hosts_.find(host);
+            if (it != hosts_.end()) {
+                return it->second;
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto& limiter = hosts_[host];
+        if (!limiter) {
+            limiter = std::make_shared<HostLimiter>(default_limits_);
+        }
+        return limiter;
+    }
+
+    void RateLimiter::set_default_limits(const RateLimits& limits) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        default_limits_ = limits;
+    }
+
+    void RateLimiter::set_host_limits(const std::string& host, const RateLimits& limits) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto& limiter = hosts_[Utils::to_lowercase(host)];
+        if (limiter) {
+            limiter->configure(limits);
+        } else {
+            limiter = std::make_shared<HostLimiter>(limits);
+        }
+    }
+
+    std::string RateLimiter::host_of(const std::string& url) {
+        size_t start = url.find("://");
+        start = start == std::string::npos ? 0 : start + 3;
+
+        size_t end = url.find_first_of("/?#", start);
+        std::string authority = url.substr(start, end == std::string::npos ? std::string::npos : end - start);
+
+        size_t at = authority.rfind('@');
+        if (at != std::string::npos) {
+            authority = authority.substr(at + 1);
+        }
+        return Utils::to_lowercase(authority);
+    }
+
+} // namespace yfinance
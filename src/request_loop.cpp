@@ -0,0 +1,210 @@
+#include "request_loop.h"
+#include "connection_pool.h"
+
+#include <algorithm>
+
+namespace yfinance {
+
+    namespace {
+        // Upper bound on how long the loop sleeps when nothing is scheduled
+        constexpr int kIdlePollMs = 1000;
+    }
+
+    RequestLoop& RequestLoop::instance() {
+        static RequestLoop loop;
+        return loop;
+    }
+
+    RequestLoop::RequestLoop() : multi_(nullptr), running_(true), in_flight_(0), max_in_flight_(256),
+                                 max_concurrent_streams_(100), max_host_connections_(0), options_changed_(true) {
+        // Make sure the pool (and curl_global_init) outlives the loop thread
+        ConnectionPool::instance();
+
+        multi_ = curl_multi_init();
+        if (multi_) {
+            // Let HTTP/2 transfers to the same host share a connection
+            curl_multi_setopt(multi_, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+        }
+        thread_ = std::thread(&RequestLoop::run, this);
+    }
+
+    RequestLoop::~RequestLoop() {
+        running_ = false;
+        if (multi_) {
+            curl_multi_wakeup(multi_);
+        }
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        if (multi_) {
+            curl_multi_cleanup(multi_);
+            multi_ = nullptr;
+        }
+    }
+
+    void RequestLoop::submit(CURL* handle, CompletionCallback on_complete, std::chrono::milliseconds delay,
+                             AdmitCallback admit) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_.push_back({handle, std::move(on_complete), Clock::now() + delay, std::move(admit)});
+        }
+        curl_multi_wakeup(multi_);
+    }
+
+    void RequestLoop::set_max_in_flight(size_t max_in_flight) {
+        max_in_flight_ = std::max<size_t>(1, max_in_flight);
+        curl_multi_wakeup(multi_);
+    }
+
+    void RequestLoop::set_max_concurrent_streams(long streams) {
+        max_concurrent_streams_ = std::max(1L, streams);
+        options_changed_ = true;
+        curl_multi_wakeup(multi_);
+    }
+
+    void RequestLoop::set_max_host_connections(long connections) {
+        max_host_connections_ = std::max(0L, connections);
+        options_changed_ = true;
+        curl_multi_wakeup(multi_);
+    }
+
+    size_t RequestLoop::pending() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return pending_.size();
+    }
+
+    void RequestLoop::run() {
+        if (!multi_) {
+            return;
+        }
+
+        while (running_) {
+            if (options_changed_.exchange(false)) {
+                apply_options();
+            }
+
+            start_ready_transfers();
+
+            int still_running = 0;
+            curl_multi_perform(multi_, &still_running);
+            complete_finished_transfers();
+
+            curl_multi_poll(multi_, nullptr, 0, poll_timeout_ms(), nullptr);
+        }
+
+        // Shutting down: fail everything that has not completed yet
+        for (auto& entry : active_) {
+            curl_multi_remove_handle(multi_, entry.first);
+            try {
+                entry.second(CURLE_ABORTED_BY_CALLBACK);
+            } catch (...) {
+            }
+        }
+        active_.clear();
+
+        std::deque<PendingTransfer> remaining;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            remaining.swap(pending_);
+        }
+        for (auto& transfer : remaining) {
+            try {
+                transfer.on_complete(CURLE_ABORTED_BY_CALLBACK);
+            } catch (...) {
+            }
+        }
+    }
+
+    void RequestLoop::apply_options() {
+        curl_multi_setopt(multi_, CURLMOPT_MAX_CONCURRENT_STREAMS, max_concurrent_streams_.load());
+        curl_multi_setopt(multi_, CURLMOPT_MAX_HOST_CONNECTIONS, max_host_connections_.load());
+    }
+
+    void RequestLoop::start_ready_transfers() {
+        std::deque<PendingTransfer> ready;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto now = Clock::now();
+            size_t slots = max_in_flight_ > in_flight_ ? max_in_flight_ - in_flight_ : 0;
+
+            for (auto it = pending_.begin(); it != pending_.end() && ready.size() < slots;) {
+                if (it->ready_at > now) {
+                    ++it;
+                    continue;
+                }
+
+                if (it->admit) {
+                    auto wait = it->admit();
+                    if (wait.count() > 0) {
+                        it->ready_at = now + std::chrono::duration_cast<Clock::duration>(wait);
+                        ++it;
+                        continue;
+                    }
+                }
+
+                ready.push_back(std::move(*it));
+                it = pending_.erase(it);
+            }
+        }
+
+        for (auto& transfer : ready) {
+            CURLMcode rc = curl_multi_add_handle(multi_, transfer.handle);
+            if (rc != CURLM_OK) {
+                try {
+                    transfer.on_complete(CURLE_FAILED_INIT);
+                } catch (...) {
+                }
+                continue;
+            }
+            active_[transfer.handle] = std::move(transfer.on_complete);
+            ++in_flight_;
+        }
+    }
+
+    void RequestLoop::complete_finished_transfers() {
+        int messages_left = 0;
+        while (CURLMsg* message = curl_multi_info_read(multi_, &messages_left)) {
+            if (message->msg != CURLMSG_DONE) {
+                continue;
+            }
+
+            CURL* handle = message->easy_handle;
+            CURLcode result = message->data.result;
+            curl_multi_remove_handle(multi_, handle);
+
+            auto it = active_.find(handle);
+            if (it == active_.end()) {
+                continue;
+            }
+            CompletionCallback on_complete = std::move(it->second);
+            active_.erase(it);
+            --in_flight_;
+
+            // The callback owns the handle and may resubmit it for a retry
+            try {
+                on_complete(result);
+            } catch (...) {
+            }
+        }
+    }
+
+    int RequestLoop::poll_timeout_ms() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_.empty() || in_flight_ >= max_in_flight_) {
+            return kIdlePollMs;
+        }
+
+        auto now = Clock::now();
+        auto next = pending_.front().ready_at;
+        for (const auto& transfer : pending_) {
+            next = std::min(next, transfer.ready_at);
+        }
+        if (next <= now) {
+            return 0;
+        }
+
+        auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(next - now).count() + 1;
+        return static_cast<int>(std::min<long long>(wait, kIdlePollMs));
+    }
+
+} // namespace yfinance
@@ -0,0 +1,98 @@
+#include "retry_policy.h"
+
+#include <algorithm>
+#include <random>
+
+namespace yfinance {
+
+    bool RetryPolicy::is_retryable(CURLcode result) {
+        switch (result) {
+            case CURLE_COULDNT_RESOLVE_PROXY:
+            case CURLE_COULDNT_RESOLVE_HOST:
+            case CURLE_COULDNT_CONNECT:
+            case CURLE_OPERATION_TIMEDOUT:
+            case CURLE_SSL_CONNECT_ERROR:
+            case CURLE_GOT_NOTHING:
+            case CURLE_SEND_ERROR:
+            case CURLE_RECV_ERROR:
+            case CURLE_PARTIAL_FILE:
+            case CURLE_HTTP2:
+            case CURLE_HTTP2_STREAM:
+            case CURLE_AGAIN:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    bool RetryPolicy::is_retryable_status(long status_code) {
+        switch (status_code) {
+            case 408: // Request Timeout
+            case 425: // Too Early
+            case 429: // Too Many Requests
+            case 500: // Internal Server Error
+            case 502: // Bad Gateway
+            case 503: // Service Unavailable
+            case 504: // Gateway Timeout
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    RetryState::RetryState(const RetryPolicy& policy)
+        : policy_(policy), attempt_(0), previous_delay_(policy.base_delay),
+          deadline_(Clock::now() + policy.deadline), has_deadline_(policy.deadline.count() > 0) {}
+
+    bool RetryState::should_retry(CURLcode result, long status_code,
+                                  std::chrono::milliseconds retry_after, std::chrono::milliseconds& delay) {
+        bool retryable = result != CURLE_OK ? RetryPolicy::is_retryable(result)
+                                            : RetryPolicy::is_retryable_status(status_code);
+        return should_retry(retryable, retry_after, delay);
+    }
+
+    bool RetryState::should_retry(bool retryable, std::chrono::milliseconds retry_after,
+                                  std::chrono::milliseconds& delay) {
+        if (!retryable || attempt_ >= policy_.max_retries) {
+            return false;
+        }
+
+        delay = next_backoff();
+        if (policy_.honor_retry_after && retry_after > delay) {
+            // Waiting an hour on a synchronous call is worse than failing it
+            if (retry_after > policy_.max_retry_after) {
+                return false;
+            }
+            delay = retry_after;
+        }
+
+        // Don't start a retry that could not finish before the deadline
+        if (has_deadline_ && delay >= remaining()) {
+            return false;
+        }
+
+        ++attempt_;
+        return true;
+    }
+
+    std::chrono::milliseconds RetryState::remaining() const {
+        if (!has_deadline_) {
+            return std::chrono::milliseconds::max();
+        }
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline_ - Clock::now());
+        return std::max(left, std::chrono::milliseconds(0));
+    }
+
+    std::chrono::milliseconds RetryState::next_backoff() {
+        thread_local std::mt19937_64 rng(std::random_device{}());
+
+        auto low = policy_.base_delay.count();
+        auto high = std::max(low, previous_delay_.count() * 3);
+        std::uniform_int_distribution<long long> dist(low, high);
+
+        auto delay = std::min(std::chrono::milliseconds(dist(rng)), policy_.max_delay);
+        previous_delay_ = delay;
+        return delay;
+    }
+
+} // namespace yfinance
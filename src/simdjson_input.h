@@ -0,0 +1,32 @@
+#ifndef SIMDJSON_INPUT_H
+#define SIMDJSON_INPUT_H
+
+// Internal helpers shared by the simdjson-backed parsers (USE_SIMDJSON builds only)
+
+#include <cstring>
+#include <vector>
+
+#include <simdjson.h>
+
+namespace yfinance {
+
+    // simdjson reads up to SIMDJSON_PADDING bytes past the end of the input,
+    // so copy it into a reusable per-thread buffer with that much slack
+    inline simdjson::padded_string_view padded_input(const char* data, size_t size) {
+        thread_local std::vector<char> buffer;
+        if (buffer.size() < size + simdjson::SIMDJSON_PADDING) {
+            buffer.resize(size + simdjson::SIMDJSON_PADDING);
+        }
+        std::memcpy(buffer.data(), data, size);
+        return simdjson::padded_string_view(buffer.data(), size, buffer.size());
+    }
+
+    // One on-demand parser per thread; it keeps its internal buffers between documents
+    inline simdjson::ondemand::parser& thread_parser() {
+        thread_local simdjson::ondemand::parser parser;
+        return parser;
+    }
+
+} // namespace yfinance
+
+#endif // SIMDJSON_INPUT_H
@@ -0,0 +1,175 @@
+#include "snapshot_store.h"
+#include "fixture_store.h"
+#include "utils.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace yfinance {
+
+    namespace {
+
+        constexpr char kMagic[4] = {'Y', 'F', 'S', 'N'};
+        constexpr uint8_t kVersion = 1;
+        constexpr size_t kHeaderSize = 16;
+
+        // Header layout: magic[4] version[1] format[1] reserved[2] fetch_time[8, little-endian]
+        void write_header(std::string& out, SnapshotStore::Format format, std::time_t fetch_time) {
+            out.append(kMagic, sizeof(kMagic));
+            out.push_back(static_cast<char>(kVersion));
+            out.push_back(static_cast<char>(format));
+            out.append(2, '\0');
+            uint64_t time = static_cast<uint64_t>(static_cast<int64_t>(fetch_time));
+            for (int i = 0; i < 8; ++i) {
+                out.push_back(static_cast<char>((time >> (8 * i)) & 0xff));
+            }
+        }
+
+        bool write_file(const std::string& path, const std::string& contents) {
+            // Unique temp name so concurrent writers never interleave
+            static std::atomic<uint64_t> counter{0};
+            std::string temp_path = path + ".tmp." + std::to_string(::getpid()) + "." + std::to_string(counter++);
+
+            int fd = ::open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0) {
+                return false;
+            }
+            size_t written = 0;
+            while (written < contents.size()) {
+                ssize_t n = ::write(fd, contents.data() + written, contents.size() - written);
+                if (n <= 0) {
+                    ::close(fd);
+                    std::remove(temp_path.c_str());
+                    return false;
+                }
+                written += static_cast<size_t>(n);
+            }
+            ::close(fd);
+            return std::rename(temp_path.c_str(), path.c_str()) == 0;
+        }
+
+        // One fstat and one read into a buffer of the right size
+        std::optional<std::string> read_file(const std::string& path) {
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) {
+                return std::nullopt;
+            }
+            struct stat info;
+            if (::fstat(fd, &info) != 0) {
+                ::close(fd);
+                return std::nullopt;
+            }
+
+            std::string contents(static_cast<size_t>(info.st_size), '\0');
+            size_t read_bytes = 0;
+            while (read_bytes < contents.size()) {
+                ssize_t n = ::read(fd, &contents[read_bytes], contents.size() - read_bytes);
+                if (n <= 0) {
+                    ::close(fd);
+                    return std::nullopt;
+                }
+                read_bytes += static_cast<size_t>(n);
+            }
+            ::close(fd);
+            return contents;
+        }
+
+    } // namespace
+
+    SnapshotStore::SnapshotStore(const std::string& directory, Format format)
+        : directory_(directory), format_(format) {}
+
+    std::string SnapshotStore::snapshot_name(const std::string& path,
+                                             const std::map<std::string, std::string>& params) {
+        std::string target = path;
+        char separator = '?';
+        for (const auto& param : params) {
+            target += separator;
+            target += Utils::url_encode(param.first) + "=" + Utils::url_encode(param.second);
+            separator = '&';
+        }
+        return FixtureStore::fixture_name("GET", target);
+    }
+
+    std::string SnapshotStore::snapshot_path(const std::string& name) const {
+        return directory_ + "/" + name + ".snap";
+    }
+
+    std::string SnapshotStore::encode(const nlohmann::json& document, Format format, std::time_t fetch_time) {
+        std::string out;
+        write_header(out, format, fetch_time);
+        if (format == Format::MessagePack) {
+            nlohmann::json::to_msgpack(document, out);
+        } else {
+            nlohmann::json::to_cbor(document, out);
+        }
+        return out;
+    }
+
+    SnapshotStore::Snapshot SnapshotStore::decode(const char* data, size_t size) {
+        if (size < kHeaderSize || std::memcmp(data, kMagic, sizeof(kMagic)) != 0) {
+            throw std::runtime_error("Not a snapshot");
+        }
+        if (static_cast<uint8_t>(data[4]) != kVersion) {
+            throw std::runtime_error("Unsupported snapshot version " + std::to_string(static_cast<uint8_t>(data[4])));
+        }
+
+        uint64_t time = 0;
+        for (int i = 0; i < 8; ++i) {
+            time |= static_cast<uint64_t>(static_cast<uint8_t>(data[8 + i])) << (8 * i);
+        }
+
+        Snapshot snapshot;
+        snapshot.fetch_time = static_cast<std::time_t>(static_cast<int64_t>(time));
+
+        const char* payload = data + kHeaderSize;
+        const char* end = data + size;
+        try {
+            switch (static_cast<Format>(data[5])) {
+                case Format::Cbor:
+                    snapshot.document = nlohmann::json::from_cbor(payload, end);
+                    break;
+                case Format::MessagePack:
+                    snapshot.document = nlohmann::json::from_msgpack(payload, end);
+                    break;
+                default:
+                    throw std::runtime_error("Unknown snapshot encoding " + std::to_string(static_cast<uint8_t>(data[5])));
+            }
+        } catch (const nlohmann::json::exception& e) {
+            throw std::runtime_error("Corrupt snapshot: " + std::string(e.what()));
+        }
+        return snapshot;
+    }
+
+    bool SnapshotStore::save(const std::string& name, const nlohmann::json& document, std::time_t fetch_time) const {
+        std::error_code ec;
+        std::filesystem::create_directories(directory_, ec);
+
+        return write_file(snapshot_path(name), encode(document, format_, fetch_time));
+    }
+
+    std::optional<SnapshotStore::Snapshot> SnapshotStore::load(const std::string& name) const {
+        auto contents = read_file(snapshot_path(name));
+        if (!contents) {
+            return std::nullopt;
+        }
+
+        try {
+            return decode(contents->data(), contents->size());
+        } catch (const std::exception&) {
+            return std::nullopt;
+        }
+    }
+
+    void SnapshotStore::remove(const std::string& name) const {
+        std::remove(snapshot_path(name).c_str());
+    }
+
+} // namespace yfinance
@@ -0,0 +1,137 @@
+#include "streaming_parser.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace yfinance {
+
+    // Stream buffer whose get area is the chunk currently being parsed;
+    // underflow() blocks until the transfer delivers the next one
+    class StreamingParser::ChunkBuffer : public std::streambuf {
+    public:
+        void push(const char* data, size_t size) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (closed_ || reader_done_) {
+                return;
+            }
+
+            // Reuse the storage of chunks the reader has finished with
+            std::string chunk;
+            if (!spare_.empty()) {
+                chunk = std::move(spare_.back());
+                spare_.pop_back();
+            }
+            chunk.assign(data, size);
+            chunks_.push_back(std::move(chunk));
+            ready_.notify_one();
+        }
+
+        void close() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+            ready_.notify_one();
+        }
+
+        // Called by the worker once the consumer returned or threw
+        void reader_done() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            reader_done_ = true;
+            chunks_.clear();
+        }
+
+    protected:
+        int_type underflow() override {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (!current_.empty()) {
+                spare_.push_back(std::move(current_));
+                current_.clear();
+            }
+
+            ready_.wait(lock, [this] { return !chunks_.empty() || closed_; });
+            if (chunks_.empty()) {
+                setg(nullptr, nullptr, nullptr);
+                return traits_type::eof();
+            }
+
+            current_ = std::move(chunks_.front());
+            chunks_.pop_front();
+            char* begin = &current_[0];
+            setg(begin, begin, begin + current_.size());
+            return traits_type::to_int_type(*begin);
+        }
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable ready_;
+        std::deque<std::string> chunks_;
+        std::vector<std::string> spare_;
+        std::string current_;   // Chunk backing the get area (reader thread only)
+        bool closed_ = false;
+        bool reader_done_ = false;
+    };
+
+    namespace {
+
+        // Read-only stream buffer over bytes owned by someone else
+        class MemoryBuffer : public std::streambuf {
+        public:
+            MemoryBuffer(const char* data, size_t size) {
+                char* begin = const_cast<char*>(data);
+                setg(begin, begin, begin + size);
+            }
+        };
+
+    } // namespace
+
+    StreamingParser::StreamingParser(Consumer consumer) : buffer_(std::make_unique<ChunkBuffer>()) {
+        worker_ = std::thread([this, consumer = std::move(consumer)]() {
+            std::istream input(buffer_.get());
+            try {
+                consumer(input);
+            } catch (...) {
+                error_ = std::current_exception();
+            }
+            buffer_->reader_done();
+        });
+    }
+
+    StreamingParser::~StreamingParser() {
+        if (worker_.joinable()) {
+            abort();
+        }
+    }
+
+    void StreamingParser::feed(const char* data, size_t size) {
+        buffer_->push(data, size);
+    }
+
+    void StreamingParser::finish() {
+        close_and_join();
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+    }
+
+    void StreamingParser::abort() {
+        close_and_join();
+        error_ = nullptr;
+    }
+
+    void StreamingParser::close_and_join() {
+        buffer_->close();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+    }
+
+    void StreamingParser::consume(const Consumer& consumer, const char* data, size_t size) {
+        MemoryBuffer buffer(data, size);
+        std::istream input(&buffer);
+        consumer(input);
+    }
+
+} // namespace yfinance
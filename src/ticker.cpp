@@ -2,23 +2,59 @@
 #include "yf_data.h"
 #include "utils.h"
 #include "date_utils.h"
+#include "chart_decoder.h"
+#include "option_chain_decoder.h"
+#include "quote_summary_decoder.h"
 
 #include <stdexcept>
 #include <algorithm>
+#include <utility>
+#include <set>
+#include <mutex>
+#include <atomic>
+#include <ctime>
 
 namespace yfinance {
 
-    Ticker::Ticker(const std::string& symbol) : symbol_(symbol) {
+    namespace {
+        using ModuleClock = std::chrono::steady_clock;
+
+        // Fundamentals change at most a few times a day
+        constexpr std::chrono::milliseconds kDefaultModuleTtl = std::chrono::minutes(5);
+
+        const char* const kInfoModules =
+            "assetProfile,summaryProfile,summaryDetail,quoteType,fundProfile,price,defaultKeyStatistics,financialData,calendarEvents";
+    }
+
+    struct Ticker::ModuleCache {
+        struct Entry {
+            nlohmann::json value;
+            bool present = false;  // false: the last response did not include the module
+            ModuleClock::time_point fetched_at;
+        };
+
+        std::mutex mutex;
+        std::map<std::string, Entry> modules;
+        std::set<std::string> pending;  // Queued by prefetch_modules()
+        std::chrono::milliseconds ttl = kDefaultModuleTtl;
+
+        bool fresh(const std::string& module, ModuleClock::time_point now) const {
+            auto it = modules.find(module);
+            return it != modules.end() && now - it->second.fetched_at < ttl;
+        }
+    };
+
+    Ticker::Ticker(const std::string& symbol, std::shared_ptr<YfData> session)
+        : symbol_(symbol), data_provider_(std::move(session)) {
         // Validate the symbol format
         if (!Utils::is_valid_ticker(symbol_)) {
             throw std::invalid_argument("Invalid ticker symbol: " + symbol_);
         }
 
-        // Initialize the data provider
-        data_provider_ = std::make_unique<YfData>();
-
-        // Initialize session to get crumb token early
-        data_provider_->init_session();
+        // Share the session; its handshake runs lazily on the first request
+        if (!data_provider_) {
+            data_provider_ = YfData::shared();
+        }
     }
 
     Ticker::~Ticker() = default;
@@ -35,6 +71,66 @@ namespace yfinance {
         const std::string& /*prepost*/,
         bool /*proxy*/,
         int /*rounding*/
+    ) {
+        auto params = history_params(period_days, interval, auto_adjust);
+
+        std::string path = "/v8/finance/chart/" + symbol_;
+        return data_provider_->get_raw_data(symbol_, path, params);
+    }
+
+    PriceHistory Ticker::history_prices(
+        int period_days,
+        const std::string& interval,
+        bool auto_adjust
+    ) {
+        return fetch_prices(history_params(period_days, interval, auto_adjust));
+    }
+
+    MappedHistory Ticker::sync_history(
+        const HistoryStore& store,
+        int period_days,
+        const std::string& interval,
+        bool auto_adjust
+    ) {
+        auto params = history_params(period_days, interval, auto_adjust);
+        if (auto last = store.last_timestamp(symbol_, interval)) {
+            // Ask from the last stored bar on: it may have been stored
+            // while still forming, and append rewrites it
+            params.erase("period");
+            params["period1"] = std::to_string(*last);
+            params["period2"] = std::to_string(std::time(nullptr));
+        }
+
+        store.append(symbol_, interval, fetch_prices(params));
+        return std::move(*store.open(symbol_, interval));
+    }
+
+    PriceHistory Ticker::fetch_prices(const std::map<std::string, std::string>& params) {
+        std::string path = "/v8/finance/chart/" + symbol_;
+
+        // Decode the chart while it downloads instead of after the last byte
+        PriceHistory history;
+        data_provider_->get_raw_streamed(symbol_, path, params, [&history](std::istream& input) {
+            history = ChartDecoder::decode(input);
+        });
+        return history;
+    }
+
+    std::future<nlohmann::json> Ticker::history_async(
+        int period_days,
+        const std::string& interval,
+        bool auto_adjust
+    ) {
+        auto params = history_params(period_days, interval, auto_adjust);
+
+        std::string path = "/v8/finance/chart/" + symbol_;
+        return data_provider_->get_raw_data_async(symbol_, path, params);
+    }
+
+    std::map<std::string, std::string> Ticker::history_params(
+        int period_days,
+        const std::string& interval,
+        bool auto_adjust
     ) {
         // Validate inputs
         validate_inputs(period_days, interval);
@@ -50,28 +146,11 @@ namespace yfinance {
             params["adj"] = "true";
         }
 
-        std::string path = "/v8/finance/chart/" + symbol_;
-        return data_provider_->get_raw_data(symbol_, path, params);
+        return params;
     }
 
     nlohmann::json Ticker::get_info() {
-        std::string path = "/v10/finance/quoteSummary/" + symbol_;
-        std::map<std::string, std::string> params;
-        params["modules"] = "assetProfile,summaryProfile,summaryDetail,quoteType,fundProfile,price,defaultKeyStatistics,financialData,calendarEvents";
-        
-        auto response = data_provider_->get_raw_data(symbol_, path, params);
-        
-        // Extract the info from the response
-        if (JsonParser::has_field(response, "quoteSummary") &&
-            JsonParser::has_field(JsonParser::extract_field(response, "quoteSummary"), "result")) {
-            
-            auto result = JsonParser::extract_field(JsonParser::extract_field(response, "quoteSummary"), "result");
-            if (!result.empty()) {
-                return result[0]; // Return the first result
-            }
-        }
-        
-        return nlohmann::json(); // Return empty JSON if not found
+        return fetch_modules(Utils::split_string(kInfoModules, ','));
     }
 
     nlohmann::json Ticker::get_recommendations() {
@@ -91,60 +170,15 @@ namespace yfinance {
     }
 
     nlohmann::json Ticker::get_earnings() {
-        std::string path = "/v10/finance/quoteSummary/" + symbol_;
-        std::map<std::string, std::string> params;
-        params["modules"] = "earnings";
-        
-        auto response = data_provider_->get_raw_data(symbol_, path, params);
-        
-        if (JsonParser::has_field(response, "quoteSummary") &&
-            JsonParser::has_field(JsonParser::extract_field(response, "quoteSummary"), "result")) {
-            
-            auto result = JsonParser::extract_field(JsonParser::extract_field(response, "quoteSummary"), "result");
-            if (!result.empty()) {
-                return JsonParser::extract_field(result[0], "earnings");
-            }
-        }
-        
-        return nlohmann::json();
+        return quote_summary_module("earnings", "earnings");
     }
 
     nlohmann::json Ticker::get_earnings_dates() {
-        std::string path = "/v10/finance/quoteSummary/" + symbol_;
-        std::map<std::string, std::string> params;
-        params["modules"] = "calendarEvents";
-        
-        auto response = data_provider_->get_raw_data(symbol_, path, params);
-        
-        if (JsonParser::has_field(response, "quoteSummary") &&
-            JsonParser::has_field(JsonParser::extract_field(response, "quoteSummary"), "result")) {
-            
-            auto result = JsonParser::extract_field(JsonParser::extract_field(response, "quoteSummary"), "result");
-            if (!result.empty()) {
-                return JsonParser::extract_field(result[0], "calendarEvents");
-            }
-        }
-        
-        return nlohmann::json();
+        return quote_summary_module("calendarEvents", "calendarEvents");
     }
 
     nlohmann::json Ticker::get_financials() {
-        std::string path = "/v10/finance/quoteSummary/" + symbol_;
-        std::map<std::string, std::string> params;
-        params["modules"] = "financialData";
-        
-        auto response = data_provider_->get_raw_data(symbol_, path, params);
-        
-        if (JsonParser::has_field(response, "quoteSummary") &&
-            JsonParser::has_field(JsonParser::extract_field(response, "quoteSummary"), "result")) {
-            
-            auto result = JsonParser::extract_field(JsonParser::extract_field(response, "quoteSummary"), "result");
-            if (!result.empty()) {
-                return JsonParser::extract_field(result[0], "financialData");
-            }
-        }
-        
-        return nlohmann::json();
+        return quote_summary_module("financialData", "financialData");
     }
 
     nlohmann::json Ticker::get_quarterly_financials() {
@@ -153,111 +187,33 @@ namespace yfinance {
     }
 
     nlohmann::json Ticker::get_major_holders() {
-        std::string path = "/v10/finance/quoteSummary/" + symbol_;
-        std::map<std::string, std::string> params;
-        params["modules"] = "institutionOwnership,majorDirectHolders,majorHoldersBreakdown";
-        
-        auto response = data_provider_->get_raw_data(symbol_, path, params);
-        
-        if (JsonParser::has_field(response, "quoteSummary") &&
-            JsonParser::has_field(JsonParser::extract_field(response, "quoteSummary"), "result")) {
-            
-            auto result = JsonParser::extract_field(JsonParser::extract_field(response, "quoteSummary"), "result");
-            if (!result.empty()) {
-                return JsonParser::extract_field(result[0], "majorHoldersBreakdown");
-            }
-        }
-        
-        return nlohmann::json();
+        return quote_summary_module("institutionOwnership,majorDirectHolders,majorHoldersBreakdown", "majorHoldersBreakdown");
     }
 
     nlohmann::json Ticker::get_institutional_holders() {
-        std::string path = "/v10/finance/quoteSummary/" + symbol_;
-        std::map<std::string, std::string> params;
-        params["modules"] = "institutionOwnership";
-        
-        auto response = data_provider_->get_raw_data(symbol_, path, params);
-        
-        if (JsonParser::has_field(response, "quoteSummary") &&
-            JsonParser::has_field(JsonParser::extract_field(response, "quoteSummary"), "result")) {
-            
-            auto result = JsonParser::extract_field(JsonParser::extract_field(response, "quoteSummary"), "result");
-            if (!result.empty()) {
-                return JsonParser::extract_field(result[0], "institutionOwnership");
-            }
-        }
-        
-        return nlohmann::json();
+        return quote_summary_module("institutionOwnership", "institutionOwnership");
     }
 
     nlohmann::json Ticker::get_mutualfund_holders() {
         // Similar implementation to institutional holders but with different module
-        std::string path = "/v10/finance/quoteSummary/" + symbol_;
-        std::map<std::string, std::string> params;
-        params["modules"] = "fundOwnership";
-        
-        auto response = data_provider_->get_raw_data(symbol_, path, params);
-        
-        if (JsonParser::has_field(response, "quoteSummary") &&
-            JsonParser::has_field(JsonParser::extract_field(response, "quoteSummary"), "result")) {
-            
-            auto result = JsonParser::extract_field(JsonParser::extract_field(response, "quoteSummary"), "result");
-            if (!result.empty()) {
-                return JsonParser::extract_field(result[0], "fundOwnership");
-            }
-        }
-        
-        return nlohmann::json();
+        return quote_summary_module("fundOwnership", "fundOwnership");
     }
 
     nlohmann::json Ticker::get_dividends() {
-        // Dividends are typically part of the history data with events
-        std::string path = "/v8/finance/chart/" + symbol_;
-        std::map<std::string, std::string> params;
-        params["interval"] = "1d";
-        params["events"] = "div";
-        
-        auto response = data_provider_->get_raw_data(symbol_, path, params);
-        
-        // Extract dividends from the response
-        if (JsonParser::has_field(response, "chart") &&
-            JsonParser::has_field(JsonParser::extract_field(response, "chart"), "result")) {
-            
-            auto result = JsonParser::extract_field(JsonParser::extract_field(response, "chart"), "result");
-            if (!result.empty()) {
-                if (JsonParser::has_field(result[0], "events")) {
-                    return JsonParser::extract_field(result[0], "events");
-                }
-            }
-        }
-        
-        return nlohmann::json();
+        return chart_events("dividends");
     }
 
     nlohmann::json Ticker::get_splits() {
-        std::string path = "/v8/finance/chart/" + symbol_;
-        std::map<std::string, std::string> params;
-        params["interval"] = "1d";
-        params["events"] = "splits";
-        
-        auto response = data_provider_->get_raw_data(symbol_, path, params);
-        
-        // Extract splits from the response
-        if (JsonParser::has_field(response, "chart") &&
-            JsonParser::has_field(JsonParser::extract_field(response, "chart"), "result")) {
-            
-            auto result = JsonParser::extract_field(JsonParser::extract_field(response, "chart"), "result");
-            if (!result.empty()) {
-                if (JsonParser::has_field(result[0], "events")) {
-                    return JsonParser::extract_field(result[0], "events");
-                }
-            }
-        }
-        
-        return nlohmann::json();
+        return chart_events("splits");
     }
 
     nlohmann::json Ticker::get_actions() {
+        return chart_events("");
+    }
+
+    nlohmann::json Ticker::chart_events(const std::string& event_type) {
+        // Dividends, splits and actions all use the same request so that
+        // concurrent calls are coalesced into one round-trip by YfData
         std::string path = "/v8/finance/chart/" + symbol_;
         std::map<std::string, std::string> params;
         params["interval"] = "1d";
@@ -265,192 +221,201 @@ namespace yfinance {
         
         auto response = data_provider_->get_raw_data(symbol_, path, params);
         
-        if (JsonParser::has_field(response, "chart") &&
-            JsonParser::has_field(JsonParser::extract_field(response, "chart"), "result")) {
-            
-            auto result = JsonParser::extract_field(JsonParser::extract_field(response, "chart"), "result");
-            if (!result.empty()) {
-                if (JsonParser::has_field(result[0], "events")) {
-                    return JsonParser::extract_field(result[0], "events");
-                }
+        static const JsonPath events_path("chart.result[0].events");
+        if (nlohmann::json* events = events_path.find(response)) {
+            if (event_type.empty()) {
+                return std::move(*events);
             }
+
+            // Keep the same {"<type>": {...}} shape a single-event request returns
+            nlohmann::json filtered = nlohmann::json::object();
+            if (nlohmann::json* selected = JsonParser::find(*events, event_type)) {
+                filtered[event_type] = std::move(*selected);
+            }
+            return filtered;
         }
         
         return nlohmann::json();
     }
 
-    nlohmann::json Ticker::get_sustainability() {
-        std::string path = "/v10/finance/quoteSummary/" + symbol_;
-        std::map<std::string, std::string> params;
-        params["modules"] = "esgScores";
-        
-        auto response = data_provider_->get_raw_data(symbol_, path, params);
-        
-        if (JsonParser::has_field(response, "quoteSummary") &&
-            JsonParser::has_field(JsonParser::extract_field(response, "quoteSummary"), "result")) {
-            
-            auto result = JsonParser::extract_field(JsonParser::extract_field(response, "quoteSummary"), "result");
-            if (!result.empty()) {
-                return JsonParser::extract_field(result[0], "esgScores");
-            }
+    nlohmann::json* Ticker::quote_summary_result(nlohmann::json& response) {
+        static const JsonPath result_path("quoteSummary.result[0]");
+        return result_path.find(response);
+    }
+
+    nlohmann::json Ticker::quote_summary_module(const std::string& modules, const std::string& module) {
+        auto result = fetch_modules(Utils::split_string(modules, ','));
+        if (result.is_null()) {
+            return result;
         }
-        
-        return nlohmann::json();
+        return std::move(JsonParser::get_field(result, module));
     }
 
-    nlohmann::json Ticker::get_recommendations_summary() {
+    nlohmann::json Ticker::fetch_modules(const std::vector<std::string>& modules) {
+        auto cache = module_cache();
+        nlohmann::json found = nlohmann::json::object();
+
+        // Serve what is cached; ask for the rest plus anything queued by
+        // prefetch_modules(), sorted so equal requests coalesce in YfData
+        std::set<std::string> request;
+        {
+            std::lock_guard<std::mutex> lock(cache->mutex);
+            auto now = ModuleClock::now();
+            for (const auto& module : modules) {
+                if (!cache->fresh(module, now)) {
+                    request.insert(module);
+                } else if (cache->modules[module].present) {
+                    found[module] = cache->modules[module].value;
+                }
+            }
+            if (request.empty()) {
+                return found;
+            }
+            // Queued modules stay queued until a response has answered them,
+            // so a failed request does not lose them
+            for (auto it = cache->pending.begin(); it != cache->pending.end();) {
+                if (cache->fresh(*it, now)) {
+                    it = cache->pending.erase(it);
+                } else {
+                    request.insert(*it++);
+                }
+            }
+        }
+
+        std::string joined;
+        for (const auto& module : request) {
+            joined += (joined.empty() ? "" : ",") + module;
+        }
+
         std::string path = "/v10/finance/quoteSummary/" + symbol_;
         std::map<std::string, std::string> params;
-        params["modules"] = "recommendationTrend";
-        
+        params["modules"] = joined;
+
         auto response = data_provider_->get_raw_data(symbol_, path, params);
-        
-        if (JsonParser::has_field(response, "quoteSummary") &&
-            JsonParser::has_field(JsonParser::extract_field(response, "quoteSummary"), "result")) {
-            
-            auto result = JsonParser::extract_field(JsonParser::extract_field(response, "quoteSummary"), "result");
-            if (!result.empty()) {
-                return JsonParser::extract_field(result[0], "recommendationTrend");
+        nlohmann::json* result = quote_summary_result(response);
+        if (!result) {
+            return nlohmann::json();
+        }
+
+        std::lock_guard<std::mutex> lock(cache->mutex);
+        auto now = ModuleClock::now();
+        for (const auto& module : request) {
+            cache->pending.erase(module);
+            nlohmann::json* value = JsonParser::find(*result, module);
+            bool wanted = std::find(modules.begin(), modules.end(), module) != modules.end();
+
+            // Modules nobody asked for yet are moved into the cache; requested
+            // ones are copied there and moved to the caller
+            if (cache->ttl.count() > 0) {
+                auto& entry = cache->modules[module];
+                entry.present = value != nullptr;
+                entry.value = !value ? nlohmann::json() : wanted ? *value : std::move(*value);
+                entry.fetched_at = now;
+            }
+            if (wanted && value) {
+                found[module] = std::move(*value);
             }
         }
-        
-        return nlohmann::json();
+        return found;
+    }
+
+    std::shared_ptr<Ticker::ModuleCache> Ticker::module_cache() {
+        auto cache = std::atomic_load(&module_cache_);
+        if (!cache) {
+            auto created = std::make_shared<ModuleCache>();
+            cache = std::atomic_compare_exchange_strong(&module_cache_, &cache, created) ? created : cache;
+        }
+        return cache;
+    }
+
+    const std::vector<std::string>& Ticker::fundamentals_modules() {
+        static const std::vector<std::string> modules = {
+            "assetProfile", "summaryProfile", "summaryDetail", "quoteType", "fundProfile", "price",
+            "defaultKeyStatistics", "financialData", "calendarEvents", "earnings",
+            "institutionOwnership", "majorDirectHolders", "majorHoldersBreakdown", "fundOwnership",
+            "esgScores", "recommendationTrend",
+            "balanceSheetHistory", "balanceSheetHistoryQuarterly",
+            "incomeStatementHistory", "incomeStatementHistoryQuarterly",
+            "cashFlowStatementHistory", "cashFlowStatementHistoryQuarterly"
+        };
+        return modules;
+    }
+
+    void Ticker::prefetch_modules(const std::vector<std::string>& modules) {
+        auto cache = module_cache();
+        std::lock_guard<std::mutex> lock(cache->mutex);
+        cache->pending.insert(modules.begin(), modules.end());
+    }
+
+    nlohmann::json Ticker::get_modules(const std::vector<std::string>& modules) {
+        return fetch_modules(modules);
+    }
+
+    void Ticker::set_module_ttl(std::chrono::milliseconds ttl) {
+        auto cache = module_cache();
+        std::lock_guard<std::mutex> lock(cache->mutex);
+        cache->ttl = ttl;
+        if (ttl.count() <= 0) {
+            cache->modules.clear();
+        }
+    }
+
+    void Ticker::clear_module_cache() {
+        auto cache = module_cache();
+        std::lock_guard<std::mutex> lock(cache->mutex);
+        cache->modules.clear();
+    }
+
+    QuoteSummary Ticker::get_quote_summary() {
+        auto modules = fetch_modules({
+            QuoteSummaryDecoder::module_name<FinancialData>(),
+            QuoteSummaryDecoder::module_name<SummaryDetail>(),
+            QuoteSummaryDecoder::module_name<DefaultKeyStatistics>(),
+            QuoteSummaryDecoder::module_name<QuotePrice>()
+        });
+        return QuoteSummaryDecoder::decode_result(modules);
+    }
+
+    nlohmann::json Ticker::get_sustainability() {
+        return quote_summary_module("esgScores", "esgScores");
+    }
+
+    nlohmann::json Ticker::get_recommendations_summary() {
+        return quote_summary_module("recommendationTrend", "recommendationTrend");
     }
 
     nlohmann::json Ticker::get_company_officers() {
-        std::string path = "/v10/finance/quoteSummary/" + symbol_;
-        std::map<std::string, std::string> params;
-        params["modules"] = "assetProfile";
-        
-        auto response = data_provider_->get_raw_data(symbol_, path, params);
+        auto asset_profile = quote_summary_module("assetProfile", "assetProfile");
         
-        if (JsonParser::has_field(response, "quoteSummary") &&
-            JsonParser::has_field(JsonParser::extract_field(response, "quoteSummary"), "result")) {
-            
-            auto result = JsonParser::extract_field(JsonParser::extract_field(response, "quoteSummary"), "result");
-            if (!result.empty()) {
-                auto asset_profile = JsonParser::extract_field(result[0], "assetProfile");
-                if (JsonParser::has_field(asset_profile, "companyOfficers")) {
-                    return JsonParser::extract_field(asset_profile, "companyOfficers");
-                }
-            }
+        if (nlohmann::json* officers = JsonParser::find(asset_profile, "companyOfficers")) {
+            return std::move(*officers);
         }
         
         return nlohmann::json();
     }
 
     nlohmann::json Ticker::get_balance_sheet() {
-        std::string path = "/v10/finance/quoteSummary/" + symbol_;
-        std::map<std::string, std::string> params;
-        params["modules"] = "balanceSheetHistory";
-        
-        auto response = data_provider_->get_raw_data(symbol_, path, params);
-        
-        if (JsonParser::has_field(response, "quoteSummary") &&
-            JsonParser::has_field(JsonParser::extract_field(response, "quoteSummary"), "result")) {
-            
-            auto result = JsonParser::extract_field(JsonParser::extract_field(response, "quoteSummary"), "result");
-            if (!result.empty()) {
-                return JsonParser::extract_field(result[0], "balanceSheetHistory");
-            }
-        }
-        
-        return nlohmann::json();
+        return quote_summary_module("balanceSheetHistory", "balanceSheetHistory");
     }
 
     nlohmann::json Ticker::get_quarterly_balance_sheet() {
-        std::string path = "/v10/finance/quoteSummary/" + symbol_;
-        std::map<std::string, std::string> params;
-        params["modules"] = "balanceSheetHistoryQuarterly";
-        
-        auto response = data_provider_->get_raw_data(symbol_, path, params);
-        
-        if (JsonParser::has_field(response, "quoteSummary") &&
-            JsonParser::has_field(JsonParser::extract_field(response, "quoteSummary"), "result")) {
-            
-            auto result = JsonParser::extract_field(JsonParser::extract_field(response, "quoteSummary"), "result");
-            if (!result.empty()) {
-                return JsonParser::extract_field(result[0], "balanceSheetHistoryQuarterly");
-            }
-        }
-        
-        return nlohmann::json();
+        return quote_summary_module("balanceSheetHistoryQuarterly", "balanceSheetHistoryQuarterly");
     }
 
     nlohmann::json Ticker::get_income_stmt() {
-        std::string path = "/v10/finance/quoteSummary/" + symbol_;
-        std::map<std::string, std::string> params;
-        params["modules"] = "incomeStatementHistory";
-        
-        auto response = data_provider_->get_raw_data(symbol_, path, params);
-        
-        if (JsonParser::has_field(response, "quoteSummary") &&
-            JsonParser::has_field(JsonParser::extract_field(response, "quoteSummary"), "result")) {
-            
-            auto result = JsonParser::extract_field(JsonParser::extract_field(response, "quoteSummary"), "result");
-            if (!result.empty()) {
-                return JsonParser::extract_field(result[0], "incomeStatementHistory");
-            }
-        }
-        
-        return nlohmann::json();
+        return quote_summary_module("incomeStatementHistory", "incomeStatementHistory");
     }
 
     nlohmann::json Ticker::get_quarterly_income_stmt() {
-        std::string path = "/v10/finance/quoteSummary/" + symbol_;
-        std::map<std::string, std::string> params;
-        params["modules"] = "incomeStatementHistoryQuarterly";
-        
-        auto response = data_provider_->get_raw_data(symbol_, path, params);
-        
-        if (JsonParser::has_field(response, "quoteSummary") &&
-            JsonParser::has_field(JsonParser::extract_field(response, "quoteSummary"), "result")) {
-            
-            auto result = JsonParser::extract_field(JsonParser::extract_field(response, "quoteSummary"), "result");
-            if (!result.empty()) {
-                return JsonParser::extract_field(result[0], "incomeStatementHistoryQuarterly");
-            }
-        }
-        
-        return nlohmann::json();
+        return quote_summary_module("incomeStatementHistoryQuarterly", "incomeStatementHistoryQuarterly");
     }
 
     nlohmann::json Ticker::get_cashflow() {
-        std::string path = "/v10/finance/quoteSummary/" + symbol_;
-        std::map<std::string, std::string> params;
-        params["modules"] = "cashFlowStatementHistory";
-        
-        auto response = data_provider_->get_raw_data(symbol_, path, params);
-        
-        if (JsonParser::has_field(response, "quoteSummary") &&
-            JsonParser::has_field(JsonParser::extract_field(response, "quoteSummary"), "result")) {
-            
-            auto result = JsonParser::extract_field(JsonParser::extract_field(response, "quoteSummary"), "result");
-            if (!result.empty()) {
-                return JsonParser::extract_field(result[0], "cashFlowStatementHistory");
-            }
-        }
-        
-        return nlohmann::json();
+        return quote_summary_module("cashFlowStatementHistory", "cashFlowStatementHistory");
     }
 
     nlohmann::json Ticker::get_quarterly_cashflow() {
-        std::string path = "/v10/finance/quoteSummary/" + symbol_;
-        std::map<std::string, std::string> params;
-        params["modules"] = "cashFlowStatementHistoryQuarterly";
-        
-        auto response = data_provider_->get_raw_data(symbol_, path, params);
-        
-        if (JsonParser::has_field(response, "quoteSummary") &&
-            JsonParser::has_field(JsonParser::extract_field(response, "quoteSummary"), "result")) {
-            
-            auto result = JsonParser::extract_field(JsonParser::extract_field(response, "quoteSummary"), "result");
-            if (!result.empty()) {
-                return JsonParser::extract_field(result[0], "cashFlowStatementHistoryQuarterly");
-            }
-        }
-        
-        return nlohmann::json();
+        return quote_summary_module("cashFlowStatementHistoryQuarterly", "cashFlowStatementHistoryQuarterly");
     }
 
     nlohmann::json Ticker::get_options() {
@@ -468,27 +433,40 @@ namespace yfinance {
     }
 
     std::vector<std::string> Ticker::get_option_dates() {
-        auto options_data = get_options();
-        
+        auto expirations = get_option_expirations();
+
         std::vector<std::string> dates;
-        
-        if (JsonParser::has_field(options_data, "optionChain") &&
-            JsonParser::has_field(JsonParser::extract_field(options_data, "optionChain"), "result")) {
-            
-            auto result = JsonParser::extract_field(JsonParser::extract_field(options_data, "optionChain"), "result");
-            if (!result.empty() && 
-                JsonParser::has_field(result[0], "expirationDates")) {
-                
-                auto expiration_dates = JsonParser::extract_field(result[0], "expirationDates");
-                for (const auto& date_val : expiration_dates) {
-                    dates.push_back(date_val.dump());  // Convert to string representation
-                }
-            }
+        dates.reserve(expirations.size());
+        for (int64_t expiration : expirations) {
+            dates.push_back(std::to_string(expiration));
         }
-        
+
         return dates;
     }
 
+    std::vector<int64_t> Ticker::get_option_expirations() {
+        return fetch_option_chain({}).expiration_dates;
+    }
+
+    OptionChain Ticker::get_option_chain() {
+        return fetch_option_chain({});
+    }
+
+    OptionChain Ticker::get_option_chain(int64_t expiration) {
+        return fetch_option_chain({{"date", std::to_string(expiration)}});
+    }
+
+    OptionChain Ticker::fetch_option_chain(const std::map<std::string, std::string>& params) {
+        std::string path = "/v7/finance/options/" + symbol_;
+        ResponseBuffer response = data_provider_->get_raw_buffer(symbol_, path, params);
+
+        try {
+            return OptionChainDecoder::decode(response.data(), response.size());
+        } catch (const std::exception& e) {
+            throw std::runtime_error("Failed to decode options for symbol " + symbol_ + ": " + e.what());
+        }
+    }
+
     nlohmann::json Ticker::get_news() {
         std::string path = "/v1/finance/search";
         std::map<std::string, std::string> params;
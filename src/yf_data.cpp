@@ -2,55 +2,135 @@
 #include "utils.h"
 #include "http_client.h"
 #include "json_parser.h"
+#include "date_utils.h"
 
 #include <sstream>
 #include <thread>
 #include <regex>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <ctime>
+#include <vector>
 
 namespace yfinance {
 
-    YfData::YfData() : base_url_("https://query1.finance.yahoo.com"), proxy_(""), retries_(3) {
+    namespace {
+        // Cache key for cookies obtained through the fc.yahoo.com/getcrumb handshake
+        const char* const kCookieStrategy = "basic";
+
+        const char* const kDefaultBaseUrl = "https://query1.finance.yahoo.com";
+        const char* const kDefaultCookieUrl = "https://fc.yahoo.com";
+
+        uint64_t fnv1a(const std::string& text) {
+            uint64_t hash = 14695981039346656037ULL;
+            for (unsigned char c : text) {
+                hash ^= c;
+                hash *= 1099511628211ULL;
+            }
+            return hash;
+        }
+
+        // HTTP status carried by an async error, 0 if it is not an HTTP error
+        long http_status(std::exception_ptr error) {
+            try {
+                std::rethrow_exception(error);
+            } catch (const HttpClientException& e) {
+                return e.status_code();
+            } catch (...) {
+                return 0;
+            }
+        }
+    }
+
+    // Identical requests in flight, keyed by request_key()
+    struct YfData::InFlightTable {
+        std::mutex mutex;
+        std::map<std::string, std::vector<InFlightCallback>> requests;
+        std::atomic<uint64_t> sent{0};
+        std::atomic<uint64_t> coalesced{0};
+    };
+
+    YfData::YfData() : base_url_(kDefaultBaseUrl),
+                       cookie_url_(kDefaultCookieUrl), proxy_(""), retries_(3), session_attempted_(false),
+                       cookie_cache_(std::make_shared<CookieCache>()), cookie_cache_max_age_(24 * 60 * 60),
+                       snapshot_max_age_(0),
+                       in_flight_(std::make_shared<InFlightTable>()), coalescing_enabled_(true) {
         http_client_ = std::make_unique<HttpClient>();
         http_client_->set_retries(retries_);
     }
 
     YfData::~YfData() = default;
 
+    std::shared_ptr<YfData> YfData::shared() {
+        static std::shared_ptr<YfData> session = std::make_shared<YfData>();
+        return session;
+    }
+
     bool YfData::init_session() {
+        std::lock_guard<std::mutex> lock(handshake_mutex_);
+        session_attempted_ = true;
+
         // First, try to get the crumb token
-        return get_crumb_token();
+        if (!get_crumb_token()) {
+            return false;
+        }
+
+        store_cached_session();
+        return true;
+    }
+
+    bool YfData::ensure_session() {
+        if (session_attempted_) {
+            std::lock_guard<std::mutex> lock(session_mutex_);
+            return !crumb_token_.empty();
+        }
+
+        std::lock_guard<std::mutex> lock(handshake_mutex_);
+        if (!session_attempted_) {
+            // Only hit the network when no valid cookie/crumb is cached
+            if (!load_cached_session() && get_crumb_token()) {
+                store_cached_session();
+            }
+            session_attempted_ = true;
+        }
+
+        std::lock_guard<std::mutex> session_lock(session_mutex_);
+        return !crumb_token_.empty();
     }
 
     bool YfData::get_crumb_token() {
         try {
             // Step 1: Get initial cookie by visiting fc.yahoo.com (following Python yfinance approach)
-            std::string cookie_url = "https://fc.yahoo.com";
+            std::string cookie_url = cookie_url_;
             auto headers = Utils::get_default_headers();
+            std::string cookie_data;
 
             try {
                 http_client_->get(cookie_url, headers);
-                // Store cookies from this request for future use
-                cookie_data_ = http_client_->get_cookies();
             } catch (const HttpClientException& e) {
                 // If cookie request fails, we still continue as the crumb request might work
             }
+            // Store cookies from this request for future use
+            cookie_data = http_client_->get_cookies();
 
             // Step 2: Get the crumb token from the dedicated endpoint
-            std::string crumb_url = "https://query1.finance.yahoo.com/v1/test/getcrumb";
+            std::string crumb_url = base_url_ + "/v1/test/getcrumb";
 
             // Include stored cookies in the request for the crumb
             auto crumb_headers = Utils::get_default_headers();
-            if (!cookie_data_.empty()) {
-                crumb_headers["Cookie"] = cookie_data_;
+            if (!cookie_data.empty()) {
+                crumb_headers["Cookie"] = cookie_data;
             }
 
+            std::string crumb_token;
             try {
                 // Get the crumb as plain text (not JSON)
                 std::string raw_response = http_client_->get_text(crumb_url, crumb_headers);
 
                 // The response should be the crumb token as plain text
                 if (!raw_response.empty() && raw_response.find("<html>") == std::string::npos) {
-                    crumb_token_ = raw_response;
+                    crumb_token = raw_response;
                 } else {
                     // If we got HTML instead of a token, the session wasn't established properly
                     return false;
@@ -60,81 +140,465 @@ namespace yfinance {
                 return false;
             }
 
+            std::lock_guard<std::mutex> lock(session_mutex_);
+            cookie_data_ = cookie_data;
+            crumb_token_ = crumb_token;
             return !crumb_token_.empty();
         } catch (const std::exception& e) {
             return false;
         }
     }
 
-    nlohmann::json YfData::get_raw_data(
-        const std::string& symbol,
-        const std::string& path,
-        const std::map<std::string, std::string>& params
-    ) {
-        std::string url = base_url_ + path;
+    std::string YfData::cookie_cache_key() const {
+        if (base_url_ == kDefaultBaseUrl && cookie_url_ == kDefaultCookieUrl) {
+            return kCookieStrategy;
+        }
+        // A session pointed at another host (e.g. tools/replay_server) must
+        // neither reuse nor overwrite the cached Yahoo crumb
+        char hash[17];
+        std::snprintf(hash, sizeof(hash), "%016llx",
+                      static_cast<unsigned long long>(fnv1a(cookie_url_ + " " + base_url_)));
+        return std::string(kCookieStrategy) + "-" + hash;
+    }
 
-        // Add symbol to parameters if not already present
+    bool YfData::load_cached_session() {
+        if (!cookie_cache_) {
+            return false;
+        }
+
+        auto entry = cookie_cache_->lookup(cookie_cache_key());
+        if (!entry) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(session_mutex_);
+        cookie_data_ = entry->cookie;
+        crumb_token_ = entry->crumb;
+        return true;
+    }
+
+    void YfData::store_cached_session() {
+        if (!cookie_cache_) {
+            return;
+        }
+
+        CookieCache::Entry entry;
+        {
+            std::lock_guard<std::mutex> lock(session_mutex_);
+            entry.cookie = cookie_data_;
+            entry.crumb = crumb_token_;
+        }
+        entry.fetch_time = DateUtils::now();
+        entry.expires = entry.fetch_time + cookie_cache_max_age_;
+
+        std::time_t cookie_expiry = http_client_->get_cookie_expiry();
+        if (cookie_expiry > 0 && cookie_expiry < entry.expires) {
+            entry.expires = cookie_expiry;
+        }
+
+        cookie_cache_->store(cookie_cache_key(), entry);
+    }
+
+    bool YfData::refresh_session(const std::string& rejected_crumb) {
+        std::lock_guard<std::mutex> lock(handshake_mutex_);
+        {
+            std::lock_guard<std::mutex> session_lock(session_mutex_);
+            if (crumb_token_ != rejected_crumb) {
+                // Another thread already replaced the rejected crumb
+                return !crumb_token_.empty();
+            }
+            crumb_token_.clear();
+            cookie_data_.clear();
+        }
+
+        if (cookie_cache_) {
+            cookie_cache_->remove(cookie_cache_key());
+        }
+
+        session_attempted_ = true;
+        if (!get_crumb_token()) {
+            return false;
+        }
+
+        store_cached_session();
+        return true;
+    }
+
+    ResponseBuffer YfData::fetch_buffer(const std::string& symbol,
+                                        const std::string& url,
+                                        const std::map<std::string, std::string>& params) {
+        auto all_params = params;
+        std::map<std::string, std::string> headers;
+        prepare_request(symbol, all_params, headers);
+
+        try {
+            return http_client_->get_buffer(url, headers, all_params);
+        } catch (const HttpClientException& e) {
+            // Yahoo answers 401 when the (possibly cached) crumb is no longer valid
+            auto crumb = all_params.find("crumb");
+            std::string used_crumb = crumb != all_params.end() ? crumb->second : "";
+            if (e.status_code() != 401 || !refresh_session(used_crumb)) {
+                throw;
+            }
+        }
+
+        all_params = params;
+        prepare_request(symbol, all_params, headers);
+        return http_client_->get_buffer(url, headers, all_params);
+    }
+
+    void YfData::fetch_streamed(const std::string& symbol,
+                                const std::string& url,
+                                const std::map<std::string, std::string>& params,
+                                const HttpClient::StreamConsumer& consumer) {
+        auto all_params = params;
+        std::map<std::string, std::string> headers;
+        prepare_request(symbol, all_params, headers);
+
+        try {
+            http_client_->get_streamed(url, headers, all_params, consumer);
+            return;
+        } catch (const HttpClientException& e) {
+            auto crumb = all_params.find("crumb");
+            std::string used_crumb = crumb != all_params.end() ? crumb->second : "";
+            if (e.status_code() != 401 || !refresh_session(used_crumb)) {
+                throw;
+            }
+        }
+
+        all_params = params;
+        prepare_request(symbol, all_params, headers);
+        http_client_->get_streamed(url, headers, all_params, consumer);
+    }
+
+    nlohmann::json YfData::fetch_json(const std::string& symbol,
+                                      const std::string& url,
+                                      const std::map<std::string, std::string>& params) {
+        ResponseBuffer response = fetch_buffer(symbol, url, params);
+
+        if (response.empty()) {
+            throw HttpClientException("Empty response from server for URL: " + url);
+        }
+
+        try {
+            return JsonParser::parse(response.data(), response.size());
+        } catch (const std::exception& e) {
+            throw HttpClientException("Failed to parse JSON response from " + url + ": " + std::string(e.what()));
+        }
+    }
+
+    nlohmann::json YfData::fetch_coalesced(const std::string& symbol,
+                                           const std::string& url,
+                                           const std::map<std::string, std::string>& params,
+                                           const std::function<void(const nlohmann::json&)>& on_fetched) {
+        std::string key = request_key(symbol, url, params);
+
+        auto promise = std::make_shared<std::promise<nlohmann::json>>();
+        auto future = promise->get_future();
+        bool joined = join_in_flight(key, [promise](const nlohmann::json& result, std::exception_ptr error) {
+            if (error) {
+                promise->set_exception(error);
+            } else {
+                promise->set_value(result);
+            }
+        });
+        if (joined) {
+            return future.get();
+        }
+
+        try {
+            auto result = fetch_json(symbol, url, params);
+            if (on_fetched) {
+                on_fetched(result);
+            }
+            complete_in_flight(*in_flight_, key, result, nullptr);
+            return result;
+        } catch (...) {
+            complete_in_flight(*in_flight_, key, nlohmann::json(), std::current_exception());
+            throw;
+        }
+    }
+
+    std::string YfData::request_key(const std::string& symbol,
+                                    const std::string& url,
+                                    const std::map<std::string, std::string>& params) {
+        // Scheme and host are case-insensitive, the path is not
+        std::string key = url;
+        size_t host_start = key.find("://");
+        host_start = host_start == std::string::npos ? 0 : host_start + 3;
+        size_t host_end = key.find('/', host_start);
+        if (host_end == std::string::npos) {
+            host_end = key.size();
+        }
+        std::transform(key.begin(), key.begin() + host_end, key.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+        // std::map keeps the params sorted, so equal requests give equal keys
         auto all_params = params;
         if (all_params.find("symbol") == all_params.end()) {
             all_params["symbol"] = symbol;
         }
 
+        char separator = '?';
+        for (const auto& param : all_params) {
+            key += separator;
+            key += Utils::url_encode(param.first) + "=" + Utils::url_encode(param.second);
+            separator = '&';
+        }
+        return key;
+    }
+
+    bool YfData::join_in_flight(const std::string& key, InFlightCallback callback) {
+        if (coalescing_enabled_) {
+            std::lock_guard<std::mutex> lock(in_flight_->mutex);
+            auto it = in_flight_->requests.find(key);
+            if (it != in_flight_->requests.end()) {
+                it->second.push_back(std::move(callback));
+                ++in_flight_->coalesced;
+                return true;
+            }
+            in_flight_->requests.emplace(key, std::vector<InFlightCallback>());
+        }
+
+        ++in_flight_->sent;
+        return false;
+    }
+
+    void YfData::complete_in_flight(InFlightTable& table, const std::string& key,
+                                    const nlohmann::json& result, std::exception_ptr error) {
+        std::vector<InFlightCallback> waiters;
+        {
+            std::lock_guard<std::mutex> lock(table.mutex);
+            auto it = table.requests.find(key);
+            if (it == table.requests.end()) {
+                return;
+            }
+            waiters = std::move(it->second);
+            table.requests.erase(it);
+        }
+
+        for (auto& waiter : waiters) {
+            waiter(result, error);
+        }
+    }
+
+    void YfData::prepare_request(const std::string& symbol,
+                                 std::map<std::string, std::string>& params,
+                                 std::map<std::string, std::string>& headers) const {
+        std::lock_guard<std::mutex> lock(session_mutex_);
+
+        // Add symbol to parameters if not already present
+        if (params.find("symbol") == params.end()) {
+            params["symbol"] = symbol;
+        }
+
         // Add crumb token to parameters if we have one
         if (!crumb_token_.empty()) {
-            all_params["crumb"] = crumb_token_;
+            params["crumb"] = crumb_token_;
         }
 
         // Set default headers
-        auto headers = Utils::get_default_headers();
+        headers = Utils::get_default_headers();
 
         // Add cookie header if we have cookie data
         if (!cookie_data_.empty()) {
             headers["Cookie"] = cookie_data_;
         }
+    }
+
+    nlohmann::json YfData::get_raw_data(
+        const std::string& symbol,
+        const std::string& path,
+        const std::map<std::string, std::string>& params
+    ) {
+        std::shared_ptr<SnapshotStore> snapshots;
+        int snapshot_max_age = 0;
+        {
+            std::lock_guard<std::mutex> lock(session_mutex_);
+            snapshots = snapshot_store_;
+            snapshot_max_age = snapshot_max_age_;
+        }
+
+        std::string snapshot;
+        if (snapshots) {
+            snapshot = snapshot_name(symbol, path, params);
+            if (snapshot_max_age > 0) {
+                auto saved = snapshots->load(snapshot);
+                if (saved && std::time(nullptr) - saved->fetch_time < snapshot_max_age) {
+                    return std::move(saved->document);
+                }
+            }
+        }
 
+        ensure_session();
+
+        std::string url = base_url_ + path;
+
+        nlohmann::json result;
         try {
-            return http_client_->get(url, headers, all_params);
+            // Only the caller that sent the request saves the snapshot, not
+            // every caller that joined it
+            std::function<void(const nlohmann::json&)> save_snapshot;
+            if (snapshots) {
+                save_snapshot = [&snapshots, &snapshot](const nlohmann::json& fetched) {
+                    snapshots->save(snapshot, fetched);
+                };
+            }
+            result = fetch_coalesced(symbol, url, params, save_snapshot);
         } catch (const std::exception& e) {
             throw std::runtime_error("Failed to fetch data for symbol " + symbol + ": " + e.what());
         }
+        return result;
     }
 
-    nlohmann::json YfData::get_raw_data_with_session(
+    ResponseBuffer YfData::get_raw_buffer(
         const std::string& symbol,
         const std::string& path,
-        const std::map<std::string, std::string>& params,
-        int timeout
+        const std::map<std::string, std::string>& params
     ) {
-        // Initialize session if not already done
-        if (crumb_token_.empty()) {
-            init_session();
+        ensure_session();
+
+        std::string url = base_url_ + path;
+
+        try {
+            return fetch_buffer(symbol, url, params);
+        } catch (const std::exception& e) {
+            throw std::runtime_error("Failed to fetch data for symbol " + symbol + ": " + e.what());
         }
+    }
+
+    void YfData::get_raw_streamed(
+        const std::string& symbol,
+        const std::string& path,
+        const std::map<std::string, std::string>& params,
+        HttpClient::StreamConsumer consumer
+    ) {
+        ensure_session();
 
         std::string url = base_url_ + path;
 
-        // Add symbol to parameters if not already present
-        auto all_params = params;
-        if (all_params.find("symbol") == all_params.end()) {
-            all_params["symbol"] = symbol;
+        try {
+            fetch_streamed(symbol, url, params, consumer);
+        } catch (const std::exception& e) {
+            throw std::runtime_error("Failed to fetch data for symbol " + symbol + ": " + e.what());
         }
+    }
 
-        // Add crumb token to parameters if we have one
-        if (!crumb_token_.empty()) {
-            all_params["crumb"] = crumb_token_;
+    std::future<nlohmann::json> YfData::get_raw_data_async(
+        const std::string& symbol,
+        const std::string& path,
+        const std::map<std::string, std::string>& params
+    ) {
+        // The handshake itself is blocking but runs at most once per session
+        ensure_session();
+
+        std::string url = base_url_ + path;
+
+        auto promise = std::make_shared<std::promise<nlohmann::json>>();
+        auto future = promise->get_future();
+
+        auto wrap_error = [symbol](const std::exception& e) {
+            return std::make_exception_ptr(
+                std::runtime_error("Failed to fetch data for symbol " + symbol + ": " + e.what()));
+        };
+
+        std::string key = request_key(symbol, url, params);
+        bool joined = join_in_flight(key, [promise, wrap_error](const nlohmann::json& result, std::exception_ptr error) {
+            if (!error) {
+                promise->set_value(result);
+                return;
+            }
+            try {
+                std::rethrow_exception(error);
+            } catch (const std::exception& e) {
+                promise->set_exception(wrap_error(e));
+            }
+        });
+        if (joined) {
+            return future;
         }
 
-        // Set headers and timeout
-        auto headers = Utils::get_default_headers();
+        auto table = in_flight_;
+        fetch_buffer_async(symbol, url, params,
+            [table, promise, url, key, wrap_error](ResponseBuffer response, std::exception_ptr error) {
+                try {
+                    if (error) {
+                        std::rethrow_exception(error);
+                    }
+                    if (response.empty()) {
+                        throw HttpClientException("Empty response from server for URL: " + url);
+                    }
 
-        // Add cookie header if we have cookie data
-        if (!cookie_data_.empty()) {
-            headers["Cookie"] = cookie_data_;
+                    nlohmann::json parsed;
+                    try {
+                        parsed = JsonParser::parse(response.data(), response.size());
+                    } catch (const std::exception& e) {
+                        throw HttpClientException("Failed to parse JSON response from " + url + ": " + std::string(e.what()));
+                    }
+                    complete_in_flight(*table, key, parsed, nullptr);
+                    promise->set_value(std::move(parsed));
+                } catch (const std::exception& e) {
+                    complete_in_flight(*table, key, nlohmann::json(), std::current_exception());
+                    promise->set_exception(wrap_error(e));
+                }
+            }, true);
+
+        return future;
+    }
+
+    void YfData::fetch_buffer_async(const std::string& symbol,
+                                    const std::string& url,
+                                    const std::map<std::string, std::string>& params,
+                                    HttpClient::BufferCallback callback,
+                                    bool refresh_on_401) {
+        auto all_params = params;
+        std::map<std::string, std::string> headers;
+        prepare_request(symbol, all_params, headers);
+
+        auto crumb = all_params.find("crumb");
+        std::string used_crumb = crumb != all_params.end() ? crumb->second : "";
+        std::weak_ptr<YfData> weak_self = refresh_on_401 ? weak_from_this() : std::weak_ptr<YfData>();
+
+        http_client_->get_buffer_async(url, headers, all_params,
+            [weak_self, symbol, url, params, used_crumb, callback](ResponseBuffer response, std::exception_ptr error) {
+                auto self = weak_self.lock();
+                if (!error || !self || http_status(error) != 401) {
+                    callback(std::move(response), error);
+                    return;
+                }
+
+                // The handshake is blocking, so keep it off the request loop
+                std::thread([self, symbol, url, params, used_crumb, callback, error]() {
+                    try {
+                        if (!self->refresh_session(used_crumb)) {
+                            callback(ResponseBuffer(), error);
+                            return;
+                        }
+                        self->fetch_buffer_async(symbol, url, params, callback, false);
+                    } catch (const std::exception&) {
+                        callback(ResponseBuffer(), std::current_exception());
+                    }
+                }).detach();
+            });
+    }
+
+    nlohmann::json YfData::get_raw_data_with_session(
+        const std::string& symbol,
+        const std::string& path,
+        const std::map<std::string, std::string>& params,
+        int timeout
+    ) {
+        // Initialize session if not already done
+        if (!ensure_session()) {
+            init_session();
         }
 
+        std::string url = base_url_ + path;
+
         http_client_->set_timeout(timeout);
 
         try {
-            return http_client_->get(url, headers, all_params);
+            return fetch_coalesced(symbol, url, params);
         } catch (const std::exception& e) {
             throw std::runtime_error("Failed to fetch data with session for symbol " + symbol + ": " + e.what());
         }
@@ -145,6 +609,17 @@ namespace yfinance {
         // For now, this is a no-op
     }
 
+    void YfData::set_base_url(const std::string& base_url) {
+        base_url_ = base_url;
+        while (!base_url_.empty() && base_url_.back() == '/') {
+            base_url_.pop_back();
+        }
+    }
+
+    void YfData::set_cookie_url(const std::string& cookie_url) {
+        cookie_url_ = cookie_url;
+    }
+
     void YfData::set_proxy(const std::string& proxy) {
         proxy_ = proxy;
         http_client_->set_proxy(proxy);
@@ -155,4 +630,67 @@ namespace yfinance {
         http_client_->set_retries(retries);
     }
 
+    void YfData::set_cookie_cache(std::shared_ptr<CookieCache> cache) {
+        std::lock_guard<std::mutex> lock(handshake_mutex_);
+        cookie_cache_ = std::move(cache);
+    }
+
+    void YfData::set_cookie_cache_max_age(int seconds) {
+        std::lock_guard<std::mutex> lock(handshake_mutex_);
+        cookie_cache_max_age_ = seconds;
+    }
+
+    void YfData::set_snapshot_store(std::shared_ptr<SnapshotStore> store, int max_age_seconds) {
+        std::lock_guard<std::mutex> lock(session_mutex_);
+        snapshot_store_ = std::move(store);
+        snapshot_max_age_ = max_age_seconds;
+    }
+
+    std::optional<nlohmann::json> YfData::load_snapshot(
+        const std::string& symbol,
+        const std::string& path,
+        const std::map<std::string, std::string>& params
+    ) const {
+        std::shared_ptr<SnapshotStore> snapshots;
+        {
+            std::lock_guard<std::mutex> lock(session_mutex_);
+            snapshots = snapshot_store_;
+        }
+        if (!snapshots) {
+            return std::nullopt;
+        }
+        auto saved = snapshots->load(snapshot_name(symbol, path, params));
+        if (!saved) {
+            return std::nullopt;
+        }
+        return std::move(saved->document);
+    }
+
+    std::string YfData::snapshot_name(const std::string& symbol,
+                                      const std::string& path,
+                                      const std::map<std::string, std::string>& params) {
+        if (params.count("symbol")) {
+            return SnapshotStore::snapshot_name(path, params);
+        }
+        auto all_params = params;
+        all_params["symbol"] = symbol;
+        return SnapshotStore::snapshot_name(path, all_params);
+    }
+
+    void YfData::set_coalescing(bool enabled) {
+        coalescing_enabled_ = enabled;
+    }
+
+    YfData::CoalescingStats YfData::coalescing_stats() const {
+        CoalescingStats stats;
+        stats.requests = in_flight_->sent.load();
+        stats.coalesced = in_flight_->coalesced.load();
+        return stats;
+    }
+
+    void YfData::reset_coalescing_stats() {
+        in_flight_->sent = 0;
+        in_flight_->coalesced = 0;
+    }
+
 } // namespace yfinance
\ No newline at end of file
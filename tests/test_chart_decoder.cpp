@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "chart_decoder.h"
+#include "test_fixtures.h"
+
+using yfinance::ChartDecoder;
+using yfinance::PriceHistory;
+
+// The same expectations hold for the SAX decoder and, when the library is
+// built with USE_SIMDJSON, for the simdjson one
+
+namespace {
+
+    const char* const kAapl = "/v8/finance/chart/AAPL?events=div%2Csplits&interval=1d&period=5d";
+    const char* const kIndex = "/v8/finance/chart/%5EGSPC?events=div%2Csplits&interval=1d&period=5d";
+    const char* const kNoBars = "/v8/finance/chart/NEWCO?events=div%2Csplits&interval=1d&period=5d";
+    const char* const kUnknown = "/v8/finance/chart/NOSUCH?events=div%2Csplits&interval=1d&period=5d";
+
+    // A column read from the JSON DOM: null becomes NaN, and an absent
+    // column is all NaN (or empty for adjclose), as the decoder promises
+    std::vector<double> dom_column(const nlohmann::json* list, const char* name, size_t rows, bool pad) {
+        std::vector<double> column;
+        if (list && list->is_array() && !list->empty() && (*list)[0].contains(name)) {
+            for (const auto& value : (*list)[0][name]) {
+                column.push_back(value.is_null() ? NAN : value.get<double>());
+            }
+        } else if (pad) {
+            column.assign(rows, NAN);
+        }
+        return column;
+    }
+
+    void expect_same_column(const std::vector<double>& expected, const std::vector<double>& actual,
+                            const char* name) {
+        ASSERT_EQ(expected.size(), actual.size()) << name;
+        for (size_t i = 0; i < expected.size(); ++i) {
+            if (std::isnan(expected[i])) {
+                EXPECT_TRUE(std::isnan(actual[i])) << name << "[" << i << "]";
+            } else {
+                EXPECT_EQ(expected[i], actual[i]) << name << "[" << i << "]";
+            }
+        }
+    }
+
+    void expect_matches_dom(const std::string& body, const PriceHistory& history) {
+        const nlohmann::json result = nlohmann::json::parse(body)["chart"]["result"][0];
+        std::vector<int64_t> timestamps;
+        if (result.contains("timestamp")) {
+            timestamps = result["timestamp"].get<std::vector<int64_t>>();
+        }
+        EXPECT_EQ(timestamps, history.timestamp);
+
+        const auto& indicators = result["indicators"];
+        const nlohmann::json* quote = indicators.contains("quote") ? &indicators["quote"] : nullptr;
+        const nlohmann::json* adjclose = indicators.contains("adjclose") ? &indicators["adjclose"] : nullptr;
+        size_t rows = timestamps.size();
+        expect_same_column(dom_column(quote, "open", rows, true), history.open, "open");
+        expect_same_column(dom_column(quote, "high", rows, true), history.high, "high");
+        expect_same_column(dom_column(quote, "low", rows, true), history.low, "low");
+        expect_same_column(dom_column(quote, "close", rows, true), history.close, "close");
+        expect_same_column(dom_column(quote, "volume", rows, true), history.volume, "volume");
+        expect_same_column(dom_column(adjclose, "adjclose", rows, false), history.adjclose, "adjclose");
+
+        EXPECT_EQ(result["meta"].value("symbol", ""), history.meta.symbol);
+        EXPECT_EQ(result["meta"].value("gmtoffset", int64_t{0}), history.meta.gmtoffset);
+    }
+
+} // namespace
+
+TEST(ChartDecoderTest, DecodesColumnsMetaAndEvents) {
+    PriceHistory history = ChartDecoder::decode(fixture_body(kAapl));
+
+    ASSERT_EQ(5u, history.size());
+    EXPECT_EQ(1700490600, history.timestamp.front());
+    EXPECT_EQ(191.44999694824219, history.close[0]);
+    EXPECT_EQ(24048300.0, history.volume[4]);
+    EXPECT_EQ(190.5, history.adjclose[0]);
+
+    EXPECT_EQ("AAPL", history.meta.symbol);
+    EXPECT_EQ("USD", history.meta.currency);
+    EXPECT_EQ("NMS", history.meta.exchange_name);
+    EXPECT_EQ("America/New_York", history.meta.exchange_timezone_name);
+    EXPECT_EQ(-18000, history.meta.gmtoffset);
+    EXPECT_EQ(345479400, history.meta.first_trade_date);
+    EXPECT_EQ(189.97, history.meta.regular_market_price);
+    EXPECT_EQ(2, history.meta.price_hint);
+    EXPECT_EQ("5d", history.meta.range);
+
+    ASSERT_EQ(1u, history.dividends.size());
+    EXPECT_EQ(1700577000, history.dividends[0].date);
+    EXPECT_EQ(0.24, history.dividends[0].amount);
+    ASSERT_EQ(1u, history.splits.size());
+    EXPECT_EQ(4.0, history.splits[0].numerator);
+    EXPECT_EQ(1.0, history.splits[0].denominator);
+    EXPECT_EQ("4:1", history.splits[0].ratio);
+}
+
+TEST(ChartDecoderTest, NullBarStaysAlignedAsNaN) {
+    PriceHistory history = ChartDecoder::decode(fixture_body(kAapl));
+
+    ASSERT_EQ(5u, history.size());
+    for (const auto* column : {&history.open, &history.high, &history.low, &history.close,
+                               &history.adjclose, &history.volume}) {
+        ASSERT_EQ(5u, column->size());
+        EXPECT_TRUE(std::isnan((*column)[3]));
+        EXPECT_FALSE(std::isnan((*column)[4]));
+    }
+}
+
+TEST(ChartDecoderTest, PadsMissingColumns) {
+    PriceHistory history = ChartDecoder::decode(fixture_body(kIndex));
+
+    ASSERT_EQ(3u, history.size());
+    ASSERT_EQ(3u, history.volume.size());
+    for (double volume : history.volume) {
+        EXPECT_TRUE(std::isnan(volume));
+    }
+    EXPECT_TRUE(history.adjclose.empty());
+    EXPECT_EQ("^GSPC", history.meta.symbol);
+    // A null meta field keeps its default
+    EXPECT_EQ(0, history.meta.first_trade_date);
+}
+
+TEST(ChartDecoderTest, ResultWithoutBarsIsEmpty) {
+    PriceHistory history = ChartDecoder::decode(fixture_body(kNoBars));
+
+    EXPECT_EQ(0u, history.size());
+    EXPECT_TRUE(history.close.empty());
+    EXPECT_TRUE(history.adjclose.empty());
+    EXPECT_EQ("NEWCO", history.meta.symbol);
+}
+
+TEST(ChartDecoderTest, ThrowsWhenYahooReportsAnError) {
+    try {
+        ChartDecoder::decode(fixture_body(kUnknown));
+        FAIL() << "expected an error";
+    } catch (const std::runtime_error& e) {
+        EXPECT_NE(std::string::npos, std::string(e.what()).find("No data found"));
+    }
+}
+
+TEST(ChartDecoderTest, MatchesADomReadingOfEachFixture) {
+    for (const char* target : {kAapl, kIndex, kNoBars}) {
+        SCOPED_TRACE(target);
+        std::string body = fixture_body(target);
+        expect_matches_dom(body, ChartDecoder::decode(body));
+
+        std::istringstream stream(body);
+        expect_matches_dom(body, ChartDecoder::decode(stream));
+    }
+}
+
+TEST(ChartDecoderTest, SkipsNullContainers) {
+    const std::string bars =
+        R"("timestamp":[1,2],"indicators":{"quote":[{"open":[1.5,null],"close":[2,3]}],"adjclose":[{"adjclose":[1,2]}]})";
+
+    PriceHistory history = ChartDecoder::decode(R"({"chart":{"result":[{"meta":null,)" + bars + "}],\"error\":null}}");
+    EXPECT_EQ(2u, history.size());
+    EXPECT_EQ("", history.meta.symbol);
+    EXPECT_TRUE(std::isnan(history.open[1]));
+
+    history = ChartDecoder::decode(R"({"chart":{"result":[{"events":null,)" + bars + "}],\"error\":null}}");
+    EXPECT_EQ(2u, history.size());
+    EXPECT_TRUE(history.dividends.empty());
+
+    history = ChartDecoder::decode(
+        R"({"chart":{"result":[{"events":{"dividends":null,"splits":{"1":null,"2":{"date":2,"numerator":4,"denominator":1,"splitRatio":"4:1"}}},)" +
+        bars + "}],\"error\":null}}");
+    EXPECT_TRUE(history.dividends.empty());
+    ASSERT_EQ(1u, history.splits.size());
+    EXPECT_EQ("4:1", history.splits[0].ratio);
+
+    history = ChartDecoder::decode(R"({"chart":{"result":[{"timestamp":[1],"indicators":null}],"error":null}})");
+    ASSERT_EQ(1u, history.size());
+    EXPECT_TRUE(std::isnan(history.close[0]));
+    EXPECT_TRUE(history.adjclose.empty());
+
+    history = ChartDecoder::decode(
+        R"({"chart":{"result":[{"timestamp":null,"indicators":{"quote":null,"adjclose":[null]}}],"error":null}})");
+    EXPECT_EQ(0u, history.size());
+
+    history = ChartDecoder::decode(R"({"chart":{"result":[{"timestamp":[1],"indicators":{"quote":[null]}}],"error":null}})");
+    ASSERT_EQ(1u, history.size());
+    EXPECT_TRUE(std::isnan(history.open[0]));
+}
+
+TEST(ChartDecoderTest, ThrowsWithoutAResult) {
+    EXPECT_THROW(ChartDecoder::decode(R"({"chart":{"result":[null],"error":null}})"), std::runtime_error);
+    EXPECT_THROW(ChartDecoder::decode(R"({"chart":null})"), std::runtime_error);
+    EXPECT_THROW(ChartDecoder::decode(R"({"chart":{"result":[],"error":null}})"), std::runtime_error);
+}
+
+TEST(ChartDecoderTest, ThrowsOnMalformedJson) {
+    std::string body = fixture_body(kAapl);
+    EXPECT_THROW(ChartDecoder::decode(body.substr(0, body.size() / 2)), std::runtime_error);
+    EXPECT_THROW(ChartDecoder::decode(std::string("not json")), std::runtime_error);
+}
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "chart_decoder.h"
+#include "dataframe.h"
+#include "test_fixtures.h"
+
+using yfinance::ColumnType;
+using yfinance::DataFrame;
+using yfinance::PriceHistory;
+using yfinance::ValidityBitmap;
+
+namespace {
+
+    DataFrame typed_frame() {
+        DataFrame frame;
+        frame.add_column("price", ColumnType::Double);
+        frame.add_column("volume", ColumnType::Int64);
+        frame.add_column("time", ColumnType::Timestamp);
+        frame.add_column("call", ColumnType::Bool);
+        frame.add_column("symbol", ColumnType::String);
+        return frame;
+    }
+
+} // namespace
+
+TEST(ValidityBitmapTest, TracksNullsAcrossBytes) {
+    ValidityBitmap bitmap;
+    for (size_t i = 0; i < 20; ++i) {
+        bitmap.push_back(i % 3 != 0);
+    }
+    EXPECT_EQ(20u, bitmap.size());
+    EXPECT_EQ(7u, bitmap.null_count());
+    EXPECT_FALSE(bitmap.test(9));
+    EXPECT_TRUE(bitmap.test(10));
+
+    bitmap.set(9, true);
+    bitmap.set(9, true);
+    bitmap.set(10, false);
+    EXPECT_TRUE(bitmap.test(9));
+    EXPECT_FALSE(bitmap.test(10));
+    EXPECT_EQ(7u, bitmap.null_count());
+
+    bitmap.resize(30, false);
+    EXPECT_EQ(17u, bitmap.null_count());
+    EXPECT_FALSE(bitmap.test(29));
+    bitmap.resize(8, true);
+    EXPECT_EQ(3u, bitmap.null_count());
+    // Least significant bit first: rows 0, 3 and 6 are null
+    EXPECT_EQ(0xB6, bitmap.data()[0]);
+}
+
+TEST(DataFrameTest, AddRowStoresValuesAndNulls) {
+    DataFrame frame = typed_frame();
+    frame.add_row(1.5, int64_t{200}, int64_t{1700000000}, true, "AAPL");
+    frame.add_row(std::nullopt, std::nullopt, int64_t{1700086400}, false, std::nullopt);
+    frame.add_row(2, 300, 1700172800, std::nullopt, std::string("AAPL"));
+
+    ASSERT_EQ(3u, frame.rows());
+    auto row = frame.get_row(0);
+    EXPECT_EQ(1.5, row.get<double>("price"));
+    EXPECT_EQ(200, row.get<int64_t>("volume"));
+    EXPECT_TRUE(row.get<bool>("call"));
+    EXPECT_EQ("AAPL", row.get<std::string_view>("symbol"));
+
+    row = frame.get_row(1);
+    EXPECT_TRUE(row.is_null("price"));
+    EXPECT_TRUE(std::isnan(row.get<double>("price")));
+    EXPECT_TRUE(row.is_null("volume"));
+    EXPECT_EQ(0, row.get<int64_t>("volume"));
+    EXPECT_FALSE(row.is_null("call"));
+    EXPECT_EQ("", row.get<std::string_view>("symbol"));
+
+    EXPECT_EQ(2.0, frame.get_row(2).get<double>("price"));
+    EXPECT_TRUE(frame.get_row(2).is_null("call"));
+    // Equal strings share one dictionary entry
+    EXPECT_EQ(1u, frame.column("symbol").dictionary().size());
+    EXPECT_EQ(1u, frame.column("price").null_count());
+}
+
+TEST(DataFrameTest, RejectedRowLeavesEveryColumnUnchanged) {
+    DataFrame frame = typed_frame();
+    frame.add_row(1.5, int64_t{200}, int64_t{1700000000}, true, "AAPL");
+
+    // The last value does not fit its column; nothing may be appended
+    EXPECT_THROW(frame.add_row(2.5, int64_t{300}, int64_t{1700086400}, false, 4.0), std::invalid_argument);
+    EXPECT_THROW(frame.add_row("x", int64_t{300}, int64_t{1700086400}, false, "MSFT"), std::invalid_argument);
+    EXPECT_THROW(frame.add_row(1.5, 2.5, int64_t{1700086400}, false, "MSFT"), std::invalid_argument);
+    EXPECT_THROW(frame.add_row(1.5, int64_t{300}), std::invalid_argument);
+
+    for (size_t column = 0; column < frame.cols(); ++column) {
+        EXPECT_EQ(1u, frame.column(column).size()) << frame.get_column_names()[column];
+    }
+    frame.add_row(2.5, int64_t{300}, int64_t{1700086400}, false, "MSFT");
+    EXPECT_EQ(2u, frame.rows());
+}
+
+TEST(DataFrameTest, AddColumnAndBulkAppendUseNulls) {
+    DataFrame frame;
+    auto& close = frame.add_column("close", ColumnType::Double);
+    std::vector<double> values = {1.0, NAN, 3.0};
+    close.append_doubles(values);
+
+    auto& flag = frame.add_column("flag", ColumnType::Bool);
+    EXPECT_EQ(3u, flag.size());
+    EXPECT_EQ(3u, flag.null_count());
+    EXPECT_EQ(1u, close.null_count());
+    EXPECT_TRUE(close.is_null(1));
+    EXPECT_THROW(frame.add_column("close", ColumnType::Int64), std::invalid_argument);
+    EXPECT_THROW(close.int64s(), std::invalid_argument);
+}
+
+TEST(DataFrameTest, FromHistoryMarksMissingBarsNull) {
+    PriceHistory history = yfinance::ChartDecoder::decode(
+        fixture_body("/v8/finance/chart/AAPL?events=div%2Csplits&interval=1d&period=5d"));
+    DataFrame frame = DataFrame::from_history(history);
+
+    EXPECT_EQ((std::vector<std::string>{"Date", "Open", "High", "Low", "Close", "Adj Close", "Volume"}),
+              frame.get_column_names());
+    ASSERT_EQ(5u, frame.rows());
+    EXPECT_EQ(ColumnType::Timestamp, frame.column("Date").type());
+    EXPECT_EQ(ColumnType::Int64, frame.column("Volume").type());
+    for (size_t column = 1; column < frame.cols(); ++column) {
+        EXPECT_EQ(1u, frame.column(column).null_count());
+        EXPECT_TRUE(frame.column(column).is_null(3));
+    }
+    EXPECT_EQ(24048300, frame.get_row(4).get<int64_t>("Volume"));
+}
+
+TEST(DataFrameTest, FromHistoryWithoutAdjcloseOrVolume) {
+    PriceHistory history = yfinance::ChartDecoder::decode(
+        fixture_body("/v8/finance/chart/%5EGSPC?events=div%2Csplits&interval=1d&period=5d"));
+    DataFrame frame = DataFrame::from_history(history);
+
+    EXPECT_EQ(nullptr, frame.get_column("Adj Close"));
+    ASSERT_EQ(3u, frame.rows());
+    EXPECT_EQ(3u, frame.column("Volume").null_count());
+    EXPECT_EQ(0u, frame.column("Close").null_count());
+}
@@ -0,0 +1,19 @@
+#ifndef TEST_FIXTURES_H
+#define TEST_FIXTURES_H
+
+#include <stdexcept>
+#include <string>
+
+#include "fixture_store.h"
+
+// Body of a response recorded in tests/fixtures (see FixtureStore); target
+// is the request path and query, e.g. "/v7/finance/options/AAPL"
+inline std::string fixture_body(const std::string& target) {
+    auto fixture = yfinance::FixtureStore(YFINANCE_TEST_FIXTURES).load("GET", target);
+    if (!fixture) {
+        throw std::runtime_error("No test fixture for " + target);
+    }
+    return fixture->body;
+}
+
+#endif // TEST_FIXTURES_H
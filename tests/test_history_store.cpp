@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+#include "history_store.h"
+
+using yfinance::HistoryStore;
+using yfinance::PriceHistory;
+
+namespace {
+
+    class HistoryStoreTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            directory_ = std::filesystem::temp_directory_path() /
+                         ("yfinance-test-history-" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) +
+                          "-" + ::testing::UnitTest::GetInstance()->current_test_info()->name());
+            std::filesystem::remove_all(directory_);
+        }
+
+        void TearDown() override {
+            std::filesystem::remove_all(directory_);
+        }
+
+        std::string column_file(const std::string& column) const {
+            return (directory_ / "AAPL" / "1d" / (column + ".col")).string();
+        }
+
+        std::filesystem::path directory_;
+    };
+
+    // One bar a day starting at first, with close = base + day
+    PriceHistory daily_bars(int64_t first, size_t count, double base) {
+        PriceHistory history;
+        history.meta.symbol = "AAPL";
+        for (size_t i = 0; i < count; ++i) {
+            double price = base + static_cast<double>(i);
+            history.timestamp.push_back(first + static_cast<int64_t>(i) * 86400);
+            history.open.push_back(price - 0.5);
+            history.high.push_back(price + 1.0);
+            history.low.push_back(price - 1.0);
+            history.close.push_back(price);
+            history.adjclose.push_back(price * 0.9);
+            history.volume.push_back(1000.0 + static_cast<double>(i));
+        }
+        return history;
+    }
+
+    constexpr int64_t kDay0 = 1700000000;
+
+} // namespace
+
+TEST_F(HistoryStoreTest, RoundTripsAppendedBars) {
+    HistoryStore store(directory_.string());
+    EXPECT_FALSE(store.open("AAPL", "1d").has_value());
+    EXPECT_FALSE(store.last_timestamp("AAPL", "1d").has_value());
+
+    PriceHistory history = daily_bars(kDay0, 5, 100.0);
+    history.dividends.push_back({kDay0 + 86400, 0.25});
+    EXPECT_EQ(5u, store.append("AAPL", "1d", history));
+
+    auto mapped = store.open("AAPL", "1d");
+    ASSERT_TRUE(mapped.has_value());
+    ASSERT_EQ(5u, mapped->size());
+    EXPECT_EQ("AAPL", mapped->meta().symbol);
+    ASSERT_EQ(1u, mapped->dividends().size());
+    EXPECT_DOUBLE_EQ(0.25, mapped->dividends()[0].amount);
+    for (size_t i = 0; i < 5; ++i) {
+        EXPECT_EQ(history.timestamp[i], mapped->timestamp()[i]);
+        EXPECT_EQ(history.open[i], mapped->open()[i]);
+        EXPECT_EQ(history.close[i], mapped->close()[i]);
+        EXPECT_EQ(history.adjclose[i], mapped->adjclose()[i]);
+        EXPECT_EQ(history.volume[i], mapped->volume()[i]);
+    }
+    EXPECT_EQ(kDay0 + 4 * 86400, *store.last_timestamp("AAPL", "1d"));
+
+    // Bars before the last stored one are skipped; the last one is rewritten
+    EXPECT_EQ(2u, store.append("AAPL", "1d", daily_bars(kDay0 + 3 * 86400, 4, 200.0)));
+    mapped = store.open("AAPL", "1d");
+    ASSERT_EQ(7u, mapped->size());
+    EXPECT_EQ(103.0, mapped->close()[3]);
+    EXPECT_EQ(201.0, mapped->close()[4]);
+    EXPECT_EQ(203.0, mapped->close()[6]);
+}
+
+TEST_F(HistoryStoreTest, RewritesTheLastBarWhenItIsAppendedAgain) {
+    HistoryStore store(directory_.string());
+    store.append("AAPL", "1d", daily_bars(kDay0, 3, 100.0));
+
+    // The same still-forming bar, fetched twice with different values
+    PriceHistory forming = daily_bars(kDay0 + 3 * 86400, 1, 110.0);
+    EXPECT_EQ(1u, store.append("AAPL", "1d", forming));
+    forming.close[0] = 111.5;
+    forming.high[0] = 112.0;
+    forming.volume[0] = 5000.0;
+    EXPECT_EQ(0u, store.append("AAPL", "1d", forming));
+
+    auto mapped = store.open("AAPL", "1d");
+    ASSERT_EQ(4u, mapped->size());
+    EXPECT_EQ(111.5, mapped->close()[3]);
+    EXPECT_EQ(112.0, mapped->high()[3]);
+    EXPECT_EQ(5000.0, mapped->volume()[3]);
+    EXPECT_EQ(102.0, mapped->close()[2]);
+
+    // A later fetch completes the bar and adds the next one
+    PriceHistory closed = daily_bars(kDay0 + 3 * 86400, 2, 120.0);
+    EXPECT_EQ(1u, store.append("AAPL", "1d", closed));
+    mapped = store.open("AAPL", "1d");
+    ASSERT_EQ(5u, mapped->size());
+    EXPECT_EQ(120.0, mapped->close()[3]);
+    EXPECT_EQ(121.0, mapped->close()[4]);
+    EXPECT_EQ(kDay0 + 4 * 86400, mapped->timestamp()[4]);
+}
+
+TEST_F(HistoryStoreTest, CopiesWaitForAnAppendInProgress) {
+    HistoryStore store(directory_.string());
+    store.append("AAPL", "1d", daily_bars(kDay0, 3, 100.0));
+    auto mapped = store.open("AAPL", "1d");
+
+    // The live mapping sees the last bar rewritten in place
+    store.append("AAPL", "1d", daily_bars(kDay0 + 2 * 86400, 1, 150.0));
+    ASSERT_EQ(3u, mapped->size());
+    EXPECT_EQ(150.0, mapped->close()[2]);
+
+    // Hold the lock an append takes; a copy must wait for it
+    int fd = ::open(column_file("timestamp").c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(0, ::flock(fd, LOCK_EX));
+    std::atomic<bool> copied{false};
+    std::thread reader([&] {
+        EXPECT_EQ(3u, mapped->to_price_history().size());
+        copied = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_FALSE(copied.load());
+    ::flock(fd, LOCK_UN);
+    reader.join();
+    EXPECT_TRUE(copied.load());
+    ::close(fd);
+
+    // Moving the mapping keeps its lock descriptor
+    auto moved = std::move(*mapped);
+    EXPECT_EQ(150.0, moved.between(kDay0 + 2 * 86400, kDay0 + 3 * 86400).close.at(0));
+}
+
+TEST_F(HistoryStoreTest, StoresAMissingAdjcloseAsNaN) {
+    HistoryStore store(directory_.string());
+    PriceHistory history = daily_bars(kDay0, 3, 100.0);
+    history.adjclose.clear();
+    store.append("AAPL", "1d", history);
+
+    auto mapped = store.open("AAPL", "1d");
+    ASSERT_EQ(3u, mapped->size());
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_TRUE(std::isnan(mapped->adjclose()[i]));
+    }
+    EXPECT_EQ(102.0, mapped->close()[2]);
+}
+
+TEST_F(HistoryStoreTest, IgnoresAndTrimsATornAppend) {
+    HistoryStore store(directory_.string());
+    store.append("AAPL", "1d", daily_bars(kDay0, 4, 100.0));
+
+    // An append that died after writing one and a half bars to two columns
+    {
+        std::ofstream timestamps(column_file("timestamp"), std::ios::binary | std::ios::app);
+        int64_t t = kDay0 + 4 * 86400;
+        timestamps.write(reinterpret_cast<const char*>(&t), sizeof(t));
+        std::ofstream close(column_file("close"), std::ios::binary | std::ios::app);
+        close.write("torn", 4);
+    }
+    auto mapped = store.open("AAPL", "1d");
+    ASSERT_EQ(4u, mapped->size());
+    EXPECT_EQ(kDay0 + 3 * 86400, *store.last_timestamp("AAPL", "1d"));
+
+    // The next append cuts every column back to the agreed rows before writing
+    EXPECT_EQ(2u, store.append("AAPL", "1d", daily_bars(kDay0 + 3 * 86400, 3, 200.0)));
+    for (const char* column : {"timestamp", "open", "high", "low", "close", "adjclose", "volume"}) {
+        EXPECT_EQ(64u + 6u * 8u, std::filesystem::file_size(column_file(column))) << column;
+    }
+    mapped = store.open("AAPL", "1d");
+    ASSERT_EQ(6u, mapped->size());
+    EXPECT_EQ(200.0, mapped->close()[3]);
+    EXPECT_EQ(201.0, mapped->close()[4]);
+    EXPECT_EQ(kDay0 + 5 * 86400, mapped->timestamp()[5]);
+}
+
+TEST_F(HistoryStoreTest, RejectsACorruptColumn) {
+    HistoryStore store(directory_.string());
+    store.append("AAPL", "1d", daily_bars(kDay0, 2, 100.0));
+    {
+        std::fstream close(column_file("close"), std::ios::binary | std::ios::in | std::ios::out);
+        close.write("XXXX", 4);
+    }
+    EXPECT_THROW(store.open("AAPL", "1d"), std::runtime_error);
+    EXPECT_THROW(store.append("AAPL", "1d", daily_bars(kDay0, 3, 100.0)), std::runtime_error);
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <string>
+
+#include "option_chain_decoder.h"
+#include "test_fixtures.h"
+
+using yfinance::OptionChain;
+using yfinance::OptionChainDecoder;
+
+TEST(OptionChainDecoderTest, DecodesCallsThenPuts) {
+    OptionChain chain = OptionChainDecoder::decode(fixture_body("/v7/finance/options/AAPL"));
+
+    EXPECT_EQ("AAPL", chain.underlying_symbol);
+    EXPECT_EQ(189.97, chain.underlying_price);
+    EXPECT_EQ((std::vector<int64_t>{1701388800, 1701993600}), chain.expiration_dates);
+    EXPECT_EQ((std::vector<double>{185.0, 190.0}), chain.strikes);
+
+    ASSERT_EQ(3u, chain.size());
+    EXPECT_EQ(2u, chain.call_count());
+    EXPECT_EQ("AAPL231201C00185000", chain.contract_symbol[0]);
+    EXPECT_EQ("AAPL231201P00185000", chain.contract_symbol[2]);
+    EXPECT_EQ((std::vector<uint8_t>{1, 1, 0}), chain.is_call);
+    EXPECT_EQ((std::vector<uint8_t>{1, 0, 0}), chain.in_the_money);
+    EXPECT_EQ(1520, chain.volume[0]);
+    EXPECT_EQ(8754, chain.open_interest[0]);
+    EXPECT_EQ(0.2138, chain.implied_volatility[0]);
+    EXPECT_EQ(1701388800, chain.expiration[2]);
+}
+
+TEST(OptionChainDecoderTest, MissingAndNullFieldsKeepRowsAligned) {
+    OptionChain chain = OptionChainDecoder::decode(fixture_body("/v7/finance/options/AAPL"));
+
+    ASSERT_EQ(3u, chain.size());
+    for (size_t size : {chain.contract_symbol.size(), chain.last_price.size(), chain.bid.size(),
+                        chain.ask.size(), chain.change.size(), chain.percent_change.size(),
+                        chain.volume.size(), chain.open_interest.size(), chain.implied_volatility.size(),
+                        chain.expiration.size(), chain.last_trade_date.size(), chain.is_call.size(),
+                        chain.in_the_money.size()}) {
+        EXPECT_EQ(3u, size);
+    }
+
+    // The second call has no volume or change and a null bid
+    EXPECT_EQ(0, chain.volume[1]);
+    EXPECT_TRUE(std::isnan(chain.change[1]));
+    EXPECT_TRUE(std::isnan(chain.bid[1]));
+    EXPECT_EQ(1.92, chain.ask[1]);
+    // The put has no last trade date
+    EXPECT_EQ(0, chain.last_trade_date[2]);
+    EXPECT_EQ(0.41, chain.last_price[2]);
+}
+
+TEST(OptionChainDecoderTest, EmptyResultIsAnEmptyChain) {
+    OptionChain chain = OptionChainDecoder::decode(fixture_body("/v7/finance/options/BRK-A"));
+
+    EXPECT_EQ(0u, chain.size());
+    EXPECT_TRUE(chain.expiration_dates.empty());
+    EXPECT_TRUE(chain.underlying_symbol.empty());
+}
+
+TEST(OptionChainDecoderTest, DecodesOnlyTheFirstResult) {
+    OptionChain chain = OptionChainDecoder::decode(std::string(
+        R"({"optionChain":{"result":[{"underlyingSymbol":"AAPL","options":[{"calls":[{"strike":100}],"puts":[]}]},)"
+        R"({"underlyingSymbol":"X","options":[{"calls":[{"strike":1}]}]}],"error":null}})"));
+
+    EXPECT_EQ("AAPL", chain.underlying_symbol);
+    ASSERT_EQ(1u, chain.size());
+    EXPECT_EQ(100.0, chain.strike[0]);
+}
+
+TEST(OptionChainDecoderTest, ThrowsOnErrorsAndMissingResults) {
+    try {
+        OptionChainDecoder::decode(fixture_body("/v7/finance/options/NOSUCH"));
+        FAIL() << "expected an error";
+    } catch (const std::runtime_error& e) {
+        EXPECT_NE(std::string::npos, std::string(e.what()).find("No data found for NOSUCH"));
+    }
+
+    EXPECT_THROW(OptionChainDecoder::decode(std::string(R"({"optionChain":{"error":null}})")), std::runtime_error);
+    EXPECT_THROW(OptionChainDecoder::decode(std::string(R"({"optionChain":{"result":[{)")), std::runtime_error);
+}
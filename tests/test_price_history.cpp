@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include "data_structures.h"
+
+using yfinance::PriceHistory;
+
+namespace {
+
+    constexpr int64_t kDay = 86400;
+    constexpr int64_t kMonday = 1700438400;  // 2023-11-20 00:00 UTC
+
+    // Monday to Friday of one week, then Monday to Friday of the next; no adjclose
+    PriceHistory two_weeks() {
+        PriceHistory history;
+        for (int64_t week = 0; week < 2; ++week) {
+            for (int64_t day = 0; day < 5; ++day) {
+                double price = 100.0 + static_cast<double>(history.size());
+                history.timestamp.push_back(kMonday + (week * 7 + day) * kDay);
+                history.open.push_back(price);
+                history.high.push_back(price + 1.0);
+                history.low.push_back(price - 1.0);
+                history.close.push_back(price + 0.5);
+                history.volume.push_back(1000.0);
+            }
+        }
+        return history;
+    }
+
+} // namespace
+
+TEST(PriceHistoryTest, LowerBoundAndAsof) {
+    PriceHistory history = two_weeks();
+
+    EXPECT_EQ(0u, history.lower_bound(kMonday - 1));
+    EXPECT_EQ(0u, history.lower_bound(kMonday));
+    EXPECT_EQ(1u, history.lower_bound(kMonday + 1));
+    EXPECT_EQ(10u, history.lower_bound(kMonday + 100 * kDay));
+
+    EXPECT_FALSE(history.asof(kMonday - 1).has_value());
+    EXPECT_EQ(0u, *history.asof(kMonday));
+    EXPECT_EQ(0u, *history.asof(kMonday + kDay - 1));
+    // Saturday and Sunday resolve to Friday
+    EXPECT_EQ(4u, *history.asof(kMonday + 5 * kDay));
+    EXPECT_EQ(4u, *history.asof(kMonday + 7 * kDay - 1));
+    EXPECT_EQ(9u, *history.asof(kMonday + 100 * kDay));
+
+    EXPECT_FALSE(PriceHistory().asof(kMonday).has_value());
+}
+
+TEST(PriceHistoryTest, IndexRangeIsHalfOpen) {
+    PriceHistory history = two_weeks();
+
+    EXPECT_EQ(std::make_pair(size_t{0}, size_t{5}), history.index_range(kMonday, kMonday + 7 * kDay));
+    EXPECT_EQ(std::make_pair(size_t{1}, size_t{2}), history.index_range(kMonday + 1, kMonday + 2 * kDay));
+    EXPECT_EQ(std::make_pair(size_t{0}, size_t{10}), history.index_range(0, kMonday + 100 * kDay));
+
+    // Empty and reversed ranges
+    auto weekend = history.index_range(kMonday + 5 * kDay, kMonday + 7 * kDay);
+    EXPECT_EQ(weekend.first, weekend.second);
+    EXPECT_EQ(std::make_pair(size_t{0}, size_t{0}), history.index_range(kMonday + kDay, kMonday));
+}
+
+TEST(PriceHistoryTest, BetweenCopiesBarsAndEvents) {
+    PriceHistory history = two_weeks();
+    history.dividends.push_back({kMonday + 2 * kDay, 0.24});
+    history.splits.push_back({kMonday + 8 * kDay, 4.0, 1.0, "4:1"});
+
+    PriceHistory first_week = history.between(kMonday, kMonday + 7 * kDay);
+    ASSERT_EQ(5u, first_week.size());
+    EXPECT_EQ(104.5, first_week.close.back());
+    EXPECT_TRUE(first_week.adjclose.empty());
+    ASSERT_EQ(1u, first_week.dividends.size());
+    EXPECT_TRUE(first_week.splits.empty());
+
+    PriceHistory second_week = history.between(kMonday + 7 * kDay, kMonday + 14 * kDay);
+    ASSERT_EQ(5u, second_week.size());
+    EXPECT_EQ(105.0, second_week.open.front());
+    ASSERT_EQ(1u, second_week.splits.size());
+    EXPECT_EQ("4:1", second_week.splits[0].ratio);
+}
+
+TEST(PriceHistoryTest, BetweenKeepsEventsOfARangeWithoutBars) {
+    PriceHistory history = two_weeks();
+    int64_t saturday = kMonday + 5 * kDay;
+    history.dividends.push_back({saturday + 3600, 0.24});
+
+    PriceHistory weekend = history.between(saturday, saturday + 2 * kDay);
+    EXPECT_EQ(0u, weekend.size());
+    EXPECT_TRUE(weekend.close.empty());
+    ASSERT_EQ(1u, weekend.dividends.size());
+    EXPECT_EQ(0.24, weekend.dividends[0].amount);
+}
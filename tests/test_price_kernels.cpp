@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "price_kernels.h"
+
+using yfinance::ColumnStats;
+using yfinance::PriceKernels;
+using yfinance::SimdLevel;
+using yfinance::Span;
+
+namespace {
+
+    // Restores the detected level when a test leaves
+    class PriceKernelsTest : public ::testing::Test {
+    protected:
+        void TearDown() override {
+            PriceKernels::set_level(PriceKernels::detected_level());
+        }
+    };
+
+    struct Bars {
+        std::vector<double> high, low, close, volume;
+    };
+
+    Bars random_bars(std::mt19937_64& rng, size_t size, double gap_probability) {
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        auto maybe_missing = [&](double value) {
+            return unit(rng) < gap_probability ? yfinance::kMissingValue : value;
+        };
+
+        Bars bars;
+        for (size_t i = 0; i < size; ++i) {
+            double price = 100.0 + unit(rng) * 10.0;
+            bars.high.push_back(maybe_missing(price + unit(rng)));
+            bars.low.push_back(maybe_missing(price - unit(rng)));
+            bars.close.push_back(maybe_missing(price));
+            bars.volume.push_back(maybe_missing(std::floor(unit(rng) * 100.0)));
+        }
+        return bars;
+    }
+
+    // Sums are accumulated in a different order at each level
+    void expect_close(double expected, double actual) {
+        if (std::isnan(expected)) {
+            EXPECT_TRUE(std::isnan(actual));
+        } else {
+            EXPECT_NEAR(expected, actual, 1e-9 * std::max(1.0, std::fabs(expected)));
+        }
+    }
+
+} // namespace
+
+TEST_F(PriceKernelsTest, EveryLevelMatchesScalarWithNaNGaps) {
+    std::mt19937_64 rng(1);
+    for (double gap_probability : {0.0, 0.3, 0.6, 1.0}) {
+        for (size_t size = 0; size <= 100; ++size) {
+            Bars bars = random_bars(rng, size, gap_probability);
+
+            PriceKernels::set_level(SimdLevel::Scalar);
+            ColumnStats expected_stats = PriceKernels::stats(bars.close);
+            double expected_vwap = PriceKernels::vwap(bars.close, bars.volume);
+            std::vector<double> expected_range(size);
+            PriceKernels::true_range(bars.high, bars.low, bars.close, expected_range);
+
+            for (int level = 1; level <= static_cast<int>(PriceKernels::detected_level()); ++level) {
+                SCOPED_TRACE(::testing::Message() << yfinance::simd_level_name(static_cast<SimdLevel>(level))
+                                                  << ", " << size << " bars, gaps " << gap_probability);
+                PriceKernels::set_level(static_cast<SimdLevel>(level));
+
+                ColumnStats stats = PriceKernels::stats(bars.close);
+                EXPECT_EQ(expected_stats.count, stats.count);
+                expect_close(expected_stats.sum, stats.sum);
+                expect_close(expected_stats.min, stats.min);
+                expect_close(expected_stats.max, stats.max);
+                expect_close(expected_stats.mean, stats.mean);
+                expect_close(expected_vwap, PriceKernels::vwap(bars.close, bars.volume));
+
+                // True range takes no sums, so it must match bit for bit
+                std::vector<double> range(size);
+                PriceKernels::true_range(bars.high, bars.low, bars.close, range);
+                for (size_t i = 0; i < size; ++i) {
+                    if (std::isnan(expected_range[i])) {
+                        EXPECT_TRUE(std::isnan(range[i])) << "bar " << i;
+                    } else {
+                        EXPECT_EQ(expected_range[i], range[i]) << "bar " << i;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_F(PriceKernelsTest, StatsSkipNaNAndAcceptUnalignedInput) {
+    std::vector<double> values(37);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<double>(i);
+    }
+    values[5] = yfinance::kMissingValue;
+
+    // Starts one double past the vector's allocation
+    ColumnStats stats = PriceKernels::stats(Span<const double>(values.data() + 1, 36));
+    EXPECT_EQ(35u, stats.count);
+    EXPECT_DOUBLE_EQ(661.0, stats.sum);
+    EXPECT_DOUBLE_EQ(1.0, stats.min);
+    EXPECT_DOUBLE_EQ(36.0, stats.max);
+}
+
+TEST_F(PriceKernelsTest, EmptyAndAllMissingColumns) {
+    ColumnStats empty = PriceKernels::stats(Span<const double>());
+    EXPECT_EQ(0u, empty.count);
+    EXPECT_TRUE(std::isnan(empty.min));
+    EXPECT_TRUE(std::isnan(empty.mean));
+
+    std::vector<double> missing(10, yfinance::kMissingValue);
+    EXPECT_EQ(0u, PriceKernels::stats(missing).count);
+    EXPECT_TRUE(std::isnan(PriceKernels::vwap(missing, missing)));
+}
+
+TEST_F(PriceKernelsTest, TrueRangeFallsBackToHighLowWithoutPreviousClose) {
+    std::vector<double> high = {11.0, 12.0, 15.0};
+    std::vector<double> low = {9.0, 10.0, 14.0};
+    std::vector<double> close = {10.0, yfinance::kMissingValue, 14.5};
+    std::vector<double> range(3);
+    PriceKernels::true_range(high, low, close, range);
+
+    EXPECT_DOUBLE_EQ(2.0, range[0]);  // First bar: high - low
+    EXPECT_DOUBLE_EQ(2.0, range[1]);  // max(2, |12 - 10|, |10 - 10|)
+    EXPECT_DOUBLE_EQ(1.0, range[2]);  // Previous close missing: high - low
+}
+
+TEST_F(PriceKernelsTest, RejectsMismatchedLengthsAndUnsupportedLevels) {
+    std::vector<double> two(2), three(3);
+    EXPECT_THROW(PriceKernels::vwap(two, three), std::invalid_argument);
+    EXPECT_THROW(PriceKernels::true_range(two, two, three, three), std::invalid_argument);
+
+    if (PriceKernels::detected_level() != SimdLevel::AVX512) {
+        EXPECT_THROW(PriceKernels::set_level(SimdLevel::AVX512), std::invalid_argument);
+    }
+}
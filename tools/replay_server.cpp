@@ -0,0 +1,249 @@
+#include <iostream>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "fixture_store.h"
+#include "utils.h"
+
+// Serves responses recorded by HttpClient (see HttpClient::set_record_directory)
+// over plain HTTP/1.1 with keep-alive, so the Ticker -> YfData -> HttpClient
+// path can be benchmarked and tested without network access.
+//
+// Usage: replay_server <fixture-dir> [--port N] [--latency-ms N] [--bandwidth BYTES_PER_SEC]
+//
+// --latency-ms delays every response before its first byte; --bandwidth
+// throttles each response body (0, the default, means unthrottled).
+// Point a session at it with YfData::set_base_url("http://127.0.0.1:N") and
+// YfData::set_cookie_url("http://127.0.0.1:N/").
+
+namespace {
+
+    struct Options {
+        std::string directory;
+        int port = 8080;
+        int latency_ms = 0;
+        long bandwidth = 0;
+    };
+
+    std::atomic<uint64_t> g_served{0};
+    std::atomic<uint64_t> g_missing{0};
+
+    bool send_all(int fd, const char* data, size_t size) {
+        while (size > 0) {
+            ssize_t sent = ::send(fd, data, size, MSG_NOSIGNAL);
+            if (sent <= 0) {
+                return false;
+            }
+            data += sent;
+            size -= static_cast<size_t>(sent);
+        }
+        return true;
+    }
+
+    // Send the body in slices paced to the configured bandwidth
+    bool send_body(int fd, const std::string& body, long bandwidth) {
+        if (bandwidth <= 0) {
+            return send_all(fd, body.data(), body.size());
+        }
+
+        const size_t slice = std::max<size_t>(1024, static_cast<size_t>(bandwidth / 100));
+        auto start = std::chrono::steady_clock::now();
+        for (size_t offset = 0; offset < body.size(); offset += slice) {
+            size_t size = std::min(slice, body.size() - offset);
+            if (!send_all(fd, body.data() + offset, size)) {
+                return false;
+            }
+
+            auto due = start + std::chrono::microseconds((offset + size) * 1000000 / bandwidth);
+            std::this_thread::sleep_until(due);
+        }
+        return true;
+    }
+
+    const char* reason_phrase(long status) {
+        switch (status) {
+            case 200: return "OK";
+            case 204: return "No Content";
+            case 301: return "Moved Permanently";
+            case 302: return "Found";
+            case 400: return "Bad Request";
+            case 401: return "Unauthorized";
+            case 404: return "Not Found";
+            case 429: return "Too Many Requests";
+            case 500: return "Internal Server Error";
+            case 503: return "Service Unavailable";
+            default: return "Status";
+        }
+    }
+
+    void serve_connection(int fd, const Options& options, const yfinance::FixtureStore& store) {
+        std::string buffer;
+        char chunk[16384];
+
+        while (true) {
+            // Read one request head
+            size_t head_end;
+            while ((head_end = buffer.find("\r\n\r\n")) == std::string::npos) {
+                ssize_t received = ::recv(fd, chunk, sizeof(chunk), 0);
+                if (received <= 0) {
+                    ::close(fd);
+                    return;
+                }
+                buffer.append(chunk, static_cast<size_t>(received));
+            }
+
+            std::string head = buffer.substr(0, head_end);
+            buffer.erase(0, head_end + 4);
+
+            size_t line_end = head.find("\r\n");
+            std::string request_line = head.substr(0, line_end);
+            std::string lower_head = yfinance::Utils::to_lowercase(head);
+
+            // Skip a request body (POST) so the next request parses cleanly
+            size_t length_pos = lower_head.find("\r\ncontent-length:");
+            if (length_pos != std::string::npos) {
+                size_t length = std::strtoul(head.c_str() + length_pos + 17, nullptr, 10);
+                while (buffer.size() < length) {
+                    ssize_t received = ::recv(fd, chunk, sizeof(chunk), 0);
+                    if (received <= 0) {
+                        ::close(fd);
+                        return;
+                    }
+                    buffer.append(chunk, static_cast<size_t>(received));
+                }
+                buffer.erase(0, length);
+            }
+            bool keep_alive = lower_head.find("\r\nconnection: close") == std::string::npos;
+
+            size_t method_end = request_line.find(' ');
+            size_t target_end = request_line.rfind(' ');
+            std::string method = request_line.substr(0, method_end);
+            std::string target = method_end == target_end ? "/"
+                : request_line.substr(method_end + 1, target_end - method_end - 1);
+
+            auto fixture = store.load(method, target);
+            if (!fixture) {
+                ++g_missing;
+                std::cerr << "No fixture for " << method << " " << target
+                          << " (" << yfinance::FixtureStore::fixture_name(method, target) << ")" << std::endl;
+                fixture = yfinance::FixtureStore::Fixture();
+                fixture->status = 404;
+                fixture->content_type = "application/json";
+                fixture->body = "{\"error\":\"no recorded fixture\"}";
+            } else {
+                ++g_served;
+            }
+
+            if (options.latency_ms > 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(options.latency_ms));
+            }
+
+            std::string response_head = "HTTP/1.1 " + std::to_string(fixture->status) + " " +
+                                        reason_phrase(fixture->status) + "\r\n";
+            if (!fixture->content_type.empty()) {
+                response_head += "Content-Type: " + fixture->content_type + "\r\n";
+            }
+            response_head += "Content-Length: " + std::to_string(fixture->body.size()) + "\r\n";
+            response_head += keep_alive ? "Connection: keep-alive\r\n\r\n" : "Connection: close\r\n\r\n";
+
+            bool head_only = method == "HEAD";
+            if (!send_all(fd, response_head.data(), response_head.size()) ||
+                (!head_only && !send_body(fd, fixture->body, options.bandwidth)) ||
+                !keep_alive) {
+                ::close(fd);
+                return;
+            }
+        }
+    }
+
+    bool parse_options(int argc, char* argv[], Options& options) {
+        if (argc < 2) {
+            return false;
+        }
+        options.directory = argv[1];
+
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (i + 1 >= argc) {
+                return false;
+            }
+            if (arg == "--port") {
+                options.port = std::atoi(argv[++i]);
+            } else if (arg == "--latency-ms") {
+                options.latency_ms = std::atoi(argv[++i]);
+            } else if (arg == "--bandwidth") {
+                options.bandwidth = std::atol(argv[++i]);
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parse_options(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0]
+                  << " <fixture-dir> [--port N] [--latency-ms N] [--bandwidth BYTES_PER_SEC]" << std::endl;
+        return 1;
+    }
+
+    yfinance::FixtureStore store(options.directory);
+
+    int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listener < 0) {
+        std::perror("socket");
+        return 1;
+    }
+
+    int enable = 1;
+    ::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(static_cast<uint16_t>(options.port));
+
+    if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listener, 1024) != 0) {
+        std::perror("bind/listen");
+        ::close(listener);
+        return 1;
+    }
+
+    std::cout << "Replaying " << options.directory << " on http://127.0.0.1:" << options.port
+              << " (latency " << options.latency_ms << " ms, bandwidth "
+              << (options.bandwidth > 0 ? std::to_string(options.bandwidth) + " B/s" : "unlimited")
+              << ")" << std::endl;
+
+    while (true) {
+        int fd = ::accept(listener, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::perror("accept");
+            break;
+        }
+
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+        std::thread(serve_connection, fd, std::cref(options), std::cref(store)).detach();
+    }
+
+    ::close(listener);
+    return 0;
+}